@@ -0,0 +1,722 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <stdlib.h>
+#include "uORB.h"
+#include "uorb_internal.h"
+#if defined(UORB_USING_BRIDGE) && defined(__linux__)
+#define UORB_BENCH_BRIDGE
+#include "uorb_bridge.h"
+#include <poll.h>
+#endif
+#if defined(UORB_USING_SHM) || defined(UORB_BENCH_BRIDGE)
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#endif
+#ifdef UORB_USING_SHM
+#include "uorb_shm.h"
+#include <sys/socket.h>
+#include <sys/un.h>
+#endif
+#ifdef UORB_USING_DEFERRED_PUBLISH
+#include "uorb_defer.h"
+#include "uorb_internal.h"
+#endif
+
+/*
+ * uORB 性能基准：
+ *  - uorb_bench smp [threads] [duration_ms]
+ *    N 个线程（SMP 下分别绑定到 N 个核）各自向独立主题发布，统计 publishes/sec，
+ *    并与单线程结果对比给出扩展比。节点间无共享锁时应接近线性扩展。
+ *  - uorb_bench shm echo|ping [count]（UORB_USING_SHM，两个 simulator 进程各运行一端）
+ *    先经共享内存主题做 ping-pong，再经 UNIX 数据报套接字桥做同样的 ping-pong，
+ *    ping 端输出两者单程延迟（往返 / 2）的 min/median/p99。
+ *  - uorb_bench bridge [count] [batch_ms]（UORB_USING_BRIDGE，Linux simulator）
+ *    两个桥经管道回环：先逐条测量发布到对端重新发布的延迟，再连续发布 count 条
+ *    测量吞吐与每帧平均消息数；batch_ms 为发送端聚合窗口。
+ *  - uorb_bench defer [count] [cb_us]（UORB_USING_DEFERRED_PUBLISH）
+ *    订阅回调忙等 cb_us 微秒，分别以同步发布与延迟发布各发布 count 次，输出单次
+ *    orb_publish() 在生产者一侧耗时的 min/median/p99/max。生产者线程优先级高于投递线程。
+ */
+
+#define UORB_BENCH_MAX_THREADS 8
+
+struct uorb_bench_s {
+    uint64_t timestamp;
+    uint32_t seq;
+    uint8_t  payload[20];
+};
+
+#define UORB_BENCH_META(_idx)                                     \
+    {                                                             \
+        "uorb_bench" #_idx,                                       \
+        sizeof(struct uorb_bench_s),                              \
+        sizeof(struct uorb_bench_s),                              \
+        "uint64 timestamp;uint32 seq;uint8[20] payload;",         \
+        200 + _idx,                                               \
+    }
+
+static const struct orb_metadata bench_meta[UORB_BENCH_MAX_THREADS] = {
+    UORB_BENCH_META(0), UORB_BENCH_META(1), UORB_BENCH_META(2), UORB_BENCH_META(3),
+    UORB_BENCH_META(4), UORB_BENCH_META(5), UORB_BENCH_META(6), UORB_BENCH_META(7),
+};
+
+struct bench_worker {
+    orb_advert_t       adv;
+    int                cpu;
+    volatile rt_bool_t *stop;
+    rt_sem_t           done;
+    rt_uint32_t        count;
+};
+
+static void bench_smp_entry(void *parameter)
+{
+    struct bench_worker *w = (struct bench_worker *)parameter;
+    struct uorb_bench_s  msg = {0};
+
+    while (!*w->stop)
+    {
+        msg.timestamp = rt_tick_get();
+        msg.seq++;
+        if (orb_publish(RT_NULL, w->adv, &msg) == RT_EOK)
+        {
+            w->count++;
+        }
+    }
+    rt_sem_release(w->done);
+}
+
+/* 运行一轮：返回全部线程合计的 publishes/sec */
+static rt_uint32_t bench_smp_round(int threads, int duration_ms, rt_bool_t verbose)
+{
+    struct bench_worker workers[UORB_BENCH_MAX_THREADS] = {0};
+    volatile rt_bool_t  stop = RT_FALSE;
+    rt_sem_t            done = rt_sem_create("u_bdone", 0, RT_IPC_FLAG_FIFO);
+    rt_uint64_t         total = 0;
+    int                 started = 0;
+
+    if (!done)
+    {
+        return 0;
+    }
+
+    for (int i = 0; i < threads; i++)
+    {
+        struct uorb_bench_s init = {0};
+        workers[i].adv  = orb_advertise(&bench_meta[i], &init);
+        workers[i].cpu  = i % UORB_CPUS_NR;
+        workers[i].stop = &stop;
+        workers[i].done = done;
+        if (!workers[i].adv)
+        {
+            continue;
+        }
+
+        rt_thread_t tid = rt_thread_create("u_bench", bench_smp_entry, &workers[i], 1024, RT_THREAD_PRIORITY_MAX - 2, 10);
+        if (!tid)
+        {
+            continue;
+        }
+#ifdef RT_USING_SMP
+        rt_thread_control(tid, RT_THREAD_CTRL_BIND_CPU, (void *)(rt_ubase_t)workers[i].cpu);
+#endif
+        rt_thread_startup(tid);
+        started++;
+    }
+
+    rt_thread_mdelay(duration_ms);
+    stop = RT_TRUE;
+    for (int i = 0; i < started; i++)
+    {
+        rt_sem_take(done, RT_WAITING_FOREVER);
+    }
+
+    for (int i = 0; i < threads; i++)
+    {
+        if (!workers[i].adv)
+        {
+            continue;
+        }
+        rt_uint32_t rate = (rt_uint32_t)((rt_uint64_t)workers[i].count * 1000u / (rt_uint32_t)duration_ms);
+        if (verbose)
+        {
+            rt_kprintf("  thread%d cpu=%d publishes=%u rate=%u/s\n", i, workers[i].cpu, workers[i].count, rate);
+        }
+        total += rate;
+        orb_unadvertise(workers[i].adv);
+    }
+
+    rt_sem_delete(done);
+    return (rt_uint32_t)total;
+}
+
+static void bench_smp(int threads, int duration_ms)
+{
+    if (threads <= 0) threads = UORB_CPUS_NR;
+    if (threads > UORB_BENCH_MAX_THREADS) threads = UORB_BENCH_MAX_THREADS;
+    if (duration_ms <= 0) duration_ms = 1000;
+
+    rt_kprintf("uorb bench smp: cpus=%d threads=%d duration=%dms\n", UORB_CPUS_NR, threads, duration_ms);
+
+    rt_uint32_t base = bench_smp_round(1, duration_ms, RT_FALSE);
+    rt_kprintf("  baseline 1 thread: %u publishes/s\n", base);
+
+    rt_uint32_t total = bench_smp_round(threads, duration_ms, RT_TRUE);
+    rt_uint32_t scale_x100 = base ? (rt_uint32_t)((rt_uint64_t)total * 100u / base) : 0;
+    rt_kprintf("  total %d threads: %u publishes/s, scaling=%u.%02ux (ideal %d.00x)\n",
+               threads, total, scale_x100 / 100, scale_x100 % 100, threads);
+}
+
+#if defined(UORB_USING_SHM) || defined(UORB_BENCH_BRIDGE) || defined(UORB_USING_DEFERRED_PUBLISH)
+static int bench_cmp_u32(const void *a, const void *b)
+{
+    rt_uint32_t x = *(const rt_uint32_t *)a, y = *(const rt_uint32_t *)b;
+    return (x > y) - (x < y);
+}
+#endif
+
+#if defined(UORB_USING_SHM) || defined(UORB_BENCH_BRIDGE)
+static rt_uint64_t bench_now_ns(void)
+{
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint64_t)ts.tv_sec * 1000000000ull + (rt_uint64_t)ts.tv_nsec;
+}
+
+/* 输出单程延迟分布（纳秒样本，原地排序） */
+static void bench_report_latency(const char *name, rt_uint32_t *ns, int n)
+{
+    if (n <= 0)
+    {
+        rt_kprintf("  %-6s no samples\n", name);
+        return;
+    }
+    qsort(ns, n, sizeof(ns[0]), bench_cmp_u32);
+    rt_kprintf("  %-6s one-way min=%u.%03uus median=%u.%03uus p99=%u.%03uus (n=%d)\n", name, ns[0] / 1000,
+               ns[0] % 1000, ns[n / 2] / 1000, ns[n / 2] % 1000, ns[n * 99 / 100] / 1000, ns[n * 99 / 100] % 1000, n);
+}
+#endif
+
+#ifdef UORB_USING_SHM
+#define UORB_BENCH_SOCK_PING "/tmp/uorb_shm_bench.ping"
+#define UORB_BENCH_SOCK_PONG "/tmp/uorb_shm_bench.pong"
+
+/* 共享内存主题：ping 发 bench_meta[0]，echo 原样回 bench_meta[1]；seq 0 用于握手 */
+static int bench_shm_topics(rt_bool_t ping, int count, rt_uint32_t *rtt_ns)
+{
+    const struct orb_metadata *tx = ping ? &bench_meta[0] : &bench_meta[1];
+    const struct orb_metadata *rx = ping ? &bench_meta[1] : &bench_meta[0];
+    struct uorb_bench_s        msg = {0};
+    int                        n   = 0;
+
+    orb_advert_t adv = orb_advertise(tx, RT_NULL);
+    orb_subscr_t sub = orb_subscribe(rx);
+    if (!adv || !sub)
+    {
+        if (adv) orb_unadvertise(adv);
+        if (sub) orb_unsubscribe(sub);
+        return -1;
+    }
+
+    if (ping)
+    {
+        /* 握手：直到收到 echo 的 seq 0 */
+        for (int i = 0; i < 1000; i++)
+        {
+            msg.seq = 0;
+            orb_publish(tx, adv, &msg);
+            if (orb_wait(sub, 10) == RT_EOK && orb_copy(rx, sub, &msg) > 0 && msg.seq == 0)
+            {
+                break;
+            }
+            rt_thread_mdelay(orb_exists(rx, 0) == RT_EOK ? 0 : 10);
+        }
+        for (rt_uint32_t seq = 1; seq <= (rt_uint32_t)count; seq++)
+        {
+            msg.seq       = seq;
+            msg.timestamp = bench_now_ns();
+            orb_publish(tx, adv, &msg);
+            while (orb_wait(sub, 1000) == RT_EOK)
+            {
+                struct uorb_bench_s back;
+                if (orb_copy(rx, sub, &back) > 0 && back.seq == seq)
+                {
+                    rtt_ns[n++] = (rt_uint32_t)((bench_now_ns() - msg.timestamp) / 2);
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        /* echo：原样回发，收到最后一条后退出；长时间无消息则放弃 */
+        int idle_ms = 0;
+        while (idle_ms < 10000)
+        {
+            int ret = orb_wait(sub, 1000);
+            if (ret != RT_EOK)
+            {
+                /* ping 端尚未公告时 orb_wait 立即返回 */
+                if (ret == -RT_ENOENT) rt_thread_mdelay(10);
+                idle_ms += (ret == -RT_ENOENT) ? 10 : 1000;
+                continue;
+            }
+            idle_ms = 0;
+            if (orb_copy(rx, sub, &msg) > 0)
+            {
+                orb_publish(tx, adv, &msg);
+                if (msg.seq == (rt_uint32_t)count)
+                {
+                    n = count;
+                    break;
+                }
+            }
+        }
+    }
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+    return n;
+}
+
+/* 对照组：同样的消息经 UNIX 数据报套接字往返 */
+static int bench_shm_socket(rt_bool_t ping, int count, rt_uint32_t *rtt_ns)
+{
+    const char *self = ping ? UORB_BENCH_SOCK_PING : UORB_BENCH_SOCK_PONG;
+    const char *peer = ping ? UORB_BENCH_SOCK_PONG : UORB_BENCH_SOCK_PING;
+    struct sockaddr_un local = {0}, remote = {0};
+    struct uorb_bench_s msg = {0};
+    struct timeval      tv  = {1, 0};
+    int                 n   = 0;
+
+    int fd = socket(AF_UNIX, SOCK_DGRAM, 0);
+    if (fd < 0)
+    {
+        return -1;
+    }
+    local.sun_family  = AF_UNIX;
+    remote.sun_family = AF_UNIX;
+    strncpy(local.sun_path, self, sizeof(local.sun_path) - 1);
+    strncpy(remote.sun_path, peer, sizeof(remote.sun_path) - 1);
+    unlink(self);
+    if (bind(fd, (struct sockaddr *)&local, sizeof(local)) != 0)
+    {
+        close(fd);
+        return -1;
+    }
+    setsockopt(fd, SOL_SOCKET, SO_RCVTIMEO, &tv, sizeof(tv));
+
+    if (ping)
+    {
+        for (int i = 0; i < 1000; i++)
+        {
+            msg.seq = 0;
+            if (sendto(fd, &msg, sizeof(msg), 0, (struct sockaddr *)&remote, sizeof(remote)) == sizeof(msg) &&
+                recv(fd, &msg, sizeof(msg), 0) == sizeof(msg))
+            {
+                break;
+            }
+            rt_thread_mdelay(10);
+        }
+        for (rt_uint32_t seq = 1; seq <= (rt_uint32_t)count; seq++)
+        {
+            struct uorb_bench_s back;
+            msg.seq       = seq;
+            msg.timestamp = bench_now_ns();
+            sendto(fd, &msg, sizeof(msg), 0, (struct sockaddr *)&remote, sizeof(remote));
+            while (recv(fd, &back, sizeof(back), 0) == sizeof(back))
+            {
+                if (back.seq == seq)
+                {
+                    rtt_ns[n++] = (rt_uint32_t)((bench_now_ns() - msg.timestamp) / 2);
+                    break;
+                }
+            }
+        }
+    }
+    else
+    {
+        int idle = 0;
+        while (idle < 10)
+        {
+            if (recv(fd, &msg, sizeof(msg), 0) != sizeof(msg))
+            {
+                idle++;
+                continue;
+            }
+            idle = 0;
+            sendto(fd, &msg, sizeof(msg), 0, (struct sockaddr *)&remote, sizeof(remote));
+            if (msg.seq == (rt_uint32_t)count)
+            {
+                n = count;
+                break;
+            }
+        }
+    }
+
+    close(fd);
+    unlink(self);
+    return n;
+}
+
+static void bench_shm(rt_bool_t ping, int count)
+{
+    if (count <= 0) count = 10000;
+
+    if (!orb_shm_attached())
+    {
+        rt_kprintf("uorb bench shm: shared memory not attached\n");
+        return;
+    }
+    rt_uint32_t *rtt_ns = ping ? (rt_uint32_t *)rt_malloc(sizeof(rt_uint32_t) * count) : RT_NULL;
+    if (ping && !rtt_ns)
+    {
+        return;
+    }
+
+    rt_kprintf("uorb bench shm %s: count=%d\n", ping ? "ping" : "echo", count);
+    int n = bench_shm_topics(ping, count, rtt_ns);
+    if (ping) bench_report_latency("shm", rtt_ns, n);
+    n = bench_shm_socket(ping, count, rtt_ns);
+    if (ping) bench_report_latency("socket", rtt_ns, n);
+    if (!ping) rt_kprintf("  echo done\n");
+
+    rt_free(rtt_ns);
+}
+#endif /* UORB_USING_SHM */
+
+#ifdef UORB_BENCH_BRIDGE
+struct bench_pipe
+{
+    int rfd;
+    int wfd;
+};
+
+static rt_ssize_t bench_pipe_write(void *ctx, const void *buf, rt_size_t len)
+{
+    struct bench_pipe *p    = (struct bench_pipe *)ctx;
+    rt_size_t          done = 0;
+    while (done < len)
+    {
+        ssize_t n = write(p->wfd, (const rt_uint8_t *)buf + done, len - done);
+        if (n <= 0)
+        {
+            break;
+        }
+        done += (rt_size_t)n;
+    }
+    return (rt_ssize_t)done;
+}
+
+static rt_ssize_t bench_pipe_read(void *ctx, void *buf, rt_size_t len, rt_int32_t timeout_ms)
+{
+    struct bench_pipe *p   = (struct bench_pipe *)ctx;
+    struct pollfd      pfd = {p->rfd, POLLIN, 0};
+    if (poll(&pfd, 1, timeout_ms) <= 0)
+    {
+        return 0;
+    }
+    ssize_t n = read(p->rfd, buf, len);
+    return n > 0 ? n : 0;
+}
+
+/* 发送桥 a 经管道连到接收桥 b，b 把 bench_meta[0] 重新发布为另一个实例 */
+static void bench_bridge(int count, int batch_ms)
+{
+    const struct orb_metadata *meta = &bench_meta[0];
+    struct uorb_bench_s        msg  = {0};
+    int                        fds[2];
+    int                        inst = -1, peer = -1;
+
+    if (count <= 0) count = 10000;
+    if (pipe(fds) != 0)
+    {
+        return;
+    }
+    struct bench_pipe     link = {fds[0], fds[1]};
+    const orb_bridge_io_t io   = {bench_pipe_write, bench_pipe_read, &link};
+    orb_advert_t          adv  = orb_advertise_multi_queue(meta, RT_NULL, &inst, 16);
+    orb_bridge_t         *a    = orb_bridge_create(&io, 1);
+    orb_bridge_t         *b    = orb_bridge_create(&io, 1);
+    rt_uint32_t          *lat  = (rt_uint32_t *)rt_malloc(sizeof(rt_uint32_t) * count);
+    orb_subscr_t          sub  = RT_NULL;
+    int                   n    = 0;
+
+    if (!adv || !a || !b || !lat || orb_bridge_add_tx(a, meta, (rt_uint8_t)inst) != RT_EOK ||
+        orb_bridge_add_rx(b, meta) != RT_EOK || orb_bridge_start(a) != RT_EOK || orb_bridge_start(b) != RT_EOK)
+    {
+        rt_kprintf("uorb bench bridge: setup failed\n");
+        goto out;
+    }
+    orb_bridge_set_batch_window(a, batch_ms > 0 ? (rt_uint32_t)batch_ms : 0);
+
+    /* 首条消息让接收端公告本地实例 */
+    orb_publish(meta, adv, &msg);
+    for (int i = 0; i < 100 && peer < 0; i++)
+    {
+        rt_thread_mdelay(10);
+        for (int k = 0; k < ORB_MULTI_MAX_INSTANCES; k++)
+        {
+            if (k != inst && orb_exists(meta, k) == RT_EOK)
+            {
+                peer = k;
+                break;
+            }
+        }
+    }
+    sub = (peer >= 0) ? orb_subscribe_multi(meta, (rt_uint8_t)peer) : RT_NULL;
+    if (!sub)
+    {
+        rt_kprintf("uorb bench bridge: no data from the receiving bridge\n");
+        goto out;
+    }
+    rt_kprintf("uorb bench bridge: count=%d frame_max=%d msg=%d bytes batch=%dms\n", count, UORB_BRIDGE_FRAME_MAX,
+               meta->o_size_no_padding, batch_ms);
+
+    /* 延迟：逐条发布，等对端重新发布后再发下一条 */
+    for (rt_uint32_t seq = 1; seq <= (rt_uint32_t)count; seq++)
+    {
+        msg.seq       = seq;
+        msg.timestamp = bench_now_ns();
+        orb_publish(meta, adv, &msg);
+        struct uorb_bench_s back;
+        while (orb_wait(sub, 100) == RT_EOK)
+        {
+            if (orb_copy(meta, sub, &back) > 0 && back.seq == seq)
+            {
+                lat[n++] = (rt_uint32_t)(bench_now_ns() - back.timestamp);
+                break;
+            }
+        }
+    }
+    bench_report_latency("bridge", lat, n);
+
+    /* 吞吐：每次连续发布半个队列再等发送线程取走，积压的消息装进同一帧 */
+    orb_bridge_stat_t tx0, rx0, tx1, rx1;
+    orb_bridge_get_stat(a, &tx0);
+    orb_bridge_get_stat(b, &rx0);
+    rt_uint64_t t0 = bench_now_ns(), t1 = t0;
+    for (rt_uint32_t seq = 1; seq <= (rt_uint32_t)count; seq++)
+    {
+        msg.seq = seq;
+        orb_publish(meta, adv, &msg);
+        if (seq % 8 == 0)
+        {
+            for (int spin = 0; spin < 100000 && (orb_bridge_get_stat(a, &tx1), tx1.tx_msgs - tx0.tx_msgs < seq); spin++)
+            {
+                rt_thread_yield();
+            }
+        }
+    }
+    rt_uint32_t last = rx0.rx_msgs;
+    for (int idle = 0; idle < 5;)
+    {
+        rt_thread_mdelay(10);
+        orb_bridge_get_stat(b, &rx1);
+        if (rx1.rx_msgs != last)
+        {
+            last = rx1.rx_msgs;
+            t1   = bench_now_ns();
+            idle = 0;
+        }
+        else
+        {
+            idle++;
+        }
+    }
+    orb_bridge_get_stat(a, &tx1);
+    rt_uint32_t got    = rx1.rx_msgs - rx0.rx_msgs;
+    rt_uint32_t frames = tx1.tx_frames - tx0.tx_frames;
+    rt_uint64_t ns     = (t1 > t0) ? t1 - t0 : 1;
+    rt_uint32_t per_x100 = frames ? got * 100u / frames : 0;
+    rt_kprintf("  %-6s %u msgs/s, %u KB/s on the wire, %u.%02u msgs/frame, received %u of %d (lost %u)\n", "burst",
+               (rt_uint32_t)((rt_uint64_t)got * 1000000000ull / ns),
+               (rt_uint32_t)((rt_uint64_t)(tx1.tx_bytes - tx0.tx_bytes) * 1000000000ull / ns / 1024), per_x100 / 100,
+               per_x100 % 100, got, count, rx1.rx_lost - rx0.rx_lost);
+
+out:
+    if (sub) orb_unsubscribe(sub);
+    if (a) orb_bridge_delete(a);
+    if (b) orb_bridge_delete(b);
+    if (adv) orb_unadvertise(adv);
+    rt_free(lat);
+    close(fds[0]);
+    close(fds[1]);
+}
+#endif /* UORB_BENCH_BRIDGE */
+
+#ifdef UORB_USING_DEFERRED_PUBLISH
+struct bench_defer_ctx {
+    int          count;
+    rt_uint32_t  cb_us;
+    rt_uint32_t *ns;
+    int          n;
+    rt_bool_t    deferred;
+    rt_sem_t     done;
+};
+
+static void bench_defer_cb(const struct orb_metadata *meta, rt_uint8_t instance, const void *msg, void *ctx)
+{
+    (void)meta;
+    (void)instance;
+    (void)msg;
+    rt_uint32_t cb_us = *(const rt_uint32_t *)ctx;
+    rt_uint64_t start = uorb_prof_now();
+    while (uorb_prof_to_us(uorb_prof_since(start)) < cb_us)
+    {
+    }
+}
+
+/* 等投递线程处理完已入队的消息 */
+static void bench_defer_drain(void)
+{
+    orb_defer_stat_t st;
+    for (orb_defer_get_stat(&st); st.delivered != st.enqueued; orb_defer_get_stat(&st))
+    {
+        rt_thread_mdelay(1);
+    }
+}
+
+static void bench_defer_entry(void *parameter)
+{
+    struct bench_defer_ctx *ctx = (struct bench_defer_ctx *)parameter;
+    struct uorb_bench_s     msg = {0};
+    orb_callback_t          cb;
+    orb_advert_t            adv = orb_advertise(&bench_meta[0], RT_NULL);
+
+    rt_memset(&cb, 0, sizeof(cb));
+    ctx->n = 0;
+    if (adv && orb_register_callback_ctx(&bench_meta[0], 0, &cb, bench_defer_cb, &ctx->cb_us) == RT_EOK)
+    {
+        if (!ctx->deferred || orb_set_publish_deferred(adv, RT_TRUE) == RT_EOK)
+        {
+            for (int i = 0; i < ctx->count; i++)
+            {
+                msg.seq         = i;
+                rt_uint64_t t0  = uorb_prof_now();
+                int         ret = orb_publish(&bench_meta[0], adv, &msg);
+                rt_uint64_t dt  = uorb_prof_since(t0);
+                if (ret == RT_EOK)
+                {
+                    ctx->ns[ctx->n++] = (rt_uint32_t)uorb_prof_to_us(dt * 1000u);
+                }
+                /* 半满时让出 CPU 排空，测的是入队本身而非队列满的拒绝 */
+                if (ctx->deferred && (i + 1) % (UORB_DEFER_QUEUE_SIZE / 2) == 0)
+                {
+                    bench_defer_drain();
+                }
+            }
+            bench_defer_drain();
+        }
+        orb_unregister_callback_ctx(&cb);
+    }
+    if (adv)
+    {
+        orb_unadvertise(adv);
+    }
+    rt_sem_release(ctx->done);
+}
+
+static void bench_defer_report(const char *name, rt_uint32_t *ns, int n)
+{
+    if (n <= 0)
+    {
+        rt_kprintf("  %-8s no samples\n", name);
+        return;
+    }
+    qsort(ns, n, sizeof(ns[0]), bench_cmp_u32);
+    rt_kprintf("  %-8s publish min=%u.%03uus median=%u.%03uus p99=%u.%03uus max=%u.%03uus (n=%d)\n", name,
+               ns[0] / 1000, ns[0] % 1000, ns[n / 2] / 1000, ns[n / 2] % 1000, ns[n * 99 / 100] / 1000,
+               ns[n * 99 / 100] % 1000, ns[n - 1] / 1000, ns[n - 1] % 1000, n);
+}
+
+static void bench_defer(int count, int cb_us)
+{
+    struct bench_defer_ctx ctx = {count, (rt_uint32_t)cb_us, RT_NULL, 0, RT_FALSE, RT_NULL};
+    rt_uint8_t             prio = UORB_DEFER_THREAD_PRIORITY > 0 ? UORB_DEFER_THREAD_PRIORITY - 1 : 0;
+
+    ctx.ns   = (rt_uint32_t *)rt_malloc(sizeof(rt_uint32_t) * (count > 0 ? count : 1));
+    ctx.done = rt_sem_create("ubdefer", 0, RT_IPC_FLAG_PRIO);
+    if (!ctx.ns || !ctx.done || count <= 0)
+    {
+        rt_kprintf("uorb_bench defer: bad count or no memory\n");
+        goto out;
+    }
+
+    rt_kprintf("uorb_bench defer: count=%d callback=%dus queue=%d\n", count, cb_us, UORB_DEFER_QUEUE_SIZE);
+    for (int mode = 0; mode < 2; mode++)
+    {
+        ctx.deferred  = mode == 1;
+        rt_thread_t t = rt_thread_create("ubdefer", bench_defer_entry, &ctx, 2048, prio, 10);
+        if (!t)
+        {
+            rt_kprintf("uorb_bench defer: thread create failed\n");
+            break;
+        }
+        rt_thread_startup(t);
+        rt_sem_take(ctx.done, RT_WAITING_FOREVER);
+        bench_defer_report(ctx.deferred ? "deferred" : "direct", ctx.ns, ctx.n);
+    }
+
+out:
+    if (ctx.done)
+    {
+        rt_sem_delete(ctx.done);
+    }
+    rt_free(ctx.ns);
+}
+#endif /* UORB_USING_DEFERRED_PUBLISH */
+
+static int uorb_bench_main(int argc, char **argv)
+{
+    if (argc >= 2 && rt_strcmp(argv[1], "smp") == 0)
+    {
+        int threads     = (argc >= 3) ? atoi(argv[2]) : UORB_CPUS_NR;
+        int duration_ms = (argc >= 4) ? atoi(argv[3]) : 1000;
+        bench_smp(threads, duration_ms);
+        return 0;
+    }
+#ifdef UORB_BENCH_BRIDGE
+    if (argc >= 2 && rt_strcmp(argv[1], "bridge") == 0)
+    {
+        bench_bridge((argc >= 3) ? atoi(argv[2]) : 10000, (argc >= 4) ? atoi(argv[3]) : 0);
+        return 0;
+    }
+#endif
+#ifdef UORB_USING_SHM
+    if (argc >= 3 && rt_strcmp(argv[1], "shm") == 0 &&
+        (rt_strcmp(argv[2], "ping") == 0 || rt_strcmp(argv[2], "echo") == 0))
+    {
+        bench_shm(rt_strcmp(argv[2], "ping") == 0, (argc >= 4) ? atoi(argv[3]) : 10000);
+        return 0;
+    }
+#endif
+#ifdef UORB_USING_DEFERRED_PUBLISH
+    if (argc >= 2 && rt_strcmp(argv[1], "defer") == 0)
+    {
+        bench_defer((argc >= 3) ? atoi(argv[2]) : 1000, (argc >= 4) ? atoi(argv[3]) : 20);
+        return 0;
+    }
+#endif
+
+    rt_kprintf("usage: uorb_bench smp [threads] [duration_ms]\n");
+#ifdef UORB_USING_SHM
+    rt_kprintf("       uorb_bench shm echo|ping [count]\n");
+#endif
+#ifdef UORB_BENCH_BRIDGE
+    rt_kprintf("       uorb_bench bridge [count] [batch_ms]\n");
+#endif
+#ifdef UORB_USING_DEFERRED_PUBLISH
+    rt_kprintf("       uorb_bench defer [count] [cb_us]\n");
+#endif
+    return -1;
+}
+
+#if defined(UORB_ENABLE_BENCH)
+MSH_CMD_EXPORT_ALIAS(uorb_bench_main, uorb_bench, uORB benchmarks);
+#endif
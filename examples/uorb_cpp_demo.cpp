@@ -6,6 +6,7 @@
 
 #include <rtthread.h>
 #include <stdio.h>
+#include <stdlib.h>
 
 #if defined(UORB_USING_MSG_GEN) && defined(UORB_TOPICS_GENERATED)
 #include "topics/orb_test.h"
@@ -15,11 +16,28 @@
 #endif
 
 #include "cxx/uORB.hpp"
+#include "cxx/SubscriptionCallback.hpp"
+#include "cxx/uORBCoroutine.hpp"
+
+static void on_orb_test(const orb_test_s &msg, void *context)
+{
+	(void)context;
+	rt_kprintf("cpp orb_test: ts=%u val=%d\n", (unsigned)msg.timestamp, msg.val);
+}
+
+static void on_sensor_demo(const sensor_demo_s &msg, void *context)
+{
+	(void)context;
+	rt_kprintf("cpp sensor_demo: ts=%u xyz=(%d,%d,%d)\n", (unsigned)msg.timestamp, msg.x, msg.y, msg.z);
+}
+
+/* 订阅端不再需要轮询线程：orb_test 在发布线程内联回调，sensor_demo 投递到工作队列线程 */
+static uORB::WorkQueue g_cpp_demo_wq{"u_cppwq", 2048, 16};
 
 static void uorb_cpp_demo_entry(void *parameter)
 {
-	uORB::Publication<orb_test_s> pub_test{ORB_ID(orb_test)};
-	uORB::PublicationMulti<sensor_demo_s> pub_sens{ORB_ID(sensor_demo)};
+	uORB::Publication<orb_test_s> pub_test;
+	uORB::PublicationMulti<sensor_demo_s> pub_sens;
 
 	// 先进行一次公告，确保实例号可得
 	orb_test_s t0{};
@@ -33,8 +51,13 @@ static void uorb_cpp_demo_entry(void *parameter)
 	(void)pub_sens.publish(s0);
 	int sens_inst = pub_sens.instance();
 
-	uORB::Subscription sub_test{ORB_ID(orb_test)};
-	uORB::SubscriptionInterval sub_sens{ORB_ID(sensor_demo), 200, (uint8_t)(sens_inst < 0 ? 0 : sens_inst)};
+	(void)g_cpp_demo_wq.start();
+	uORB::SubscriptionCallback<orb_test_s> cb_test{on_orb_test};
+	uORB::SubscriptionCallback<sensor_demo_s> cb_sens{on_sensor_demo, nullptr, &g_cpp_demo_wq,
+							   (uint8_t)(sens_inst < 0 ? 0 : sens_inst)};
+	(void)cb_sens.set_interval(200);
+	(void)cb_test.registerCallback();
+	(void)cb_sens.registerCallback();
 
 	int32_t cnt = 1;
 	while (1)
@@ -51,22 +74,7 @@ static void uorb_cpp_demo_entry(void *parameter)
 		s.z = cnt * 3;
 		(void)pub_sens.publish(s);
 
-		orb_test_s t_in{};
-		if (sub_test.update(&t_in) || sub_test.copy(&t_in) > 0)
-		{
-			rt_kprintf("cpp orb_test: ts=%u val=%d\n", (unsigned)t_in.timestamp, t_in.val);
-		}
-
-		sensor_demo_s s_in{};
-		if (sub_sens.update(&s_in) || sub_sens.copy(&s_in) > 0)
-		{
-			rt_kprintf("cpp sensor_demo: ts=%u xyz=(%d,%d,%d)\n", (unsigned)s_in.timestamp, s_in.x, s_in.y, s_in.z);
-		}
-
 		cnt++;
-		/* 等待最多200ms以接收事件触发 */
-		( void )sub_test.wait(200);
-		( void )sub_sens.wait(200);
 		rt_thread_mdelay(100);
 	}
 }
@@ -78,6 +86,133 @@ int uorb_cpp_demo_init(void)
 	return 0;
 }
 
+/*
+ * 读路径基准：比较 updated()+copy() 两次调用与 SubscriptionData::update() 单次调用。
+ *  - idle：无新数据时反复轮询（最常见的路径）
+ *  - fresh：每次先发布再读取
+ */
+static unsigned bench_ns_per_iter(rt_tick_t ticks, unsigned iters)
+{
+	return (unsigned)((rt_uint64_t)ticks * 1000000000ull / RT_TICK_PER_SECOND / iters);
+}
+
+static int uorb_cpp_bench(int argc, char **argv)
+{
+	unsigned iters = (argc >= 2) ? (unsigned)atoi(argv[1]) : 100000u;
+	if (iters == 0) iters = 100000u;
+
+	uORB::PublicationMulti<orb_test_s> pub;
+	orb_test_s t{};
+	if (pub.publish(t) != RT_EOK) {
+		rt_kprintf("uorb_cpp_bench: advertise failed\n");
+		return -1;
+	}
+	const uint8_t inst = (uint8_t)pub.instance();
+
+	uORB::SubscriptionTyped<orb_test_s> two_call{inst};
+	uORB::SubscriptionData<orb_test_s> cached{inst};
+	orb_test_s out{};
+	volatile int32_t sink = 0;
+
+	rt_tick_t t0 = rt_tick_get();
+	for (unsigned i = 0; i < iters; i++) {
+		if (two_call.updated() && two_call.copy(&out) > 0) sink = out.val;
+	}
+	rt_tick_t idle_two = rt_tick_get() - t0;
+
+	t0 = rt_tick_get();
+	for (unsigned i = 0; i < iters; i++) {
+		if (cached.update()) sink = cached.get().val;
+	}
+	rt_tick_t idle_one = rt_tick_get() - t0;
+
+	t0 = rt_tick_get();
+	for (unsigned i = 0; i < iters; i++) {
+		t.val = (int32_t)i;
+		(void)pub.publish(t);
+		if (two_call.updated() && two_call.copy(&out) > 0) sink = out.val;
+	}
+	rt_tick_t fresh_two = rt_tick_get() - t0;
+
+	t0 = rt_tick_get();
+	for (unsigned i = 0; i < iters; i++) {
+		t.val = (int32_t)i;
+		(void)pub.publish(t);
+		if (cached.update()) sink = cached.get().val;
+	}
+	rt_tick_t fresh_one = rt_tick_get() - t0;
+	(void)sink;
+
+	rt_kprintf("uorb_cpp_bench: %u iterations (ns/iter)\n", iters);
+	rt_kprintf("  idle  check+copy: %u  SubscriptionData::update: %u\n",
+		   bench_ns_per_iter(idle_two, iters), bench_ns_per_iter(idle_one, iters));
+	rt_kprintf("  fresh check+copy: %u  SubscriptionData::update: %u (incl. publish)\n",
+		   bench_ns_per_iter(fresh_two, iters), bench_ns_per_iter(fresh_one, iters));
+	return 0;
+}
+
+#if defined(__cpp_impl_coroutine)
+/*
+ * 协程示例：uorb_co_demo [coroutines] [messages]
+ * N 个协程各自 co_await 同一主题，全部运行在一个执行器线程上。
+ */
+static uORB::CoExecutor g_co_exec{"u_co", 4096, 16};
+static std::atomic<int> g_co_done{0};
+
+static uORB::CoExecutor::Task co_demo_task(uint8_t instance, int messages)
+{
+	uORB::CoSubscription<orb_test_s> sub{g_co_exec, instance};
+	int32_t sum = 0;
+	for (int i = 0; i < messages; i++) {
+		const orb_test_s &msg = co_await sub.next();
+		sum += msg.val;
+	}
+	(void)sum;
+	g_co_done++;
+}
+
+static int uorb_co_demo(int argc, char **argv)
+{
+	int coroutines = (argc >= 2) ? atoi(argv[1]) : 100;
+	int messages   = (argc >= 3) ? atoi(argv[2]) : 10;
+	if (coroutines <= 0 || messages <= 0) {
+		rt_kprintf("usage: uorb_co_demo [coroutines] [messages]\n");
+		return -1;
+	}
+	if (!g_co_exec.start()) {
+		rt_kprintf("uorb_co_demo: executor start failed\n");
+		return -1;
+	}
+
+	uORB::PublicationMulti<orb_test_s> pub;
+	orb_test_s t{};
+	if (pub.publish(t) != RT_EOK) return -1;
+
+	g_co_done = 0;
+	for (int i = 0; i < coroutines; i++) {
+		g_co_exec.spawn(co_demo_task((uint8_t)pub.instance(), messages));
+	}
+	rt_thread_mdelay(10);
+
+	for (int i = 1; i <= messages; i++) {
+		t.timestamp = rt_tick_get();
+		t.val = i;
+		(void)pub.publish(t);
+		rt_thread_mdelay(10);
+	}
+	for (int wait = 0; wait < 100 && g_co_done < coroutines; wait++) {
+		rt_thread_mdelay(10);
+	}
+	rt_kprintf("uorb_co_demo: %d/%d coroutines received %d messages on one thread\n",
+		   g_co_done.load(), coroutines, messages);
+	return 0;
+}
+#endif
+
 #if defined(UORB_USING_CXX) && defined(UORB_ENABLE_CPP_DEMO)
 INIT_APP_EXPORT(uorb_cpp_demo_init);
+MSH_CMD_EXPORT(uorb_cpp_bench, uORB C++ read path benchmark);
+#if defined(__cpp_impl_coroutine)
+MSH_CMD_EXPORT(uorb_co_demo, uORB C++20 coroutine demo);
+#endif
 #endif 
\ No newline at end of file
@@ -0,0 +1,274 @@
+#ifndef UORB_CXX_SUBSCRIPTION_CALLBACK_HPP_
+#define UORB_CXX_SUBSCRIPTION_CALLBACK_HPP_
+
+#include <atomic>
+#include <stdint.h>
+#include <rtthread.h>
+
+#include "uORB.hpp"
+
+namespace uORB {
+
+// 可被 WorkQueue 调度的工作项
+class WorkItem {
+public:
+	virtual void Run() = 0;
+
+protected:
+	WorkItem() = default;
+	~WorkItem() = default;
+
+private:
+	friend class WorkQueue;
+	WorkItem *_next{nullptr};
+	std::atomic<bool> _queued{false};
+};
+
+// 单线程工作队列：发布侧以无锁方式入队（可在回调/中断上下文调用），工作线程按入队顺序执行。
+// 同一工作项在执行前被多次调度只会运行一次。
+// Usage:
+//   static uORB::WorkQueue wq{"u_wq", 2048, 12};
+//   wq.start();
+class WorkQueue : public NonCopyable {
+public:
+	explicit WorkQueue(const char *name, rt_uint32_t stack_size = 2048, rt_uint8_t priority = 12)
+		: _name(name), _stack_size(stack_size), _priority(priority) {}
+
+	~WorkQueue() { stop(); }
+
+	bool start() {
+		if (_thread) return true;
+		rt_sem_init(&_sem, "u_wqs", 0, RT_IPC_FLAG_FIFO);
+		rt_sem_init(&_exited, "u_wqe", 0, RT_IPC_FLAG_FIFO);
+		_stop = false;
+		_thread = rt_thread_create(_name, &WorkQueue::entry, this, _stack_size, _priority, 10);
+		if (!_thread) {
+			rt_sem_detach(&_sem);
+			rt_sem_detach(&_exited);
+			return false;
+		}
+		rt_thread_startup(_thread);
+		return true;
+	}
+
+	// 停止工作线程：已入队的工作项在线程退出前执行完，之后的调度被忽略。
+	// 调用前应先销毁挂在本队列上的 SubscriptionCallback
+	void stop() {
+		if (!_thread) return;
+		_stop = true;
+		rt_sem_release(&_sem);
+		rt_sem_take(&_exited, RT_WAITING_FOREVER);
+		// 与 stop 并发、线程退出后才入队的工作项不再执行：清除排队标记，重新 start() 后可再次调度
+		WorkItem *item = _head.exchange(nullptr, std::memory_order_acquire);
+		while (item) {
+			WorkItem *next = item->_next;
+			item->_next = nullptr;
+			item->_queued.store(false, std::memory_order_release);
+			item = next;
+		}
+		rt_sem_detach(&_sem);
+		rt_sem_detach(&_exited);
+		_thread = nullptr;
+	}
+
+	// 无锁入队（Treiber 栈，仅工作线程整体取走），不分配内存；
+	// 队列未运行时返回 false，已在队列中（合并）返回 true
+	bool schedule(WorkItem *item) {
+		if (_stop) return false;
+		bool expected = false;
+		if (!item->_queued.compare_exchange_strong(expected, true, std::memory_order_acq_rel)) {
+			return true; // 已在队列中，合并
+		}
+		WorkItem *head = _head.load(std::memory_order_relaxed);
+		do {
+			item->_next = head;
+		} while (!_head.compare_exchange_weak(head, item, std::memory_order_release, std::memory_order_relaxed));
+		rt_sem_release(&_sem);
+		return true;
+	}
+
+	bool in_worker() const { return _thread && rt_thread_self() == _thread; }
+
+	// 析构工作项前调用，保证之后不会再执行它：
+	//  - 在其他线程：在队尾放一个栅栏并阻塞等待，栅栏执行时排在前面的执行都已结束
+	//  - 在工作线程内（如 Run() 中销毁自身）：直接从待执行队列中摘除
+	// 调用前须保证不会再有人调度该工作项（如先注销回调）
+	void cancel(WorkItem *item) {
+		if (in_worker()) {
+			if (!item->_queued.load(std::memory_order_acquire)) return;
+			collect();
+			WorkItem **pp = &_fifo;
+			WorkItem *prev = nullptr;
+			while (*pp && *pp != item) {
+				prev = *pp;
+				pp = &(*pp)->_next;
+			}
+			if (*pp) {
+				*pp = item->_next;
+				if (_fifo_tail == item) _fifo_tail = prev;
+			}
+			item->_queued.store(false, std::memory_order_release);
+			return;
+		}
+		// 先读 _queued 再读 _current：工作线程先置 _current 再清 _queued
+		if (!item->_queued.load(std::memory_order_acquire) && _current.load(std::memory_order_acquire) != item) {
+			return;
+		}
+		Fence fence;
+		rt_sem_init(&fence.done, "u_wqf", 0, RT_IPC_FLAG_FIFO);
+		if (schedule(&fence)) {
+			rt_sem_take(&fence.done, RT_WAITING_FOREVER);
+		}
+		rt_sem_detach(&fence.done);
+	}
+
+private:
+	// cancel() 使用的栅栏：按入队顺序执行，执行到它时之前的工作项均已完成
+	struct Fence final : WorkItem {
+		struct rt_semaphore done;
+		void Run() override { rt_sem_release(&done); }
+	};
+
+	// 工作线程：取走并依次执行当前已入队的全部工作项
+	void run_pending() {
+		collect();
+		while (_fifo) {
+			WorkItem *item = _fifo;
+			_fifo = item->_next;
+			if (!_fifo) _fifo_tail = nullptr;
+			_current.store(item, std::memory_order_release);
+			item->_queued.store(false, std::memory_order_release);
+			// Run() 之后不再访问 item：一次性工作项可能在 Run() 内释放自身
+			item->Run();
+			_current.store(nullptr, std::memory_order_release);
+		}
+	}
+
+	// 工作线程：把无锁栈整体取走，按入队顺序接到本地待执行链表尾部
+	void collect() {
+		WorkItem *list = _head.exchange(nullptr, std::memory_order_acquire);
+		WorkItem *batch = nullptr;
+		WorkItem *batch_tail = list;
+		while (list) {
+			WorkItem *next = list->_next;
+			list->_next = batch;
+			batch = list;
+			list = next;
+		}
+		if (!batch) return;
+		if (_fifo_tail) {
+			_fifo_tail->_next = batch;
+		} else {
+			_fifo = batch;
+		}
+		_fifo_tail = batch_tail;
+	}
+
+	static void entry(void *parameter) {
+		WorkQueue *wq = static_cast<WorkQueue *>(parameter);
+		while (!wq->_stop) {
+			rt_sem_take(&wq->_sem, RT_WAITING_FOREVER);
+			wq->run_pending();
+		}
+		// 退出前排空：stop() 之前入队的工作项（含等待中的 cancel() 栅栏）都执行一次
+		wq->run_pending();
+		rt_sem_release(&wq->_exited);
+	}
+
+	const char *_name;
+	rt_uint32_t _stack_size;
+	rt_uint8_t _priority;
+	rt_thread_t _thread{nullptr};
+	struct rt_semaphore _sem;
+	struct rt_semaphore _exited;
+	volatile bool _stop{true};     // start() 前与 stop() 后拒绝调度
+	std::atomic<WorkItem *> _head{nullptr};
+	std::atomic<WorkItem *> _current{nullptr};
+	WorkItem *_fifo{nullptr};      // 仅工作线程访问
+	WorkItem *_fifo_tail{nullptr};
+};
+
+// 推送式订阅：在节点上注册带上下文的回调，发布时
+//  - work_queue 为空：在发布线程内联调用 fn（消息直接引用发布方缓冲，不拷贝）；
+//    fn 内可析构本对象（注销自身回调），但不可向同一主题实例发布（见 orb_callback_fn_t）
+//  - 否则：调度到 work_queue 线程，以 SubscriptionData::update() 取数后调用 fn；fn 内同样可析构本对象
+// 析构时自动注销回调，并等待排队中的执行完成。
+// Usage:
+//   static void on_sensor(const sensor_demo_s &msg, void *ctx) { ... }
+//   uORB::SubscriptionCallback<sensor_demo_s> cb{on_sensor, nullptr, &wq};   // meta from topic_traits
+//   uORB::SubscriptionCallback<other_s> cb{ORB_ID(other), on_other, nullptr, &wq};   // struct without traits
+//   cb.registerCallback();
+
+template<typename T>
+class SubscriptionCallback : public SubscriptionData<T>, public WorkItem {
+public:
+	using Callback = void (*)(const T &msg, void *context);
+
+	SubscriptionCallback(detail::topic_meta<T> meta, Callback fn, void *context = nullptr,
+			     WorkQueue *work_queue = nullptr, uint8_t instance = 0)
+		: SubscriptionData<T>(meta, instance), _fn(fn), _context(context), _wq(work_queue) {}
+
+	explicit SubscriptionCallback(Callback fn, void *context = nullptr, WorkQueue *work_queue = nullptr,
+				      uint8_t instance = 0)
+		: SubscriptionCallback(detail::topic_meta<T>(), fn, context, work_queue, instance) {}
+
+	~SubscriptionCallback() {
+		if (_destroyed) *_destroyed = true;
+		unregisterCallback();
+	}
+
+	bool registerCallback() {
+		if (_registered) return true;
+		if (orb_register_callback_ctx(this->meta(), this->instance(), &_cb, &SubscriptionCallback::on_publish, this) != RT_EOK) {
+			return false;
+		}
+		_registered = true;
+		return true;
+	}
+
+	void unregisterCallback() {
+		if (!_registered) return;
+		(void)orb_unregister_callback_ctx(&_cb);
+		_registered = false;
+		// 回调注销后不会再被调度；再处理已入队的一次执行
+		if (_wq) {
+			_wq->cancel(this);
+		}
+	}
+
+	bool registered() const { return _registered; }
+
+	// fn 内可析构本对象：析构后立即返回，不再访问成员
+	void Run() override {
+		bool destroyed = false;
+		_destroyed = &destroyed;
+		while (this->update()) {
+			_fn(this->get(), _context);
+			if (destroyed) return;
+		}
+		_destroyed = nullptr;
+	}
+
+private:
+	static void on_publish(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context) {
+		(void)meta;
+		(void)instance;
+		SubscriptionCallback *self = static_cast<SubscriptionCallback *>(context);
+		if (self->_wq) {
+			self->_wq->schedule(self);
+		} else {
+			self->_fn(*static_cast<const T *>(data), self->_context);
+		}
+	}
+
+	Callback _fn;
+	void *_context;
+	WorkQueue *_wq;
+	orb_callback_t _cb{};
+	bool _registered{false};
+	bool *_destroyed{nullptr};     // 仅工作线程 Run() 期间非空
+};
+
+} // namespace uORB
+
+#endif // UORB_CXX_SUBSCRIPTION_CALLBACK_HPP_
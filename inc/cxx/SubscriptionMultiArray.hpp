@@ -0,0 +1,73 @@
+#ifndef UORB_CXX_SUBSCRIPTION_MULTI_ARRAY_HPP_
+#define UORB_CXX_SUBSCRIPTION_MULTI_ARRAY_HPP_
+
+#include <stdint.h>
+#include <rtthread.h>
+
+#include "uORB.hpp"
+#include "uorb_group.h"
+
+namespace uORB {
+
+// 订阅主题的全部实例并按策略选择其一（冗余传感器）
+// Usage:
+//   uORB::SubscriptionMultiArray<sensor_demo_s> sensors;   // meta from topic_traits
+//   sensors.set_policy(ORB_GROUP_FAILOVER, 50000);
+//   if (sensors.update()) { use(sensors.get(), sensors.selected()); }
+template<typename T>
+class SubscriptionMultiArray : public NonCopyable {
+public:
+	SubscriptionMultiArray() : SubscriptionMultiArray(detail::topic_meta<T>()) {}
+
+	explicit SubscriptionMultiArray(detail::topic_meta<T> meta) : _meta(meta.id), _group(orb_subscribe_group(meta.id)) {}
+
+	~SubscriptionMultiArray() {
+		if (_group) {
+			orb_unsubscribe_group(_group);
+		}
+	}
+
+	bool valid() const { return _group != nullptr; }
+
+	int set_policy(orb_group_policy_t policy, uint32_t timeout_us = 0) {
+		return orb_group_set_policy(_group, policy, timeout_us);
+	}
+
+	// 自上次检查以来有新发布的实例位图，0 表示均无更新
+	uint32_t updated() { return orb_group_updated(_group); }
+
+	// 选中实例有新数据（或发生切换）时刷新缓存并返回 true
+	bool update() {
+		int inst = -1;
+		if (orb_group_update(_group, &_data, &inst) > 0) {
+			_selected = inst;
+			return true;
+		}
+		return false;
+	}
+
+	const T &get() const { return _data; }
+
+	// 最近一次 update() 输出数据的实例，-1 表示尚无
+	int selected() const { return _selected; }
+
+	// 实例上限：有特性时取 topic_traits<T>::instances（%instances），否则为 ORB_MULTI_MAX_INSTANCES
+	static constexpr int size() { return detail::topic_instances<T>::value; }
+
+	// 按实例读取最新数据：不影响选择，也不消费 update() 尚未取出的消息
+	bool copy(int instance, T *out) const {
+		return orb_group_copy(_group, instance, out) > 0;
+	}
+
+	orb_id_t meta() const { return _meta; }
+
+private:
+	orb_id_t _meta{nullptr};
+	orb_sub_group_t *_group{nullptr};
+	T _data{};
+	int _selected{-1};
+};
+
+} // namespace uORB
+
+#endif // UORB_CXX_SUBSCRIPTION_MULTI_ARRAY_HPP_
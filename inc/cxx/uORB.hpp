@@ -16,22 +16,75 @@ protected:
 	NonCopyable& operator=(const NonCopyable&) = delete;
 };
 
+// 由消息结构体类型取主题元数据，等价于 ORB_ID(name)；无特性定义时编译失败
+// Usage:
+//   orb_id_t id = uORB::orb_id<sensor_demo_s>();
+template<typename T>
+constexpr orb_id_t orb_id() { return topic_traits<T>::id(); }
+
+namespace detail {
+
+template<typename T, typename = void>
+struct has_topic_traits { static constexpr bool value = false; };
+
+template<typename T>
+struct has_topic_traits<T, decltype((void)topic_traits<T>::size)> { static constexpr bool value = true; };
+
+// 构造函数的元数据参数。有 topic_traits 的类型默认取特性，也接受显式传入的 ORB_ID，
+// 但须与特性一致：错配时断言失败，关闭断言时元数据置空，公告与订阅随之失败；
+// 无特性的类型须显式传入，运行期校验消息大小。
+template<typename T, bool = has_topic_traits<T>::value>
+struct topic_meta;
+
+template<typename T>
+struct topic_meta<T, true> {
+	topic_meta() : id(topic_traits<T>::id()) {}
+	topic_meta(orb_id_t meta) : id(meta == topic_traits<T>::id() ? meta : nullptr) {
+		RT_ASSERT(meta == topic_traits<T>::id());
+	}
+	orb_id_t id;
+};
+
+template<typename T>
+struct topic_meta<T, false> {
+	topic_meta(orb_id_t meta) : id(meta) { RT_ASSERT(meta == nullptr || meta->o_size == sizeof(T)); }
+	orb_id_t id;
+};
+
+template<typename T, bool = has_topic_traits<T>::value>
+struct topic_instances { static constexpr int value = topic_traits<T>::instances; };
+
+template<typename T>
+struct topic_instances<T, false> { static constexpr int value = ORB_MULTI_MAX_INSTANCES; };
+
+} // namespace detail
+
 // Publication for single-instance topics
 // Usage:
-//   uORB::Publication<topic_s> pub{ORB_ID(topic)};
+//   uORB::Publication<topic_s> pub;                   // meta/queue from topic_traits<topic_s>
+//   uORB::Publication<topic_s> pub{4};                // meta from topic_traits, queue length 4
+//   uORB::Publication<topic_s> pub{ORB_ID(topic)};    // must match topic_traits<topic_s>
+//   uORB::Publication<other_s> pub{ORB_ID(other)};    // struct without topic_traits
 //   topic_s t{}; pub.publish(t);
+// The topic is unadvertised when the Publication is destroyed (or unadvertise()
+// is called); a later publish() advertises it again.
 
 template<typename T>
 class Publication : public NonCopyable {
 public:
-	explicit Publication(orb_id_t meta, unsigned queue_size = 1)
-		: _meta(meta), _handle(nullptr), _queue_size(queue_size) {}
+	Publication() : Publication(detail::topic_meta<T>(), topic_traits<T>::queue) {}
+
+	explicit Publication(unsigned queue_size) : Publication(detail::topic_meta<T>(), queue_size) {}
+
+	explicit Publication(detail::topic_meta<T> meta, unsigned queue_size = 1)
+		: _meta(meta.id), _handle(nullptr), _queue_size(queue_size) {}
 
 	Publication(Publication&& other) noexcept
 		: _meta(other._meta), _handle(other._handle), _queue_size(other._queue_size) { other._handle = nullptr; }
 
 	Publication& operator=(Publication&& other) noexcept {
 		if (this != &other) {
+			unadvertise();
 			_meta = other._meta;
 			_handle = other._handle;
 			_queue_size = other._queue_size;
@@ -40,10 +93,19 @@ public:
 		return *this;
 	}
 
-	~Publication() = default;
+	~Publication() { unadvertise(); }
+
+	// 取消公告：无订阅者时释放节点，否则保留节点供再次公告复用
+	int unadvertise() {
+		if (!_handle) return RT_EOK;
+		int ret = orb_unadvertise(_handle);
+		_handle = nullptr;
+		return ret;
+	}
 
 	int advertise(const T& initial) {
 		if (_handle) return RT_EOK;
+		if (!_meta) return -RT_ERROR;
 		_handle = (_queue_size > 1)
 			? orb_advertise_queue(_meta, &initial, _queue_size)
 			: orb_advertise(_meta, &initial);
@@ -52,6 +114,7 @@ public:
 
 	int publish(const T& data) {
 		if (!_handle) {
+			if (!_meta) return -RT_ERROR;
 			// lazy advertise with provided data as initial
 			_handle = (_queue_size > 1)
 				? orb_advertise_queue(_meta, &data, _queue_size)
@@ -71,14 +134,23 @@ private:
 
 // Publication for multi-instance topics
 // Usage:
-//   uORB::PublicationMulti<topic_s> pub{ORB_ID(topic)};
+//   uORB::PublicationMulti<topic_s> pub;              // meta/queue from topic_traits<topic_s>
+//   uORB::PublicationMulti<topic_s> pub{4};           // meta from topic_traits, queue length 4
+//   uORB::PublicationMulti<topic_s> pub{ORB_ID(topic)}; // must match topic_traits<topic_s>
+//   uORB::PublicationMulti<other_s> pub{ORB_ID(other)}; // struct without topic_traits
 //   pub.publish(t);
+// The instance is released on destruction; a restarted module re-acquires the
+// lowest free instance, i.e. the same one if no other publisher took it meanwhile.
 
 template<typename T>
 class PublicationMulti : public NonCopyable {
 public:
-	explicit PublicationMulti(orb_id_t meta, unsigned queue_size = 1)
-		: _meta(meta), _handle(nullptr), _queue_size(queue_size), _instance(-1) {}
+	PublicationMulti() : PublicationMulti(detail::topic_meta<T>(), topic_traits<T>::queue) {}
+
+	explicit PublicationMulti(unsigned queue_size) : PublicationMulti(detail::topic_meta<T>(), queue_size) {}
+
+	explicit PublicationMulti(detail::topic_meta<T> meta, unsigned queue_size = 1)
+		: _meta(meta.id), _handle(nullptr), _queue_size(queue_size), _instance(-1) {}
 
 	PublicationMulti(PublicationMulti&& other) noexcept
 		: _meta(other._meta), _handle(other._handle), _queue_size(other._queue_size), _instance(other._instance) {
@@ -88,6 +160,7 @@ public:
 
 	PublicationMulti& operator=(PublicationMulti&& other) noexcept {
 		if (this != &other) {
+			unadvertise();
 			_meta = other._meta;
 			_handle = other._handle;
 			_queue_size = other._queue_size;
@@ -98,10 +171,20 @@ public:
 		return *this;
 	}
 
-	~PublicationMulti() = default;
+	~PublicationMulti() { unadvertise(); }
+
+	// 释放实例：无订阅者时释放节点，否则保留节点供再次公告复用
+	int unadvertise() {
+		if (!_handle) return RT_EOK;
+		int ret = orb_unadvertise(_handle);
+		_handle = nullptr;
+		_instance = -1;
+		return ret;
+	}
 
 	int advertise(const T& initial) {
 		if (_handle) return RT_EOK;
+		if (!_meta) return -RT_ERROR;
 		int inst = -1;
 		_handle = (_queue_size > 1)
 			? orb_advertise_multi_queue(_meta, &initial, &inst, _queue_size)
@@ -115,6 +198,7 @@ public:
 
 	int publish(const T& data) {
 		if (!_handle) {
+			if (!_meta) return -RT_ERROR;
 			int inst = -1;
 			_handle = (_queue_size > 1)
 				? orb_advertise_multi_queue(_meta, &data, &inst, _queue_size)
@@ -125,6 +209,12 @@ public:
 		return orb_publish(_meta, _handle, &data);
 	}
 
+	// 需在公告之后调用（advertise() 或首次 publish()）
+	int set_priority(uint8_t priority) {
+		if (!_handle) return -RT_EINVAL;
+		return orb_set_priority(_handle, priority);
+	}
+
 	int instance() const { return _instance; }
 	orb_advert_t handle() const { return _handle; }
 
@@ -136,11 +226,17 @@ private:
 };
 
 // Subscription wrapper
+// Usage:
+//   uORB::Subscription sub{ORB_ID(topic)};             // untyped
+//   uORB::SubscriptionTyped<topic_s> sub{instance};    // typed, meta from topic_traits<topic_s>
+//   uORB::SubscriptionTyped<topic_s> sub{ORB_ID(topic), instance}; // typed, must match topic_traits<topic_s>
+//   uORB::SubscriptionTyped<other_s> sub{ORB_ID(other)}; // typed, struct without topic_traits
+
 class Subscription : public NonCopyable {
 public:
 	explicit Subscription(orb_id_t meta, uint8_t instance = 0)
 		: _meta(meta), _instance(instance) {
-		_handle = orb_subscribe_multi(_meta, _instance);
+		_handle = _meta ? orb_subscribe_multi(_meta, _instance) : nullptr;
 	}
 
 	Subscription(Subscription&& other) noexcept
@@ -150,6 +246,9 @@ public:
 
 	Subscription& operator=(Subscription&& other) noexcept {
 		if (this != &other) {
+			if (_handle) {
+				orb_unsubscribe(_handle);
+			}
 			_meta = other._meta;
 			_instance = other._instance;
 			_handle = other._handle;
@@ -179,11 +278,9 @@ public:
 
 	template<typename U>
 	bool update(U* out) const {
-		// 进行一次检查，如有更新则 copy 消费
+		// 单次调用：无更新时只做一次代数比较
 		if (!_handle) return false;
-		rt_bool_t u = RT_FALSE;
-		if (orb_check(_handle, &u) != RT_EOK || !u) return false;
-		return copy(out) == RT_EOK;
+		return orb_update(_handle, static_cast<void*>(out)) > 0;
 	}
 
 	int set_interval(unsigned interval_ms) {
@@ -191,6 +288,11 @@ public:
 		return orb_set_interval(_handle, interval_ms);
 	}
 
+	int set_interval_us(uint32_t interval_us) {
+		if (!_handle) return -RT_EINVAL;
+		return orb_set_interval_us(_handle, interval_us);
+	}
+
 	int get_interval(unsigned* interval_ms) const {
 		if (!_handle) return -RT_EINVAL;
 		return orb_get_interval(_handle, interval_ms);
@@ -205,6 +307,7 @@ public:
 		return orb_exists(_meta, _instance) == RT_EOK;
 	}
 
+	orb_id_t meta() const { return _meta; }
 	orb_subscr_t handle() const { return _handle; }
 	uint8_t instance() const { return _instance; }
 
@@ -214,6 +317,53 @@ private:
 	orb_subscr_t _handle{nullptr};
 };
 
+// Typed subscription: the buffer type is fixed to T, so a wrong struct
+// can no longer be passed to copy()/update().
+template<typename T>
+class SubscriptionTyped : public Subscription {
+public:
+	explicit SubscriptionTyped(uint8_t instance = 0) : SubscriptionTyped(detail::topic_meta<T>(), instance) {}
+
+	explicit SubscriptionTyped(detail::topic_meta<T> meta, uint8_t instance = 0)
+		: Subscription(meta.id, instance) {}
+
+	SubscriptionTyped(SubscriptionTyped&&) noexcept = default;
+	SubscriptionTyped& operator=(SubscriptionTyped&&) noexcept = default;
+
+	int copy(T* out) const { return Subscription::copy(out); }
+	bool update(T* out) const { return Subscription::update(out); }
+
+	template<typename U> int copy(U* out) const = delete;
+	template<typename U> bool update(U* out) const = delete;
+};
+
+// Subscription owning a cached copy of the latest message
+// Usage:
+//   uORB::SubscriptionData<topic_s> sub;              // or sub{instance}; sub{ORB_ID(other), instance} without traits
+//   if (sub.update()) { use(sub.get()); }
+
+template<typename T>
+class SubscriptionData : public SubscriptionTyped<T> {
+public:
+	explicit SubscriptionData(uint8_t instance = 0) : SubscriptionData(detail::topic_meta<T>(), instance) {}
+
+	explicit SubscriptionData(detail::topic_meta<T> meta, uint8_t instance = 0)
+		: SubscriptionTyped<T>(meta, instance) {
+		// 若主题已有数据，先取一份作为初值
+		if (this->handle() && this->exists()) {
+			(void)SubscriptionTyped<T>::copy(&_data);
+		}
+	}
+
+	// 有新数据时刷新缓存并返回 true
+	bool update() { return SubscriptionTyped<T>::update(&_data); }
+
+	const T& get() const { return _data; }
+
+private:
+	T _data{};
+};
+
 // Subscription with interval preset
 class SubscriptionInterval : public Subscription {
 public:
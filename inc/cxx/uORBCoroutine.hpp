@@ -0,0 +1,164 @@
+#ifndef UORB_CXX_UORB_COROUTINE_HPP_
+#define UORB_CXX_UORB_COROUTINE_HPP_
+
+// C++20 协程支持：co_await sub.next() 挂起协程而不占用线程栈，
+// 由 CoExecutor 在主题发布后于执行器线程上恢复。需要 -std=c++20（GCC 10 另需 -fcoroutines）。
+
+#if defined(__cpp_impl_coroutine) && __has_include(<coroutine>)
+
+#include <atomic>
+#include <coroutine>
+#include <stdint.h>
+#include <rtthread.h>
+
+#include "uORB.hpp"
+#include "SubscriptionCallback.hpp"
+
+namespace uORB {
+
+// 协程执行器：一个 RT-Thread 线程上复用任意数量的协程。
+// 复用 WorkQueue 的无锁投递；协程本身只占用编译器分配的协程帧。
+// Usage:
+//   static uORB::CoExecutor exec{"u_co", 4096, 12};
+//   exec.start();
+//   exec.spawn(my_task(...));
+class CoExecutor : public WorkQueue {
+public:
+	using WorkQueue::WorkQueue;
+
+	// 协程返回类型：创建后挂起，由 spawn() 投递到执行器首次运行，结束后自动销毁协程帧。
+	// 只可移动；从未成功 spawn 的 Task 析构时销毁协程帧
+	class Task {
+	public:
+		struct promise_type : public WorkItem {
+			Task get_return_object() {
+				return Task{std::coroutine_handle<promise_type>::from_promise(*this)};
+			}
+			std::suspend_always initial_suspend() noexcept { return {}; }
+			std::suspend_never final_suspend() noexcept { return {}; }
+			void return_void() {}
+			void unhandled_exception() { RT_ASSERT(0); }
+
+			void Run() override { std::coroutine_handle<promise_type>::from_promise(*this).resume(); }
+		};
+
+		Task() = default;
+		Task(Task &&other) noexcept : _handle(other._handle) { other._handle = nullptr; }
+		Task &operator=(Task &&other) noexcept {
+			if (this != &other) {
+				reset();
+				_handle = other._handle;
+				other._handle = nullptr;
+			}
+			return *this;
+		}
+		Task(const Task &) = delete;
+		Task &operator=(const Task &) = delete;
+		~Task() { reset(); }
+
+		explicit operator bool() const { return static_cast<bool>(_handle); }
+
+	private:
+		friend class CoExecutor;
+		explicit Task(std::coroutine_handle<promise_type> handle) : _handle(handle) {}
+
+		void reset() {
+			if (_handle) {
+				_handle.destroy();
+				_handle = nullptr;
+			}
+		}
+
+		std::coroutine_handle<promise_type> _handle;
+	};
+
+	// 投递成功后协程帧归执行器所有；执行器未运行时返回 false，协程帧随 task 一起销毁
+	bool spawn(Task task) {
+		if (!task._handle || !schedule(&task._handle.promise())) {
+			return false;
+		}
+		// 投递后协程可能已在执行器线程上运行完毕并销毁帧：只放弃句柄，不再访问
+		task._handle = nullptr;
+		return true;
+	}
+};
+
+// 可等待的订阅：同一时刻只允许一个协程等待
+// Usage:
+//   uORB::CoSubscription<sensor_demo_s> sub{exec};   // meta from topic_traits, or sub{exec, instance}
+//   uORB::CoSubscription<other_s> sub{exec, ORB_ID(other)};   // struct without traits
+//   const sensor_demo_s &msg = co_await sub.next();
+template<typename T>
+class CoSubscription : public SubscriptionData<T>, public WorkItem {
+public:
+	explicit CoSubscription(CoExecutor &executor, uint8_t instance = 0)
+		: CoSubscription(executor, detail::topic_meta<T>(), instance) {}
+
+	CoSubscription(CoExecutor &executor, detail::topic_meta<T> meta, uint8_t instance = 0)
+		: SubscriptionData<T>(meta, instance), _exec(executor) {
+		_registered = orb_register_callback_ctx(meta.id, instance, &_cb, &CoSubscription::on_publish, this) == RT_EOK;
+	}
+
+	~CoSubscription() {
+		if (_registered) {
+			(void)orb_unregister_callback_ctx(&_cb);
+		}
+		_waiting.store(nullptr, std::memory_order_release);
+		_exec.cancel(this);
+	}
+
+	bool valid() const { return _registered && this->handle(); }
+
+	struct Awaiter {
+		CoSubscription &sub;
+
+		// 已有更新（遵循订阅间隔）时不挂起
+		bool await_ready() { return sub.update(); }
+
+		void await_suspend(std::coroutine_handle<> h) {
+			sub._waiting.store(h.address(), std::memory_order_release);
+			// 补一次检查：覆盖 await_ready 与登记之间到达的发布
+			sub._exec.schedule(&sub);
+		}
+
+		const T &await_resume() const { return sub.get(); }
+	};
+
+	// co_await sub.next() 返回更新后的消息引用（下一次 next() 之前有效）
+	Awaiter next() { return Awaiter{*this}; }
+
+	// 执行器线程：有更新则恢复等待者，否则保持登记等待下一次发布
+	void Run() override {
+		if (!_waiting.load(std::memory_order_acquire)) {
+			return;
+		}
+		if (this->update()) {
+			void *h = _waiting.exchange(nullptr, std::memory_order_acq_rel);
+			if (h) {
+				std::coroutine_handle<>::from_address(h).resume();
+			}
+		}
+	}
+
+private:
+	static void on_publish(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context) {
+		(void)meta;
+		(void)instance;
+		(void)data;
+		CoSubscription *self = static_cast<CoSubscription *>(context);
+		if (self->_waiting.load(std::memory_order_acquire)) {
+			self->_exec.schedule(self);
+		}
+	}
+
+	CoExecutor &_exec;
+	orb_callback_t _cb{};
+	bool _registered{false};
+	std::atomic<void *> _waiting{nullptr};
+};
+
+} // namespace uORB
+
+#endif // __cpp_impl_coroutine
+
+#endif // UORB_CXX_UORB_COROUTINE_HPP_
@@ -44,10 +44,64 @@ typedef struct orb_subscribe_s orb_subscribe_t;
 typedef orb_node_t *orb_advert_t;
 typedef orb_subscribe_t *orb_subscr_t;
 
+/**
+ * Topic update callback.
+ *
+ * @param meta      The uORB metadata of the topic that was published.
+ * @param instance  The instance that was published.
+ * @param data      Const pointer to the message that has just been written.
+ *      It is only valid for the duration of the callback; copy it if it
+ *      must outlive the call.
+ * @param context   The user pointer given at registration.
+ *
+ * Runs in the publisher's thread while the node's callback lock is held.
+ * The callback may orb_copy() the same topic and may register or unregister
+ * callbacks on it, including its own entry. It must not publish to the same
+ * topic instance: that would take the lock again (asserted; deadlocks on SMP).
+ */
+typedef void (*orb_callback_fn_t)(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context);
+
+/**
+ * Callback registration entry.
+ *
+ * Owned by the caller (intrusive list item): registration links it into the
+ * node's callback list without allocating, unregistration unlinks it. The
+ * entry must stay valid until orb_unregister_callback_ctx() returns.
+ */
+typedef struct orb_callback_s {
+    rt_list_t          list;
+    void             (*call)(void);  /**< legacy callback (orb_register_callback) */
+    orb_callback_fn_t  fn;           /**< context-carrying callback */
+    void              *context;
+    struct orb_node_s *node;         /**< node the entry is linked into, NULL if not registered */
+} orb_callback_t;
+
 #ifndef ORB_MULTI_MAX_INSTANCES
+#ifdef UORB_MULTI_MAX_INSTANCES
+#define ORB_MULTI_MAX_INSTANCES UORB_MULTI_MAX_INSTANCES
+#else
 #define ORB_MULTI_MAX_INSTANCES 4
+#endif
 #endif //ORB_MULTI_MAX_INSTANCES
 
+#if ORB_MULTI_MAX_INSTANCES < 1 || ORB_MULTI_MAX_INSTANCES > 32
+#error "ORB_MULTI_MAX_INSTANCES must be in 1..32"
+#endif
+
+/**
+ * Relative priorities of the publishers of a multi-instance topic, used by
+ * group subscriptions to pick an instance (see orb_set_priority()).
+ */
+enum ORB_PRIO {
+    ORB_PRIO_MIN       = 1,
+    ORB_PRIO_VERY_LOW  = 25,
+    ORB_PRIO_LOW       = 50,
+    ORB_PRIO_DEFAULT   = 75,
+    ORB_PRIO_HIGH      = 100,
+    ORB_PRIO_VERY_HIGH = 125,
+    ORB_PRIO_MAX       = 255
+};
+
 /**
  * Generates a pointer to the uORB metadata structure for
  * a given topic.
@@ -208,6 +262,14 @@ int orb_unadvertise(orb_advert_t handle);
  * will be notified.  Subscribers that are not waiting can check the topic
  * for updates using orb_check.
  *
+ * Must be called from thread context: the first publish allocates the ring
+ * buffer and callbacks run in the caller. Use orb_publish_isr()
+ * (UORB_USING_ISR_PUBLISH) from interrupt handlers.
+ *
+ * On a node switched to orb_set_publish_deferred() (UORB_USING_DEFERRED_PUBLISH)
+ * the message is only queued; delivery happens in the delivery thread, and
+ * -RT_EFULL is returned when the queue is full.
+ *
  * @param meta    The uORB metadata (usually from the ORB_ID() macro)
  *      for the topic.
  * @param handle  The handle returned from orb_advertise.
@@ -216,6 +278,71 @@ int orb_unadvertise(orb_advert_t handle);
  */
 int orb_publish(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
 
+/**
+ * Limit the publish rate of a topic instance on the publisher side.
+ *
+ * Publishes arriving less than interval_us after the last accepted one return
+ * RT_EOK without touching the queue or notifying subscribers, and are counted
+ * as suppressed. An interval of 0 removes the limit.
+ *
+ * @param handle  The handle returned from orb_advertise.
+ * @param interval_us  Minimum interval between accepted publishes in microseconds.
+ * @return    RT_EOK on success, -RT_EINVAL on invalid handle.
+ */
+int orb_set_publish_interval_us(orb_advert_t handle, rt_uint32_t interval_us);
+
+/**
+ * Keep only one of every factor publishes (0 or 1 disables decimation).
+ * Applied before the rate limit; dropped publishes are counted as suppressed.
+ */
+int orb_set_publish_decimation(orb_advert_t handle, rt_uint16_t factor);
+
+/**
+ * Let the node adopt the fastest subscriber interval as its publish limit.
+ *
+ * Only takes effect while every consumer is a subscription throttled by
+ * orb_set_interval()/orb_set_interval_us() on the local clock; any
+ * callback, unthrottled or timestamp-keyed subscriber disables it. An
+ * explicit orb_set_publish_interval_us() still applies as a lower bound.
+ */
+int orb_set_publish_auto_rate(orb_advert_t handle, rt_bool_t enable);
+
+/**
+ * Publish only when the content changes.
+ *
+ * A publish whose payload equals the latest queued message (the uint64
+ * timestamp field and trailing padding are not compared) returns RT_EOK
+ * without advancing the generation, running callbacks or waking
+ * subscribers, and is counted as suppressed. An unchanged message is still
+ * let through once heartbeat_us has elapsed since the last accepted one, so
+ * subscribers can tell a quiet publisher from a dead one; 0 disables the
+ * heartbeat. Not applied to nodes bound to the shared-memory segment.
+ *
+ * @param handle        The handle returned from orb_advertise.
+ * @param enable        Enable or disable change-only publishing.
+ * @param heartbeat_us  Longest interval without an accepted publish.
+ * @return    RT_EOK on success, -RT_EINVAL on invalid handle.
+ */
+int orb_set_publish_on_change(orb_advert_t handle, rt_bool_t enable, rt_uint32_t heartbeat_us);
+
+/** Number of publishes dropped by rate limiting, decimation or change-only mode since advertise. */
+int orb_get_publish_suppressed(orb_advert_t handle, rt_uint32_t *count);
+
+/**
+ * Set the priority of a topic instance (ORB_PRIO_*, default ORB_PRIO_DEFAULT).
+ *
+ * Group subscriptions using ORB_GROUP_PRIORITY or ORB_GROUP_FAILOVER prefer
+ * the instance with the highest priority.
+ *
+ * @param handle    The handle returned from orb_advertise.
+ * @param priority  New priority.
+ * @return    RT_EOK on success, -RT_EINVAL on invalid handle.
+ */
+int orb_set_priority(orb_advert_t handle, rt_uint8_t priority);
+
+/** Priority of a topic instance. */
+int orb_get_priority(orb_advert_t handle, rt_uint8_t *priority);
+
 /**
  * Advertise as the publisher of a topic.
  *
@@ -352,6 +479,21 @@ int orb_copy(const struct orb_metadata *meta, orb_subscr_t handle, void *buffer)
  */
 int orb_check(orb_subscr_t handle, rt_bool_t *updated);
 
+/**
+ * Copy the next update of a topic if there is one.
+ *
+ * Equivalent to orb_check() followed by orb_copy(), but the common "no new
+ * data" case costs a single generation compare and the node is resolved only
+ * once. Subscription intervals are honoured. For queued topics the next
+ * unread message is returned, so repeated calls drain the queue in order.
+ *
+ * @param handle  A handle returned from orb_subscribe.
+ * @param buffer  Pointer to the buffer receiving the data.
+ * @return    The number of bytes copied if there was an update, 0 if there
+ *      was none (or the topic is not advertised), negative on error.
+ */
+int orb_update(orb_subscr_t handle, void *buffer);
+
 /**
  * Check if a topic has already been created and published (advertised)
  *
@@ -369,6 +511,95 @@ int orb_exists(const struct orb_metadata *meta, int instance);
  */
 extern int orb_group_count(const struct orb_metadata *meta);
 
+/**
+ * Counters of one topic node, as captured by orb_snapshot().
+ */
+typedef struct orb_node_stat_s {
+    const struct orb_metadata *meta;
+    rt_uint32_t id;               /**< node serial number, never reused; use it to track a node across snapshots */
+    rt_uint32_t generation;       /**< number of messages published */
+    rt_uint32_t suppressed;       /**< publications dropped by rate limiting/decimation/change-only mode */
+    rt_uint8_t  instance;
+    rt_uint8_t  queue_size;
+    rt_uint8_t  subscriber_count;
+    rt_uint8_t  priority;
+    rt_bool_t   advertised;
+    rt_bool_t   data_valid;
+    rt_uint64_t bytes_published;  /**< bytes written into the queue */
+    rt_uint64_t bytes_copied;     /**< bytes copied out by subscribers */
+    rt_uint64_t write_us;         /**< time spent publishing, callbacks included (UORB_USING_PROFILING, else 0) */
+    rt_uint64_t read_us;          /**< time spent copying out (UORB_USING_PROFILING, else 0) */
+    rt_uint32_t mem_bytes;        /**< heap owned by this node: node, event, queue (once allocated), subscriptions */
+} orb_node_stat_t;
+
+/**
+ * Copy the counters of all topic nodes into a caller buffer.
+ *
+ * Only the registry lock is taken, for the duration of the copy; formatting
+ * and printing are left to the caller, outside of any lock.
+ *
+ * @param stats   Output array, may be NULL if @p max is 0.
+ * @param max     Capacity of @p stats.
+ * @return    The total number of nodes (may exceed @p max, in which case
+ *      only the first @p max are filled), -RT_EINVAL on bad arguments.
+ */
+int orb_snapshot(orb_node_stat_t *stats, int max);
+
+/**
+ * Counters of a single topic instance, see orb_snapshot().
+ *
+ * @return    RT_EOK, -RT_ENOENT if the instance has no node, -RT_EINVAL on
+ *      bad arguments.
+ */
+int orb_node_stat(const struct orb_metadata *meta, int instance, orb_node_stat_t *stat);
+
+/**
+ * Categories of heap memory accounted by uORB, see orb_mem_get().
+ */
+enum orb_mem_category {
+    ORB_MEM_NODE = 0,     /**< topic node structs */
+    ORB_MEM_EVENT,        /**< rt_event objects used for blocking waits */
+    ORB_MEM_QUEUE,        /**< ring buffers, o_size * queue_size, allocated on first publish */
+    ORB_MEM_SUBSCRIPTION, /**< subscription handles */
+    ORB_MEM_CALLBACK,     /**< items allocated by orb_register_callback() */
+    ORB_MEM_GROUP,        /**< per-topic instance tables */
+    ORB_MEM_CATEGORIES
+};
+
+/**
+ * Heap usage of uORB, in bytes.
+ */
+typedef struct orb_mem_stat_s {
+    rt_size_t   current[ORB_MEM_CATEGORIES];
+    rt_size_t   peak[ORB_MEM_CATEGORIES];
+    rt_size_t   reserved;     /**< ring buffers of advertised nodes not yet published */
+    rt_size_t   total;        /**< sum of current[] */
+    rt_size_t   total_peak;   /**< highest total seen */
+    rt_size_t   budget;       /**< 0 if unlimited */
+    rt_uint32_t rejected;     /**< advertisements refused by the budget */
+} orb_mem_stat_t;
+
+/**
+ * Get the heap usage of uORB by category, with peaks.
+ *
+ * @return    RT_EOK, -RT_EINVAL if @p stat is NULL.
+ */
+int orb_mem_get(orb_mem_stat_t *stat);
+
+/**
+ * Limit the heap uORB may use.
+ *
+ * Checked when orb_advertise_multi_queue() has to create a node: if the
+ * current usage plus the reserved ring buffers plus the new node (struct,
+ * event, ring buffer and instance table) would exceed the budget, the
+ * advertisement fails with NULL and an error is logged. Existing nodes,
+ * subscriptions and publications are never refused.
+ *
+ * @param bytes   Budget in bytes, 0 for unlimited (default UORB_MEM_BUDGET).
+ * @return    RT_EOK.
+ */
+int orb_mem_set_budget(rt_size_t bytes);
+
 /**
  * Set the minimum interval between which updates are seen for a subscription.
  *
@@ -400,6 +631,100 @@ int orb_set_interval(orb_subscr_t sub, unsigned interval);
  */
 int orb_get_interval(orb_subscr_t sub, unsigned *interval);
 
+/**
+ * Set the minimum interval between which updates are seen, in microseconds.
+ *
+ * Same semantics as orb_set_interval(), but the interval is converted to the
+ * internal clock unit (CPU cycles with RT_USING_CPUTIME, otherwise ticks,
+ * rounded up) once here, so orb_check() only does a subtraction. An interval
+ * of 0 disables throttling and orb_check() skips all timing work.
+ *
+ * @param handle  A handle returned from orb_subscribe.
+ * @param interval_us  An interval period in microseconds.
+ * @return    RT_EOK on success, -RT_EINVAL on invalid handle.
+ */
+int orb_set_interval_us(orb_subscr_t sub, rt_uint32_t interval_us);
+
+/**
+ * Get the minimum interval between which updates are seen, in microseconds.
+ *
+ * @see orb_set_interval_us()
+ */
+int orb_get_interval_us(orb_subscr_t sub, rt_uint32_t *interval_us);
+
+/**
+ * Key the subscription interval on the message's own timestamp field.
+ *
+ * When enabled, an update is reported only if the latest message's
+ * "uint64 timestamp" is at least the configured interval (in microseconds)
+ * past the timestamp of the last copied message. Downsampling then follows
+ * the publisher's time base exactly and is independent of when the
+ * subscriber happens to poll. Timestamps are assumed to be microseconds.
+ * May be called before the topic is advertised; it takes effect once the
+ * subscription binds to the node.
+ *
+ * @param handle  A handle returned from orb_subscribe.
+ * @param enable  RT_TRUE to use the message timestamp, RT_FALSE for the local clock.
+ * @return    RT_EOK on success, -RT_ENOENT if the topic has no uint64 timestamp field.
+ */
+int orb_set_interval_by_timestamp(orb_subscr_t sub, rt_bool_t enable);
+
+/**
+ * Predicates for orb_set_filter(). Field values are compared as double;
+ * RISE, FALL and CHANGED compare against the field in the previous publish,
+ * and the first publish after the filter is attached has no previous value
+ * (it matches when the current value alone satisfies the condition).
+ */
+typedef enum orb_filter_op_e {
+    ORB_FILTER_EQ = 0, /**< field == value */
+    ORB_FILTER_NE,     /**< field != value */
+    ORB_FILTER_GT,     /**< field >  value */
+    ORB_FILTER_GE,     /**< field >= value */
+    ORB_FILTER_LT,     /**< field <  value */
+    ORB_FILTER_LE,     /**< field <= value */
+    ORB_FILTER_CHANGED,/**< field differs from the previous publish; value is ignored */
+    ORB_FILTER_RISE,   /**< field crosses value upwards: previous < value <= current */
+    ORB_FILTER_FALL,   /**< field crosses value downwards: previous >= value > current */
+    ORB_FILTER_BITS,   /**< integer field has any bit of the mask set; use orb_set_filter_bits() */
+} orb_filter_op_t;
+
+/**
+ * Attach a content filter to a subscription.
+ *
+ * The predicate is evaluated once per publish, in the publishing thread,
+ * on the scalar field named @p field (offset taken from the topic's
+ * o_fields). A matching message is copied into a buffer owned by the
+ * subscription and signals the subscription's own event, so orb_check(),
+ * orb_update() and orb_wait() only report, and only wake up for, matching
+ * messages; orb_copy() returns the latest matching one. The subscription
+ * interval does not apply while a filter is attached. Only publishes made
+ * in this process are filtered. Replaces any previous filter.
+ *
+ * @param handle  A handle returned from orb_subscribe.
+ * @param field   Name of a scalar numeric field of the topic.
+ * @param op      Predicate, see orb_filter_op_t.
+ * @param value   Operand of the predicate.
+ * @return    RT_EOK on success, -RT_ENOENT if the field does not exist,
+ *            -RT_EINVAL for arrays, char fields or ORB_FILTER_BITS (see
+ *            orb_set_filter_bits()), -RT_ENOMEM if the filter cannot be allocated.
+ */
+int orb_set_filter(orb_subscr_t handle, const char *field, orb_filter_op_t op, double value);
+
+/**
+ * Attach an ORB_FILTER_BITS content filter: a publish matches when the
+ * integer field @p field has any bit of @p mask set. The mask is taken as a
+ * full 64-bit integer, so flags above bit 53 are not lost to a double.
+ * Otherwise behaves like orb_set_filter().
+ *
+ * @return    RT_EOK on success, -RT_ENOENT if the field does not exist,
+ *            -RT_EINVAL for a zero mask, arrays, char or float fields,
+ *            -RT_ENOMEM if the filter cannot be allocated.
+ */
+int orb_set_filter_bits(orb_subscr_t handle, const char *field, rt_uint64_t mask);
+
+/** Detach the content filter of a subscription; the next publish is reported again. */
+int orb_clear_filter(orb_subscr_t handle);
+
 /** 订阅阻塞等待接口（雏形）：等待至更新或超时（timeout_ms<0 表示永远等待） */
 int orb_wait(orb_subscr_t handle, int timeout_ms);
 
@@ -407,6 +732,36 @@ int orb_wait(orb_subscr_t handle, int timeout_ms);
 int orb_register_callback(const struct orb_metadata *meta, uint8_t instance, void (*fn)(void));
 int orb_unregister_callback(const struct orb_metadata *meta, uint8_t instance, void (*fn)(void));
 
+/**
+ * Register a context-carrying callback on a topic instance.
+ *
+ * The callback runs in the publisher's context right after the message has
+ * been written, and receives the message itself, so consumers do not need a
+ * second orb_copy(). Registration is O(1) and allocation-free: @p cb is
+ * linked into the node directly. If the instance has not been advertised
+ * yet, its node is created so the callback fires on the first publication.
+ * A registered callback holds a subscriber reference on the node.
+ *
+ * @param meta      The uORB metadata (usually from the ORB_ID() macro).
+ * @param instance  The topic instance.
+ * @param cb        Caller-owned entry, must not already be registered.
+ * @param fn        The callback function.
+ * @param context   User pointer passed back to @p fn.
+ * @return    RT_EOK on success, -RT_EINVAL on bad arguments (including an
+ *      instance >= ORB_MULTI_MAX_INSTANCES) or if @p cb is already registered,
+ *      -RT_ENOMEM if the node could not be created.
+ */
+int orb_register_callback_ctx(const struct orb_metadata *meta, uint8_t instance, orb_callback_t *cb,
+                              orb_callback_fn_t fn, void *context);
+
+/**
+ * Unregister a callback registered with orb_register_callback_ctx(). O(1).
+ *
+ * @param cb  The entry passed at registration.
+ * @return    RT_EOK on success, -RT_EINVAL if @p cb is not registered.
+ */
+int orb_unregister_callback_ctx(orb_callback_t *cb);
+
 /**
  * Returns the C type string from a short type in o_fields metadata, or nullptr
  * if not a short type
@@ -424,6 +779,57 @@ void orb_print_message_internal(const struct orb_metadata *meta, const void *dat
 }
 #endif                            //__cplusplus
 
+#ifdef __cplusplus
+namespace uORB {
+/**
+ * Compile-time topic traits, specialized for each message struct by msggen
+ * (or by ORB_DECLARE_TRAITS() for hand-written topics):
+ *   id()       metadata pointer, same as ORB_ID(name)
+ *   name()     topic name
+ *   size       sizeof the message struct
+ *   queue      queue length a node gets by default (%queue, 1 if not given),
+ *              rounded up to a power of two (at most 128) like orb_node_create()
+ *   instances  maximum number of instances (%instances, clamped to ORB_MULTI_MAX_INSTANCES)
+ */
+template<typename T>
+struct topic_traits;
+
+namespace detail {
+/* 与 orb_node_create() 的 round_pow_of_two_8 一致：0 -> 1，向上取 2 的幂，最大 128 */
+constexpr uint8_t traits_queue_len(unsigned n, unsigned p = 1)
+{
+    return (n <= p || p == 128) ? (uint8_t)p : traits_queue_len(n, p * 2);
+}
+
+constexpr uint8_t traits_instances(unsigned n)
+{
+    return (uint8_t)((n < ORB_MULTI_MAX_INSTANCES) ? n : ORB_MULTI_MAX_INSTANCES);
+}
+} // namespace detail
+} // namespace uORB
+
+/*
+ * _size 为消息布局（.msg 字段按自然对齐）推算的结构体大小，与 sizeof 不符时编译失败，
+ * 防止结构体与元数据（o_fields 描述的布局）不一致。
+ */
+#define ORB_DECLARE_TRAITS(_name, _queue, _instances, _size)                                          \
+    namespace uORB {                                                                                  \
+    template<>                                                                                        \
+    struct topic_traits<struct _name##_s> {                                                           \
+        static constexpr orb_id_t    id() { return ORB_ID(_name); }                                   \
+        static constexpr const char *name() { return #_name; }                                        \
+        static constexpr uint16_t    size      = sizeof(struct _name##_s);                            \
+        static constexpr uint8_t     queue     = detail::traits_queue_len(_queue);                    \
+        static constexpr uint8_t     instances = detail::traits_instances(_instances);                \
+        static_assert(sizeof(struct _name##_s) == (_size), "struct " #_name "_s does not match its message layout"); \
+        static_assert((_queue) >= 1 && (_queue) <= 255, "invalid queue length");                      \
+        static_assert((_instances) >= 1, "invalid instance count");                                   \
+    };                                                                                                \
+    }
+#else
+#define ORB_DECLARE_TRAITS(_name, _queue, _instances, _size)
+#endif
+
 /* Diverse uORB header defines */ // XXX: move to better location
 typedef uint8_t arming_state_t;
 typedef uint8_t main_state_t;
@@ -0,0 +1,72 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_AGGREGATE_H__
+#define __UORB_AGGREGATE_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 窗口聚合订阅：在发布路径上对主题的数值字段增量统计 min/max/sum/count，
+ * 消费者每次读取得到自上次读取以来全部消息的摘要，而不必逐条 orb_copy。
+ * 数组字段按元素展开；名为 timestamp 的 uint64 字段不参与统计，改为记录窗口首末时间戳。
+ */
+
+typedef struct orb_aggregate_s orb_aggregate_t;
+
+/* 单个数值元素的窗口统计（double：32 位整数字段的极值精确，64 位整数在 2^53 以内精确） */
+typedef struct orb_aggregate_stat_s
+{
+    double min;
+    double max;
+    double mean;
+} orb_aggregate_stat_t;
+
+/* 窗口信息 */
+typedef struct orb_aggregate_window_s
+{
+    rt_uint32_t count;    /* 窗口内消息条数 */
+    rt_uint64_t first_ts; /* 首条消息 timestamp（主题无该字段时为 0） */
+    rt_uint64_t last_ts;  /* 末条消息 timestamp */
+} orb_aggregate_window_t;
+
+/**
+ * 创建聚合订阅（可先于公告创建）。
+ * @return 句柄；主题字段无法解析或无数值字段时返回 RT_NULL
+ */
+orb_aggregate_t *orb_aggregate_create(const struct orb_metadata *meta, uint8_t instance);
+
+/** 注销回调并释放聚合订阅 */
+int orb_aggregate_delete(orb_aggregate_t *agg);
+
+/** 统计槽个数（数值元素总数） */
+int orb_aggregate_slots(orb_aggregate_t *agg);
+
+/**
+ * 按字段名与数组下标（标量传 0）查找统计槽。
+ * @return 槽下标；-RT_ENOENT 字段不存在或不参与统计；-RT_EINVAL 下标越界
+ */
+int orb_aggregate_find(orb_aggregate_t *agg, const char *name, int element);
+
+/**
+ * 读取并清空当前窗口。
+ * @param window 可为 RT_NULL
+ * @param stats  输出前 max_slots 个槽的统计；窗口为空时不写入
+ * @return 窗口内消息条数（0 表示自上次读取以来无新消息），负值为错误
+ */
+int orb_aggregate_read(orb_aggregate_t *agg, orb_aggregate_window_t *window,
+                       orb_aggregate_stat_t *stats, int max_slots);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_AGGREGATE_H__ */
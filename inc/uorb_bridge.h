@@ -0,0 +1,122 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_BRIDGE_H__
+#define __UORB_BRIDGE_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 串口/字节流桥：把选定主题转发到伴随计算机，并把对端发来的主题在本地重新发布。
+ *
+ * 帧格式（多字节字段均为小端）：
+ *   sync[2] = A5 5A | len u16 | seq u8 | count u8 | count 条记录 | crc u16
+ *   记录：topic u16 | size u16 | generation u32 | instance u8 | payload[size]
+ * topic 为主题名的 16 位 FNV-1a 散列，两端无需共享 ORB_ID 枚举；payload 为消息前
+ * o_size_no_padding 字节。crc 为 CRC-16/CCITT（初值 0xFFFF），覆盖 len 至最后一条记录。
+ * 一帧可装入多条消息：发送线程被发布回调唤醒后（可再等一个聚合窗口），把各主题的全部
+ * 新消息（队列主题逐条）装入尽量少的帧再写出。
+ *
+ * 接收端按 topic 找到 orb_bridge_add_rx() 登记的主题，每个远端实例首次收到时用
+ * orb_advertise_multi() 公告一个本地实例，之后 orb_publish()。generation 不连续时计入
+ * lost；CRC 错误的帧丢弃并从下一个同步字重新对齐。
+ *
+ * 同一主题不能在一个桥上同时收发，以免重新发布的消息被再次发回。
+ */
+
+#ifndef UORB_BRIDGE_FRAME_MAX
+#define UORB_BRIDGE_FRAME_MAX 256 /* 单帧记录区最大字节数 */
+#endif
+
+#ifndef UORB_BRIDGE_BATCH_MS
+#define UORB_BRIDGE_BATCH_MS 0 /* 默认聚合窗口（毫秒） */
+#endif
+
+#define UORB_BRIDGE_SYNC0     0xA5
+#define UORB_BRIDGE_SYNC1     0x5A
+#define UORB_BRIDGE_HDR_SIZE  6 /* sync + len + seq + count */
+#define UORB_BRIDGE_REC_SIZE  9 /* 记录头 */
+#define UORB_BRIDGE_CRC_SIZE  2
+
+typedef struct orb_bridge_s orb_bridge_t;
+
+/* 字节流接口：write 须写完整个缓冲，返回写入字节数；read 最多等待 timeout_ms，返回读到的字节数（0 为超时） */
+typedef struct orb_bridge_io_s
+{
+    rt_ssize_t (*write)(void *ctx, const void *buf, rt_size_t len);
+    rt_ssize_t (*read)(void *ctx, void *buf, rt_size_t len, rt_int32_t timeout_ms);
+    void *ctx;
+} orb_bridge_io_t;
+
+typedef struct orb_bridge_stat_s
+{
+    rt_uint32_t tx_msgs;
+    rt_uint32_t tx_frames;
+    rt_uint32_t tx_bytes;
+    rt_uint32_t rx_msgs;
+    rt_uint32_t rx_frames;
+    rt_uint32_t rx_bytes;
+    rt_uint32_t rx_crc_errors; /* 校验失败的帧 */
+    rt_uint32_t rx_dropped;    /* 未登记主题、长度不符或公告失败而丢弃的记录 */
+    rt_uint32_t rx_lost;       /* 按 generation 推算的对端已发布而未收到的消息 */
+} orb_bridge_stat_t;
+
+/** @param max_topics 收发主题条目上限 */
+orb_bridge_t *orb_bridge_create(const orb_bridge_io_t *io, int max_topics);
+
+/** 停止线程，取消订阅与本地公告并释放 */
+int orb_bridge_delete(orb_bridge_t *bridge);
+
+/**
+ * 转发本地主题实例（须在 orb_bridge_start() 之前添加）。
+ * @return RT_EOK；-RT_EINVAL 消息放不进一帧；-RT_EBUSY 已添加或该主题已用于接收；-RT_EFULL；-RT_ENOMEM
+ */
+int orb_bridge_add_tx(orb_bridge_t *bridge, const struct orb_metadata *meta, rt_uint8_t instance);
+
+/**
+ * 接收对端的主题并在本地重新发布（须在 orb_bridge_start() 之前添加）。
+ * @return RT_EOK；-RT_EINVAL 消息放不进一帧；-RT_EBUSY 已添加、散列冲突或该主题已用于发送；-RT_EFULL
+ */
+int orb_bridge_add_rx(orb_bridge_t *bridge, const struct orb_metadata *meta);
+
+/**
+ * 发送线程被唤醒后再等 ms 毫秒才打包，使相近时刻的发布合入一帧（减少帧头与 CRC 开销，
+ * 代价是增加同样的延迟）。窗口内发布次数超过队列长度的消息会被覆盖，计入对端的 rx_lost。
+ */
+int orb_bridge_set_batch_window(orb_bridge_t *bridge, rt_uint32_t ms);
+
+/** 创建发送与接收线程 */
+int orb_bridge_start(orb_bridge_t *bridge);
+
+/** 把各发送主题的新消息打包写出（发送线程即调用此函数）；返回发送的消息数 */
+int orb_bridge_flush(orb_bridge_t *bridge);
+
+/** 解析收到的字节并发布其中完整的帧（接收线程即调用此函数）；返回发布的消息数 */
+int orb_bridge_input(orb_bridge_t *bridge, const void *data, rt_size_t len);
+
+int orb_bridge_get_stat(orb_bridge_t *bridge, orb_bridge_stat_t *stat);
+
+/** 主题在帧中的编号（主题名的 16 位 FNV-1a 散列） */
+rt_uint16_t orb_bridge_topic_id(const struct orb_metadata *meta);
+
+#ifdef RT_USING_DEVICE
+/**
+ * 以已打开的字符设备（如串口，建议 RT_DEVICE_FLAG_INT_RX 或 DMA_RX 方式打开）填充 io。
+ * 会接管设备的 rx_indicate 回调。
+ */
+int orb_bridge_io_device(orb_bridge_io_t *io, rt_device_t dev);
+#endif
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_BRIDGE_H__ */
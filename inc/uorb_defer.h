@@ -0,0 +1,73 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_DEFER_H__
+#define __UORB_DEFER_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 延迟发布：让硬实时生产者的 orb_publish() 只付出一次有界的入队。
+ *
+ * 对设置了 orb_set_publish_deferred() 的节点，orb_publish() 把（节点, 消息）拷入当前 CPU
+ * 的无锁多生产者单消费者环形队列后立即返回；投递线程（"uorb_dq"）按 CPU 轮流取出，
+ * 经过发布端限速与变化发布判断后写入环形缓冲，并在该线程中派发回调与唤醒订阅者。
+ * 生产者的耗时因此与订阅者回调无关。
+ *
+ * 入队只用原子操作（需要工具链支持 __atomic 内建函数），可在线程与中断中调用；队列满时
+ * orb_publish() 返回 -RT_EFULL 并计入 dropped。
+ *
+ * 限制：
+ *  - 消息须不超过 UORB_DEFER_SLOT_SIZE 字节；不支持共享内存节点；
+ *  - SMP 下同一发布线程在两次发布之间迁移到其他 CPU 时，两条消息可能乱序写入；
+ *  - 取消公告后尚在队列中的消息被丢弃；
+ *  - 生产者优先级应高于投递线程，否则唤醒投递线程时生产者会被抢占，耗时又包含了派发。
+ */
+
+#ifndef UORB_DEFER_QUEUE_SIZE
+#define UORB_DEFER_QUEUE_SIZE 32 /* 每个 CPU 的队列槽数（2 的幂） */
+#endif
+
+#ifndef UORB_DEFER_SLOT_SIZE
+#define UORB_DEFER_SLOT_SIZE 64 /* 单条消息上限（字节） */
+#endif
+
+#ifndef UORB_DEFER_THREAD_PRIORITY
+#define UORB_DEFER_THREAD_PRIORITY 16
+#endif
+
+#ifndef UORB_DEFER_THREAD_STACK
+#define UORB_DEFER_THREAD_STACK 2048
+#endif
+
+typedef struct orb_defer_stat_s
+{
+    rt_uint32_t enqueued;  /* 入队的消息 */
+    rt_uint32_t delivered; /* 投递线程已处理的消息（含被限速丢弃与公告取消后丢弃的） */
+    rt_uint32_t dropped;   /* 队列满被拒绝的发布 */
+    rt_uint32_t max_depth; /* 观察到的最大队列深度（单个 CPU） */
+} orb_defer_stat_t;
+
+/**
+ * 开启或关闭节点的延迟发布（线程上下文），首次开启时启动投递线程。
+ * 关闭时已入队的消息仍会被投递。
+ * @return RT_EOK；-RT_EINVAL 句柄无效或消息超过 UORB_DEFER_SLOT_SIZE；-RT_ENOSYS 共享内存节点；
+ *         -RT_ENOMEM 创建投递线程失败
+ */
+int orb_set_publish_deferred(orb_advert_t handle, rt_bool_t enable);
+
+int orb_defer_get_stat(orb_defer_stat_t *stat);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_DEFER_H__ */
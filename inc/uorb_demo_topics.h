@@ -33,4 +33,7 @@ ORB_DECLARE(sensor_demo);
 }
 #endif
 
+ORB_DECLARE_TRAITS(orb_test, 1, ORB_MULTI_MAX_INSTANCES, 16)
+ORB_DECLARE_TRAITS(sensor_demo, 1, ORB_MULTI_MAX_INSTANCES, 24)
+
 #endif /* __UORB_DEMO_TOPICS_H__ */ 
\ No newline at end of file
@@ -15,21 +15,37 @@
 extern "C" {
 #endif // __cplusplus
 
-typedef struct orb_callback_s
+/* 内容过滤（orb_set_filter）：谓词在发布线程内每次发布求值一次，匹配的消息拷入私有缓冲 */
+typedef struct orb_filter_s
 {
-    rt_list_t list;
-    void (*call)();
-} orb_callback_t;
-
+    rt_list_t                    list;             // 挂在 node->filters 上（cb_lock 保护）
+    struct orb_node_s           *node;             // 已挂入的节点，未绑定时为空
+    rt_uint16_t                  offset;           // 字段偏移
+    rt_uint8_t                   type;             // uorb_field_type_t
+    rt_uint8_t                   op;               // orb_filter_op_t
+    double                       value;
+    rt_uint64_t                  mask;             // ORB_FILTER_BITS 的位掩码
+    double                       last;             // 上一次发布的字段值（CHANGED/RISE/FALL）
+    rt_bool_t                    has_last;
+    rt_uint32_t                  matched;          // 匹配次数（数据锁内更新）
+    rt_uint32_t                  consumed;         // 订阅者已消费到的匹配次数
+    uorb_notifier_t              notifier;         // 独占通知器：只在匹配时置位
+    rt_uint8_t                   msg[];            // 最近一条匹配的消息（o_size）
+} orb_filter_t;
 
 typedef struct orb_node_s
 {
     rt_list_t                    list;
+    struct rt_spinlock           lock;             // 数据锁：保护环形缓冲、generation 与计数（短临界区）
+    struct rt_spinlock           cb_lock;          // 回调锁：保护 callbacks 链表及其派发
     const struct orb_metadata   *meta;
     rt_uint8_t                   instance;         // 实例序号
     rt_uint8_t                   queue_size;       // 栈的长度
     rt_uint32_t                  generation;       // 更新代数
     rt_list_t                    callbacks;        // 回调函数链表
+    rt_thread_t                  cb_owner;         // 正在派发回调的线程（持有 cb_lock），空表示未在派发
+    rt_list_t                   *cb_next;          // 派发游标：下一个要调用的回调，回调内注销时随之前移
+    rt_list_t                    filters;          // 内容过滤订阅（cb_lock 保护，随回调一起派发）
     rt_bool_t                    advertised;       // 是否公告
     rt_uint8_t                   subscriber_count; // 订阅者个数
     rt_bool_t                    data_valid;       // data是否有效
@@ -38,6 +54,42 @@ typedef struct orb_node_s
     rt_tick_t                    last_dev_read;
     uorb_notifier_t              notifier;         // 事件通知器（用于阻塞等待）
     rt_bool_t                    pending_delete;   // 延迟删除标记
+    /* 发布端限速/抽取：在写环形缓冲之前丢弃多余的发布 */
+    rt_list_t                    subscribers;      // 已绑定的订阅者（自动限速时取最快间隔）
+    rt_uint32_t                  pub_interval_us;  // 发布方声明的最小发布间隔（微秒），0 表示不限
+    uorb_clock_t                 pub_interval_clk; // 生效的发布间隔（预换算），0 表示不限速
+    uorb_clock_t                 last_pub;         // 上次放行发布的时刻
+    rt_uint16_t                  decimation;       // 每 N 次发布保留 1 次，0/1 表示不抽取
+    rt_uint16_t                  decim_count;
+    rt_bool_t                    auto_rate;        // 按最快订阅者间隔自动限速
+    rt_uint32_t                  suppressed;       // 被限速/抽取/变化发布丢弃的发布次数
+    /* 变化发布：内容（timestamp 除外）与最新一条相同时不推进代数 */
+    rt_bool_t                    on_change;
+    rt_int16_t                   change_ts_offset; // 比较时跳过的 timestamp 字段偏移，-1 表示无
+    uorb_clock_t                 heartbeat_clk;    // 内容不变时仍放行的最长间隔（预换算），0 表示不放行
+    uorb_clock_t                 last_accept;      // 变化发布模式下上次放行的时刻
+    rt_uint8_t                   priority;         // 实例优先级（ORB_PRIO_*），供组订阅选择
+    rt_uint32_t                  id;               // 节点序号（创建时分配、不复用），供快照跨轮次跟踪
+    /* 带宽与耗时统计（在数据锁内累加） */
+    rt_uint64_t                  bytes_published;  // 写入环形缓冲的字节数
+    rt_uint64_t                  bytes_copied;     // 从环形缓冲拷出的字节数
+    rt_uint32_t                  queue_reserved;   // 已计入预留、尚未分配的环形缓冲字节数（首次发布时转为实际占用）
+#ifdef UORB_USING_SHM
+    struct uorb_shm_topic       *shm;              // 共享内存中的主题项，非空时 data 指向共享环形缓冲
+    rt_bool_t                    shm_advertised;   // 本进程已计入共享项的公告者数
+#endif
+#ifdef UORB_USING_ISR_PUBLISH
+    rt_list_t                    isr_entry;        // 挂在下半部待派发链表上，空表示无待派发
+    rt_bool_t                    isr_ready;        // 已由 orb_prepare_isr() 预分配，可在中断中发布
+    rt_uint32_t                  isr_generation;   // 下半部已派发到的代数（node->lock 保护）
+#endif
+#ifdef UORB_USING_DEFERRED_PUBLISH
+    rt_bool_t                    deferred;         // orb_publish 只入队，由投递线程写入并派发
+#endif
+#ifdef UORB_USING_PROFILING
+    rt_uint64_t                  write_time;       // orb_node_write 累计耗时（含回调，uorb_prof_now 计数）
+    rt_uint64_t                  read_time;        // orb_node_read 累计耗时
+#endif
 } orb_node_t;
 
 
@@ -45,21 +97,85 @@ typedef struct orb_subscribe_s
 {
     const struct orb_metadata   *meta;
     rt_uint8_t                   instance;
-    rt_tick_t                    interval;
+    rt_tick_t                    interval;         // 最小更新间隔（毫秒，兼容 orb_get_interval）
     orb_node_t *node;
     rt_uint32_t generation;
-    rt_tick_t   last_update;
+    uorb_clock_t last_update;                      // 上次 orb_copy 的时刻（uorb_clock 单位）
     rt_bool_t   callback_registered;
+    rt_uint32_t  interval_us;                      // 最小更新间隔（微秒）
+    uorb_clock_t interval_clk;                     // 预换算的间隔（uorb_clock 单位），0 表示不节流
+    rt_int16_t   ts_offset;                        // 按消息 timestamp 节流时的字段偏移，-1 表示按本地时钟
+    rt_uint64_t  last_ts;                          // 上次 orb_copy 消息的 timestamp（微秒）
+    rt_list_t    node_entry;                       // 挂在 node->subscribers 上
+    orb_filter_t *filter;                          // 内容过滤，为空表示不过滤
 } orb_subscribe_t;
 
 /* Function declarations */
+/* 实例已有节点时返回已有节点（不会产生同实例的重复节点） */
 orb_node_t* orb_node_create(const struct orb_metadata* meta, const rt_uint8_t instance, rt_uint8_t queue_size);
 rt_err_t orb_node_delete(orb_node_t* node);
 orb_node_t* orb_node_find(const struct orb_metadata* meta, int instance);
+/* 已公告实例个数（O(1)） */
+int orb_node_group_count(const struct orb_metadata* meta);
+/* 已公告的最小实例节点，均未公告时为实例0节点（可能为空） */
+orb_node_t* orb_node_find_first(const struct orb_metadata* meta);
 bool orb_node_exists(const struct orb_metadata* meta, int instance);
 int orb_node_read(orb_node_t* node, void* data, rt_uint32_t* generation);
 int orb_node_write(orb_node_t* node, const void* data);
+/* orb_publish 在参数检查之后的部分：发布端限速/变化判断后写入并派发 */
+int orb_node_publish(orb_node_t* node, const void* data);
+/* 首次发布前分配环形缓冲（orb_node_write 内部也会调用）；返回 RT_EOK 或 -RT_ENOMEM */
+int orb_node_alloc(orb_node_t* node);
+/* 写入本地环形缓冲并推进代数（数据锁内，可在中断中调用），返回新代数 */
+rt_uint32_t orb_node_store(orb_node_t* node, const void* data);
+/* 派发回调与过滤、唤醒等待者（线程上下文）；data 为本次消息内容 */
+void orb_node_deliver(orb_node_t* node, const void* data, rt_uint32_t generation);
 bool orb_node_ready(orb_subscribe_t* handle);
+int orb_node_peek_u64(orb_node_t* node, rt_uint16_t offset, rt_uint64_t* value);
+int orb_node_peek_next_u64(orb_node_t* node, rt_uint32_t* generation, rt_uint16_t offset, rt_uint64_t* value);
+/* 订阅者间隔或消费者集合变化后重新计算发布端生效间隔 */
+void orb_node_refresh_rate(orb_node_t* node);
+/* 按订阅者游标选择要读取的消息序号（槽位为序号 % queue_size），*next 为读取后的游标 */
+rt_uint32_t orb_node_select(rt_uint32_t current, rt_uint32_t cursor, rt_uint8_t queue_size, rt_uint32_t* next);
+
+#ifdef UORB_USING_SHM
+/* 共享内存传输（uorb_shm.c） */
+void        uorb_shm_bind(orb_node_t* node);
+orb_node_t* uorb_shm_lookup(const struct orb_metadata* meta, int instance);
+void        uorb_shm_sync(orb_node_t* node);
+void        uorb_shm_advertise(orb_node_t* node, rt_bool_t advertised);
+rt_uint32_t uorb_shm_write(orb_node_t* node, const void* data);
+rt_uint32_t uorb_shm_read_locked(orb_node_t* node, void* data, rt_uint32_t cursor, rt_uint32_t* next);
+void        uorb_shm_wait(orb_node_t* node, rt_uint32_t seen, rt_int32_t timeout_ms);
+#define orb_node_is_shm(node) ((node)->shm != RT_NULL)
+#define ORB_NODE_SYNC(node)        \
+    do                             \
+    {                              \
+        if ((node)->shm)           \
+        {                          \
+            uorb_shm_sync(node);   \
+        }                          \
+    } while (0)
+#else
+#define orb_node_is_shm(node) 0
+#define ORB_NODE_SYNC(node)   ((void)0)
+#endif
+
+#ifdef UORB_USING_ISR_PUBLISH
+/* 中断发布（uorb_isr.c）：删除节点前移出待派发链表并等待下半部处理完 */
+void uorb_isr_forget(orb_node_t* node);
+#endif
+
+#ifdef UORB_USING_DEFERRED_PUBLISH
+/* 延迟发布（uorb_defer.c） */
+int  uorb_defer_enqueue(orb_node_t* node, const void* data);
+/* 删除节点前等待投递线程处理完已入队的消息 */
+void uorb_defer_forget(orb_node_t* node);
+#endif
+
+/* 注册表锁：保护节点链表（查找/创建/删除/遍历），与节点数据锁相互独立 */
+void orb_registry_lock(void);
+void orb_registry_unlock(void);
 
 #ifdef __cplusplus
 }
@@ -0,0 +1,86 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_FIELDS_H__
+#define __UORB_FIELDS_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/* 字段基础类型（由 o_fields 中的类型名解析得到） */
+typedef enum
+{
+    UORB_FIELD_INT8 = 0,
+    UORB_FIELD_UINT8,
+    UORB_FIELD_INT16,
+    UORB_FIELD_UINT16,
+    UORB_FIELD_INT32,
+    UORB_FIELD_UINT32,
+    UORB_FIELD_INT64,
+    UORB_FIELD_UINT64,
+    UORB_FIELD_FLOAT,
+    UORB_FIELD_DOUBLE,
+    UORB_FIELD_BOOL,
+    UORB_FIELD_CHAR,
+} uorb_field_type_t;
+
+/* 字段描述：偏移按自然对齐规则由字段顺序推导（与 msggen 生成的结构体一致） */
+typedef struct uorb_field_desc_s
+{
+    const char  *name;      /* 指向 o_fields 内部，非 '\0' 结尾，长度见 name_len */
+    rt_uint8_t   name_len;
+    rt_uint8_t   type;      /* uorb_field_type_t */
+    rt_uint8_t   type_size; /* 单个元素字节数 */
+    rt_uint16_t  offset;    /* 在消息结构体中的字节偏移 */
+    rt_uint16_t  count;     /* 元素个数（标量为1，多维数组按总数展开） */
+} uorb_field_desc_t;
+
+/**
+ * 解析 meta->o_fields 为字段描述数组。
+ * 支持 "uint64 timestamp;"、"uint64_t timestamp;"、"int32[3] v;"、"float m[3][3];"，
+ * 忽略 "@queue=4;" 等元标签。
+ *
+ * @return 字段个数（可能大于 max_fields，此时只填充前 max_fields 项），
+ *         -RT_EINVAL 参数错误，-RT_ENOSYS 遇到无法识别的类型（如嵌套结构体），
+ *         -RT_ERROR 推导出的布局超出 o_size。
+ */
+int uorb_fields_parse(const struct orb_metadata *meta, uorb_field_desc_t *out, int max_fields);
+
+/**
+ * 按名字查找字段。
+ * @return RT_EOK 找到；-RT_ENOENT 未找到；其他负值同 uorb_fields_parse()。
+ */
+int uorb_fields_find(const struct orb_metadata *meta, const char *name, uorb_field_desc_t *out);
+
+/**
+ * 取主题的字段布局：首次调用时解析并缓存，之后直接返回缓存（只读，常驻）。
+ * @param count 输出字段个数；失败时为 uorb_fields_parse() 的错误码
+ * @return 字段描述数组；失败返回 RT_NULL
+ */
+const uorb_field_desc_t *uorb_fields_layout(const struct orb_metadata *meta, int *count);
+
+/** 字段类型名（"uint64" 等），用于打印 */
+const char *uorb_field_type_name(rt_uint8_t type);
+
+/** 以 double 读取 p 处的单个元素（p 无需对齐）；char 与未知类型返回 0 */
+double uorb_field_value(const void *p, rt_uint8_t type);
+
+/**
+ * 将 p 处的单个元素格式化为文本（listener 打印所用格式）：64 位整数完整输出，
+ * 浮点为定点 4 位小数，绝对值不小于 1e18 时输出 "inf"/"-inf"。
+ * @return 写入的字符数（不含 '\0'）
+ */
+int uorb_field_format(const void *p, rt_uint8_t type, char *buf, int size);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_FIELDS_H__ */
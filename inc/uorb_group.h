@@ -0,0 +1,72 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_GROUP_H__
+#define __UORB_GROUP_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 多实例组订阅：一次订阅主题的全部实例（冗余传感器等），之后公告的实例自动绑定。
+ * orb_group_updated() 一次调用得到所有实例的更新位图；orb_group_update() 按选择策略
+ * 取出其中一个实例的数据。
+ */
+
+typedef struct orb_sub_group_s orb_sub_group_t;
+
+typedef enum
+{
+    ORB_GROUP_NEWEST = 0, /* 最新的消息 timestamp（主题无 timestamp 时取最近更新的实例） */
+    ORB_GROUP_PRIORITY,   /* 发布优先级最高者（orb_set_priority），同优先级取实例号小者 */
+    ORB_GROUP_FAILOVER,   /* 保持当前实例直到其取消公告或超时，再切换到优先级最高的健康实例 */
+} orb_group_policy_t;
+
+/** 订阅主题的全部实例（可先于公告调用） */
+orb_sub_group_t *orb_subscribe_group(const struct orb_metadata *meta);
+
+int orb_unsubscribe_group(orb_sub_group_t *group);
+
+/**
+ * 设置选择策略。
+ * @param timeout_us 大于 0 时，超过该时间未更新的实例视为失效，不参与选择（FAILOVER 据此切换）
+ */
+int orb_group_set_policy(orb_sub_group_t *group, orb_group_policy_t policy, rt_uint32_t timeout_us);
+
+/**
+ * 自上次 orb_group_updated()/orb_group_update() 以来有新发布的实例位图（bit i 对应实例 i），
+ * 0 表示均无更新。不推进各实例订阅的读取位置。
+ */
+rt_uint32_t orb_group_updated(orb_sub_group_t *group);
+
+/** 按策略选出的实例号；无可用实例返回 -RT_ENOENT */
+int orb_group_select(orb_sub_group_t *group);
+
+/**
+ * 读取选中实例的新数据。选中实例发生切换时立即输出新实例的最新一条。
+ * @param instance 可为 RT_NULL，输出数据所属实例
+ * @return 拷贝字节数；0 表示选中实例无更新或无可用实例；负值为错误
+ */
+int orb_group_update(orb_sub_group_t *group, void *buffer, int *instance);
+
+/**
+ * 读取某实例的最新一条消息，不推进该实例订阅的读取位置，不影响 orb_group_update() 的输出。
+ * @return 拷贝字节数；0 表示该实例未公告或尚无数据；负值为错误
+ */
+int orb_group_copy(orb_sub_group_t *group, int instance, void *buffer);
+
+/** 某实例的底层订阅句柄（由组持有，不可 orb_unsubscribe） */
+orb_subscr_t orb_group_handle(orb_sub_group_t *group, int instance);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_GROUP_H__ */
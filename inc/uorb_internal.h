@@ -42,6 +42,35 @@ void uorb_notifier_notify(uorb_notifier_t *notifier);
 /* 全局/列表级别的内部锁（用于节点列表、全局资源） */
 uorb_lock_t *uorb_get_global_lock(void);
 
+/* 高分辨率单调时钟：启用 RT_USING_CPUTIME 时为 cputime 计数（周期级），否则退化为系统节拍。
+ * 差值运算需按无符号回绕处理；间隔应在设置阶段用 uorb_clock_from_us() 预先换算。 */
+#ifdef RT_USING_CPUTIME
+typedef rt_uint64_t uorb_clock_t;
+#else
+typedef rt_tick_t   uorb_clock_t;
+#endif
+
+uorb_clock_t uorb_clock_now(void);
+uorb_clock_t uorb_clock_from_us(rt_uint32_t us);
+
+/* 耗时统计时钟（UORB_USING_PROFILING）：宿主机构建（RT-Thread 模拟器）用 clock_gettime，
+ * 目标板启用 RT_USING_CPUTIME 时用 cputime 计数（Cortex-M 上即 DWT CYCCNT），否则退化为系统节拍。
+ * 累加原始计数，只在读取统计时换算为微秒。 */
+rt_uint64_t  uorb_prof_now(void);
+rt_uint64_t  uorb_prof_to_us(rt_uint64_t counts);
+/* 自 t0（uorb_prof_now() 的返回值）以来的计数，按计数器位宽回绕求差。
+ * cputime 常由 32 位计数器扩展而来（DWT CYCCNT），直接相减在回绕时会得到约 2^64 */
+rt_uint64_t  uorb_prof_since(rt_uint64_t t0);
+
+/* 每 CPU 数据：rt_hw_cpu_id() 只有 SMP 移植提供，单核配置也未必定义 RT_CPUS_NR */
+#ifdef RT_USING_SMP
+#define UORB_CPUS_NR  RT_CPUS_NR
+#define uorb_cpu_id() rt_hw_cpu_id()
+#else
+#define UORB_CPUS_NR  1
+#define uorb_cpu_id() 0
+#endif
+
 /* 时间与工具函数 */
 rt_tick_t    uorb_tick_now(void);
 rt_uint32_t  uorb_tick_from_ms(rt_uint32_t ms);
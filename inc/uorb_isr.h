@@ -0,0 +1,63 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_ISR_H__
+#define __UORB_ISR_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 中断上下文发布（如 DMA 完成中断里直接发布采样）。
+ *
+ * orb_publish() 首次发布时会 rt_calloc() 环形缓冲，并在发布线程内派发任意回调，
+ * 不能在中断中调用。orb_publish_isr() 只做两件事：关中断持节点数据锁，拷贝一个槽并
+ * 推进 generation；再把节点挂到下半部待派发链表并释放信号量。回调、内容过滤与等待者
+ * 唤醒由下半部线程（"uorb_bh"）完成。
+ *
+ * 约束：
+ *  - 节点须已公告，并在线程上下文中用 orb_prepare_isr() 预先分配环形缓冲；
+ *  - 下半部按代数逐条派发环形缓冲中尚未派发的消息，回调与过滤看到每一条；下半部
+ *    落后超过队列深度时，被覆盖的消息不再派发并计入丢失数（orb_isr_get_stat()）；
+ *  - 同一节点不要混用 orb_publish() 与 orb_publish_isr()：线程发布已自行派发，
+ *    下半部会再派发一次；
+ *  - 不经过发布端限速、抽取与变化发布判断；共享内存节点不支持；
+ *  - 取消公告前应先关闭中断源，取消公告会等待下半部处理完该节点。
+ */
+
+#ifndef UORB_ISR_THREAD_PRIORITY
+#define UORB_ISR_THREAD_PRIORITY 8
+#endif
+
+#ifndef UORB_ISR_THREAD_STACK
+#define UORB_ISR_THREAD_STACK 2048
+#endif
+
+/**
+ * 为中断发布做准备（线程上下文）：分配环形缓冲，必要时启动下半部线程。
+ * @return RT_EOK；-RT_EINVAL 句柄无效；-RT_ENOSYS 共享内存节点；-RT_ENOMEM 分配或创建线程失败
+ */
+int orb_prepare_isr(orb_advert_t handle);
+
+/**
+ * 在中断（或任意）上下文发布；不分配内存、不调用回调、不阻塞。
+ * @param meta 可为 RT_NULL；非空时须与句柄一致
+ * @return RT_EOK；-RT_EINVAL 参数无效或未公告；-RT_EBUSY 未调用 orb_prepare_isr()
+ */
+int orb_publish_isr(const struct orb_metadata *meta, orb_advert_t handle, const void *data);
+
+/** 下半部已派发给回调的消息数，与派发前已被环形缓冲覆盖而丢失的消息数 */
+int orb_isr_get_stat(rt_uint32_t *delivered, rt_uint32_t *dropped);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_ISR_H__ */
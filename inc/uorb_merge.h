@@ -0,0 +1,65 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_MERGE_H__
+#define __UORB_MERGE_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 按 timestamp 归并：为每个源（主题 + 实例）保存一个游标，直接在节点的环形队列上
+ * 查看下一条消息的 timestamp，用小顶堆按全局升序依次输出。只有选中的一条被拷贝到
+ * 调用方缓冲，其余消息原地留在队列中。
+ *
+ * 保序：某个源暂无未读消息时，比它最近一条 timestamp 更新的消息要等它跟上才输出；
+ * 还没有任何消息的源同样阻塞（含尚未公告的源）。源超过 stall 超时没有新消息、
+ * 或输出过消息后取消公告时视为停滞，不再阻塞其他源。
+ * 回放日志时只要按原 timestamp 重新发布，归并结果与实时运行一致。
+ */
+
+#ifndef UORB_MERGE_STALL_US
+#define UORB_MERGE_STALL_US 100000 /* 默认 stall 超时（微秒） */
+#endif
+
+typedef struct orb_merge_s orb_merge_t;
+
+/** @param max_sources 源个数上限 */
+orb_merge_t *orb_merge_create(int max_sources);
+
+int orb_merge_delete(orb_merge_t *merge);
+
+/**
+ * 添加源（可先于公告），主题须含 uint64 timestamp。
+ * 节点已有的消息不输出，从添加之后的发布开始归并；队列深度决定源可以落后多少条。
+ * @return 源序号（>= 0）；-RT_EINVAL 主题无 timestamp；-RT_EFULL 源已满；-RT_ENOMEM
+ */
+int orb_merge_add(orb_merge_t *merge, const struct orb_metadata *meta, uint8_t instance);
+
+/** 源超过 timeout_us 没有新消息即视为停滞（默认 UORB_MERGE_STALL_US；0 表示不等待没有未读消息的源） */
+int orb_merge_set_stall_timeout(orb_merge_t *merge, rt_uint32_t timeout_us);
+
+/**
+ * 取出全局 timestamp 最小的一条。
+ * @param buffer 至少为该源消息大小
+ * @param size   buffer 大小
+ * @param source 输出源序号，可为 RT_NULL
+ * @return 消息大小；0 表示当前没有可按序输出的消息；负值为错误
+ */
+int orb_merge_next(orb_merge_t *merge, void *buffer, rt_size_t size, int *source);
+
+/** 源因队列覆盖而丢失的消息数 */
+rt_uint32_t orb_merge_lost(orb_merge_t *merge, int source);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_MERGE_H__ */
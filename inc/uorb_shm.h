@@ -0,0 +1,51 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_SHM_H__
+#define __UORB_SHM_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 共享内存传输（仅 Linux 宿主机构建，如 RT-Thread simulator 进程间做 SITL）。
+ *
+ * 连接 POSIX 共享内存段后，本进程之后创建的节点按（主题名, 实例）绑定到段内的共享主题项：
+ * 环形缓冲与代数都放在段中，写入与 orb_node_write 相同的代数协议，外加每主题一个顺序锁，
+ * 读端在 orb_copy() 中直接从共享环形缓冲拷贝到调用方缓冲，与本地读取一样只有一次拷贝。
+ * orb_wait() 在共享代数上用 futex 等待，任一进程的发布都能唤醒。
+ *
+ * 限制：
+ *  - 回调（orb_register_callback*）只在发布所在进程派发；
+ *  - 实例号由各进程自行分配，跨进程发布同一主题时应使用固定实例（orb_advertise_multi 的
+ *    实例位图只反映本进程）；
+ *  - 共享主题项与环形缓冲在段的生命周期内不回收，队列长度以首个创建者为准。
+ */
+
+/**
+ * 连接（不存在则创建）共享内存段。须在创建需共享的节点之前调用。
+ * @param name POSIX 共享内存名，如 "/uorb"
+ * @param size 段大小（字节），创建时生效
+ * @return RT_EOK；-RT_EBUSY 已连接；-RT_ERROR 打开/映射失败或段格式不符
+ */
+int orb_shm_attach(const char *name, rt_size_t size);
+
+/** 断开共享内存段；已绑定的节点须先全部取消公告与订阅 */
+void orb_shm_detach(void);
+
+/** 删除共享内存段名（已连接的进程不受影响） */
+int orb_shm_unlink(const char *name);
+
+rt_bool_t orb_shm_attached(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_SHM_H__ */
@@ -0,0 +1,92 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_TRACE_H__
+#define __UORB_TRACE_H__
+
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 事件跟踪：在发布、拷贝、等待与唤醒处记录定长二进制记录，写入每 CPU 一个的环形缓冲。
+ * 记录时只关本地中断、不取任何锁；缓冲写满后覆盖最旧的记录。
+ * 未启用 UORB_USING_TRACE 时 UORB_TRACE 展开为空，没有任何开销；启用后默认停止，
+ * 由 uorb_trace_start() 或 "uorb trace start" 开启。
+ * "uorb trace dump" 以文本输出记录，tools/uorb_trace2json.py 将其转换为 Chrome trace / Perfetto JSON。
+ */
+
+#ifndef UORB_TRACE_BUF_SIZE
+#define UORB_TRACE_BUF_SIZE 512 /* 每 CPU 记录条数，须为 2 的幂 */
+#endif
+
+enum uorb_trace_event
+{
+    UORB_TRACE_PUBLISH = 1, /* 消息已写入队列，generation 为写入后的代数 */
+    UORB_TRACE_NOTIFY,      /* 回调派发与唤醒完成，发布结束 */
+    UORB_TRACE_COPY,        /* 拷出一条消息，generation 为读到的代数 */
+    UORB_TRACE_WAIT,        /* orb_wait 开始阻塞 */
+    UORB_TRACE_WAKE,        /* orb_wait 返回，generation 为此刻节点代数 */
+};
+
+#define UORB_TRACE_FLAG_ISR 0x01 /* 在中断上下文中记录，thread 无意义 */
+
+/* 定长记录（24 字节） */
+typedef struct uorb_trace_rec_s
+{
+    rt_uint64_t timestamp;  /* uorb_prof_now() 计数，按计数器回绕扩展为单调 64 位值 */
+    rt_uint32_t node_id;    /* orb_node_stat_t.id */
+    rt_uint32_t generation;
+    rt_uint32_t thread;     /* 记录线程控制块地址的低 32 位 */
+    rt_uint8_t  event;      /* enum uorb_trace_event */
+    rt_uint8_t  cpu;
+    rt_uint8_t  flags;
+    rt_uint8_t  reserved;
+} uorb_trace_rec_t;
+
+#ifdef UORB_USING_TRACE
+extern volatile rt_bool_t g_uorb_trace_on;
+void uorb_trace_record(rt_uint8_t event, rt_uint32_t node_id, rt_uint32_t generation);
+/* 停止状态下只多一次标志判断 */
+#define UORB_TRACE(event, node_id, generation)                       \
+    do                                                               \
+    {                                                                \
+        if (g_uorb_trace_on)                                         \
+        {                                                            \
+            uorb_trace_record((event), (node_id), (generation));     \
+        }                                                            \
+    } while (0)
+#else
+/* 只引用 generation 以免未使用变量告警，不生成代码 */
+#define UORB_TRACE(event, node_id, generation) \
+    do                                         \
+    {                                          \
+        (void)(generation);                    \
+    } while (0)
+#endif
+
+void uorb_trace_start(void);
+void uorb_trace_stop(void);
+/** 清空全部 CPU 的缓冲（应在停止状态下调用） */
+void uorb_trace_clear(void);
+
+/**
+ * 按时间先后拷出某个 CPU 缓冲中的记录（应在停止状态下调用）。
+ * @param lost 输出被覆盖的记录数，可为 RT_NULL
+ * @return 拷出的条数（最多 max，取最新的 max 条）；cpu 越界返回 -RT_EINVAL
+ */
+int uorb_trace_copy(int cpu, uorb_trace_rec_t *out, int max, rt_uint32_t *lost);
+
+/** 停止跟踪并以文本输出全部记录与节点表，供 tools/uorb_trace2json.py 转换 */
+void uorb_trace_dump(void);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_TRACE_H__ */
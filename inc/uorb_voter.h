@@ -0,0 +1,91 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#ifndef __UORB_VOTER_H__
+#define __UORB_VOTER_H__
+
+#include "uORB.h"
+#include <rtthread.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
+
+/*
+ * 冗余表决：在多实例主题的各实例节点上注册回调，在发布路径上为每个实例评分
+ * （新鲜度、timestamp 单调性、数值卡死、相对其他实例的离群、发布优先级），
+ * 并把选中实例的消息直接转发为输出主题——每条被选中的消息只多一次拷贝，
+ * 不经过订阅轮询，也不额外占用线程。
+ *
+ * 选择规则：只在健康实例中选；优先级高者优先，其次累计错误少者，再次实例号小者。
+ * 当前实例保持健康时只会被优先级更高的健康实例取代（避免来回切换）。
+ *
+ * 只挂接已存在的实例节点；之后才公告的实例由 orb_voter_update()（orb_voter_selected() 也会调用）补挂。
+ */
+
+#ifndef UORB_VOTER_TIMEOUT_US
+#define UORB_VOTER_TIMEOUT_US 100000 /* 默认失效超时（微秒） */
+#endif
+
+typedef struct orb_voter_s orb_voter_t;
+
+/* 单个实例的健康状态位 */
+#define ORB_VOTER_STALE    0x01 /* 超时未更新 */
+#define ORB_VOTER_STUCK    0x02 /* 连续多条消息内容不变 */
+#define ORB_VOTER_OUTLIER  0x04 /* 表决字段偏离各实例中位数 */
+#define ORB_VOTER_TS_ERROR 0x08 /* timestamp 未递增 */
+
+typedef struct orb_voter_status_s
+{
+    rt_uint8_t  flags;    /* ORB_VOTER_* 组合，0 表示健康 */
+    rt_uint8_t  priority; /* 发布方优先级（orb_set_priority） */
+    rt_uint32_t errors;   /* 累计进入故障状态的次数 */
+    rt_uint32_t count;    /* 收到的消息数 */
+} orb_voter_status_t;
+
+/**
+ * 创建表决器，挂接 meta 已存在的实例；可先于各实例公告，之后出现的实例由 orb_voter_update() 补挂。
+ * @param meta      输入主题
+ * @param out_meta  输出主题，消息大小须与输入主题相同；创建时即公告
+ * @param instances 参与表决的实例数（0 表示 ORB_MULTI_MAX_INSTANCES）
+ */
+orb_voter_t *orb_voter_create(const struct orb_metadata *meta, const struct orb_metadata *out_meta, int instances);
+
+/** 注销回调、取消输出主题公告并释放 */
+int orb_voter_delete(orb_voter_t *voter);
+
+/** 超过 timeout_us 未更新的实例视为失效（默认 UORB_VOTER_TIMEOUT_US；0 关闭） */
+int orb_voter_set_timeout(orb_voter_t *voter, rt_uint32_t timeout_us);
+
+/** 连续 count 条消息（不计 timestamp）完全相同视为卡死（0 关闭，默认关闭） */
+int orb_voter_set_stuck_limit(orb_voter_t *voter, rt_uint16_t count);
+
+/**
+ * 按数值字段做离群检测：与各实例（至少三个，含自身）最新值的中位数之差超过 threshold 即视为离群。
+ * @param field 字段名（数组取第 0 个元素）；RT_NULL 关闭
+ * @return RT_EOK；-RT_ENOENT 字段不存在或非数值
+ */
+int orb_voter_set_outlier(orb_voter_t *voter, const char *field, float threshold);
+
+/**
+ * 挂接新出现的实例，并按时间重新选择（选中实例超时且无发布触发切换时使用）。
+ * 在线程上下文调用，不可在发布回调中调用。
+ */
+int orb_voter_update(orb_voter_t *voter);
+
+/** 先执行 orb_voter_update()，再返回当前选中实例；尚无可用实例返回 -RT_ENOENT */
+int orb_voter_selected(orb_voter_t *voter);
+
+/** 选中实例发生切换的次数（不计首次选中） */
+rt_uint32_t orb_voter_failovers(orb_voter_t *voter);
+
+int orb_voter_status(orb_voter_t *voter, int instance, orb_voter_status_t *status);
+
+#ifdef __cplusplus
+}
+#endif
+
+#endif /* __UORB_VOTER_H__ */
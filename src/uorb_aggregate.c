@@ -0,0 +1,258 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_aggregate.h"
+#include "uorb_fields.h"
+#include <rtthread.h>
+#include <string.h>
+
+struct agg_slot
+{
+    rt_uint16_t offset;
+    rt_uint8_t  type;
+};
+
+struct agg_field
+{
+    const char *name;
+    rt_uint8_t  name_len;
+    rt_uint16_t first_slot;
+    rt_uint16_t count;
+};
+
+/* 累加器：均以 double 保存，32 位整数字段（计数、ID、微秒值）的极值保持精确，sum 在长窗口下不丢精度 */
+struct agg_acc
+{
+    double min;
+    double max;
+    double sum;
+};
+
+struct orb_aggregate_s
+{
+    orb_callback_t     cb;
+    struct rt_spinlock lock;
+    rt_int32_t         ts_offset; /* -1 表示主题无 timestamp */
+    rt_uint32_t        count;
+    rt_uint64_t        first_ts;
+    rt_uint64_t        last_ts;
+    int                nfields;
+    int                nslots;
+    struct agg_acc    *acc;
+    struct agg_field  *fields;
+    struct agg_slot   *slots;
+};
+
+static rt_bool_t agg_is_timestamp(const uorb_field_desc_t *f)
+{
+    return f->type == UORB_FIELD_UINT64 && f->count == 1 && f->name_len == 9 &&
+           rt_strncmp(f->name, "timestamp", 9) == 0;
+}
+
+/*
+ * 发布路径：每条消息 O(槽数) 的增量更新。
+ * 回调在线程上下文中运行（中断里发布走 orb_publish_isr 的下半部），同一节点的发布已由 cb_lock 串行，
+ * 这里的锁只与 orb_aggregate_read 互斥，因此不关中断，逐槽运算不会拉长关中断窗口。
+ */
+static void agg_on_publish(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    orb_aggregate_t  *agg = (orb_aggregate_t *)context;
+    const rt_uint8_t *msg = (const rt_uint8_t *)data;
+    (void)meta;
+    (void)instance;
+
+    rt_spin_lock(&agg->lock);
+    rt_bool_t first = (agg->count == 0);
+    for (int i = 0; i < agg->nslots; i++)
+    {
+        double          v = uorb_field_value(msg + agg->slots[i].offset, agg->slots[i].type);
+        struct agg_acc *a = &agg->acc[i];
+        if (first)
+        {
+            a->min = a->max = v;
+            a->sum = v;
+        }
+        else
+        {
+            if (v < a->min) a->min = v;
+            if (v > a->max) a->max = v;
+            a->sum += v;
+        }
+    }
+    if (agg->ts_offset >= 0)
+    {
+        rt_uint64_t ts;
+        rt_memcpy(&ts, msg + agg->ts_offset, sizeof(ts));
+        if (first)
+        {
+            agg->first_ts = ts;
+        }
+        agg->last_ts = ts;
+    }
+    agg->count++;
+    rt_spin_unlock(&agg->lock);
+}
+
+orb_aggregate_t *orb_aggregate_create(const struct orb_metadata *meta, uint8_t instance)
+{
+    if (!meta)
+    {
+        return RT_NULL;
+    }
+
+    int nf = uorb_fields_parse(meta, RT_NULL, 0);
+    if (nf <= 0)
+    {
+        return RT_NULL;
+    }
+    uorb_field_desc_t *desc = rt_malloc(sizeof(uorb_field_desc_t) * nf);
+    if (!desc)
+    {
+        return RT_NULL;
+    }
+    uorb_fields_parse(meta, desc, nf);
+
+    /* 统计参与聚合的字段与元素数 */
+    int       nfields = 0, nslots = 0;
+    rt_int32_t ts_offset = -1;
+    for (int i = 0; i < nf; i++)
+    {
+        if (agg_is_timestamp(&desc[i]))
+        {
+            ts_offset = desc[i].offset;
+            continue;
+        }
+        if (desc[i].type == UORB_FIELD_CHAR)
+        {
+            continue;
+        }
+        nfields++;
+        nslots += desc[i].count;
+    }
+    if (nslots == 0)
+    {
+        rt_free(desc);
+        return RT_NULL;
+    }
+
+    /* 单次分配：句柄 + 累加器 + 字段表 + 槽表 */
+    rt_size_t size = sizeof(orb_aggregate_t) + sizeof(struct agg_acc) * nslots +
+                     sizeof(struct agg_field) * nfields + sizeof(struct agg_slot) * nslots;
+    orb_aggregate_t *agg = rt_calloc(1, size);
+    if (!agg)
+    {
+        rt_free(desc);
+        return RT_NULL;
+    }
+    agg->acc       = (struct agg_acc *)(agg + 1);
+    agg->fields    = (struct agg_field *)(agg->acc + nslots);
+    agg->slots     = (struct agg_slot *)(agg->fields + nfields);
+    agg->nfields   = nfields;
+    agg->nslots    = nslots;
+    agg->ts_offset = ts_offset;
+    rt_spin_lock_init(&agg->lock);
+
+    int fi = 0, si = 0;
+    for (int i = 0; i < nf; i++)
+    {
+        if (agg_is_timestamp(&desc[i]) || desc[i].type == UORB_FIELD_CHAR)
+        {
+            continue;
+        }
+        agg->fields[fi].name       = desc[i].name;
+        agg->fields[fi].name_len   = desc[i].name_len;
+        agg->fields[fi].first_slot = (rt_uint16_t)si;
+        agg->fields[fi].count      = desc[i].count;
+        for (int e = 0; e < desc[i].count; e++)
+        {
+            agg->slots[si].offset = (rt_uint16_t)(desc[i].offset + e * desc[i].type_size);
+            agg->slots[si].type   = desc[i].type;
+            si++;
+        }
+        fi++;
+    }
+    rt_free(desc);
+
+    if (orb_register_callback_ctx(meta, instance, &agg->cb, agg_on_publish, agg) != RT_EOK)
+    {
+        rt_free(agg);
+        return RT_NULL;
+    }
+
+    return agg;
+}
+
+int orb_aggregate_delete(orb_aggregate_t *agg)
+{
+    if (!agg)
+    {
+        return -RT_EINVAL;
+    }
+    orb_unregister_callback_ctx(&agg->cb);
+    rt_free(agg);
+    return RT_EOK;
+}
+
+int orb_aggregate_slots(orb_aggregate_t *agg)
+{
+    return agg ? agg->nslots : -RT_EINVAL;
+}
+
+int orb_aggregate_find(orb_aggregate_t *agg, const char *name, int element)
+{
+    if (!agg || !name)
+    {
+        return -RT_EINVAL;
+    }
+    rt_size_t len = rt_strlen(name);
+    for (int i = 0; i < agg->nfields; i++)
+    {
+        if (agg->fields[i].name_len == len && rt_strncmp(agg->fields[i].name, name, len) == 0)
+        {
+            if (element < 0 || element >= agg->fields[i].count)
+            {
+                return -RT_EINVAL;
+            }
+            return agg->fields[i].first_slot + element;
+        }
+    }
+    return -RT_ENOENT;
+}
+
+int orb_aggregate_read(orb_aggregate_t *agg, orb_aggregate_window_t *window,
+                       orb_aggregate_stat_t *stats, int max_slots)
+{
+    if (!agg || (max_slots > 0 && !stats))
+    {
+        return -RT_EINVAL;
+    }
+    if (max_slots > agg->nslots)
+    {
+        max_slots = agg->nslots;
+    }
+
+    rt_spin_lock(&agg->lock);
+    rt_uint32_t count = agg->count;
+    if (count > 0)
+    {
+        for (int i = 0; i < max_slots; i++)
+        {
+            stats[i].min  = agg->acc[i].min;
+            stats[i].max  = agg->acc[i].max;
+            stats[i].mean = agg->acc[i].sum / count;
+        }
+    }
+    if (window)
+    {
+        window->count    = count;
+        window->first_ts = count ? agg->first_ts : 0;
+        window->last_ts  = count ? agg->last_ts : 0;
+    }
+    agg->count = 0;
+    rt_spin_unlock(&agg->lock);
+
+    return (int)count;
+}
@@ -0,0 +1,660 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_bridge.h"
+#include "uorb_device_node.h"
+#include <rtthread.h>
+
+#ifndef UORB_BRIDGE_THREAD_STACK
+#define UORB_BRIDGE_THREAD_STACK 2048
+#endif
+#ifndef UORB_BRIDGE_THREAD_PRIORITY
+#define UORB_BRIDGE_THREAD_PRIORITY 12
+#endif
+
+#define BRIDGE_EV_TX   0x01
+#define BRIDGE_EV_STOP 0x02
+#define BRIDGE_BUF_SIZE (UORB_BRIDGE_HDR_SIZE + UORB_BRIDGE_FRAME_MAX + UORB_BRIDGE_CRC_SIZE)
+
+struct bridge_tx
+{
+    const struct orb_metadata *meta;
+    orb_subscribe_t           *sub;
+    orb_callback_t             cb;       /* 发布时唤醒发送线程 */
+    rt_uint16_t                id;
+    rt_uint8_t                 instance;
+};
+
+struct bridge_rx
+{
+    const struct orb_metadata *meta;
+    rt_uint16_t                id;
+    orb_advert_t               adv[ORB_MULTI_MAX_INSTANCES];      /* 按远端实例号，首次收到时公告 */
+    rt_uint32_t                last_gen[ORB_MULTI_MAX_INSTANCES]; /* 远端最近的 generation，0 表示尚未收到 */
+};
+
+struct orb_bridge_s
+{
+    orb_bridge_io_t    io;
+    int                max_topics;
+    int                tx_count;
+    int                rx_count;
+    struct bridge_tx  *tx;
+    struct bridge_rx  *rx;
+    rt_event_t         event;
+    rt_sem_t           done;
+    int                threads;  /* 已启动的线程数 */
+    volatile rt_bool_t stop;
+    rt_uint32_t        batch_ms;
+    rt_uint8_t         tx_seq;
+    rt_uint16_t        rx_len;   /* rx_buf 中尚未解析的字节数 */
+    orb_bridge_stat_t  stat;
+    rt_uint8_t         tx_buf[BRIDGE_BUF_SIZE];
+    rt_uint8_t         rx_buf[BRIDGE_BUF_SIZE];
+    rt_uint64_t        rx_msg[(UORB_BRIDGE_FRAME_MAX + 7) / 8]; /* 重新发布用的对齐消息缓冲 */
+};
+
+static void put_u16(rt_uint8_t *p, rt_uint16_t v)
+{
+    p[0] = (rt_uint8_t)v;
+    p[1] = (rt_uint8_t)(v >> 8);
+}
+
+static void put_u32(rt_uint8_t *p, rt_uint32_t v)
+{
+    put_u16(p, (rt_uint16_t)v);
+    put_u16(p + 2, (rt_uint16_t)(v >> 16));
+}
+
+static rt_uint16_t get_u16(const rt_uint8_t *p)
+{
+    return (rt_uint16_t)(p[0] | (p[1] << 8));
+}
+
+static rt_uint32_t get_u32(const rt_uint8_t *p)
+{
+    return get_u16(p) | ((rt_uint32_t)get_u16(p + 2) << 16);
+}
+
+/* CRC-16/CCITT（多项式 0x1021），逐字节移位计算，不用查表 */
+static rt_uint16_t bridge_crc16(rt_uint16_t crc, const rt_uint8_t *p, rt_size_t len)
+{
+    while (len--)
+    {
+        rt_uint8_t x = (rt_uint8_t)((crc >> 8) ^ *p++);
+        x ^= x >> 4;
+        crc = (rt_uint16_t)((crc << 8) ^ ((rt_uint16_t)x << 12) ^ ((rt_uint16_t)x << 5) ^ x);
+    }
+    return crc;
+}
+
+rt_uint16_t orb_bridge_topic_id(const struct orb_metadata *meta)
+{
+    rt_uint32_t h = 2166136261u;
+    for (const char *s = meta->o_name; *s; s++)
+    {
+        h = (h ^ (rt_uint8_t)*s) * 16777619u;
+    }
+    return (rt_uint16_t)((h >> 16) ^ h);
+}
+
+orb_bridge_t *orb_bridge_create(const orb_bridge_io_t *io, int max_topics)
+{
+    if (!io || max_topics <= 0 || max_topics > 255)
+    {
+        return RT_NULL;
+    }
+
+    /* 一次分配：控制块 + 发送表 + 接收表 */
+    rt_size_t     size   = sizeof(orb_bridge_t) + max_topics * (sizeof(struct bridge_tx) + sizeof(struct bridge_rx));
+    orb_bridge_t *bridge = rt_calloc(1, size);
+    if (!bridge)
+    {
+        return RT_NULL;
+    }
+    bridge->event = rt_event_create("u_bridge", RT_IPC_FLAG_FIFO);
+    bridge->done  = rt_sem_create("u_bridge", 0, RT_IPC_FLAG_FIFO);
+    if (!bridge->event || !bridge->done)
+    {
+        if (bridge->event) rt_event_delete(bridge->event);
+        if (bridge->done) rt_sem_delete(bridge->done);
+        rt_free(bridge);
+        return RT_NULL;
+    }
+    bridge->io         = *io;
+    bridge->max_topics = max_topics;
+    bridge->batch_ms   = UORB_BRIDGE_BATCH_MS;
+    bridge->tx         = (struct bridge_tx *)(bridge + 1);
+    bridge->rx         = (struct bridge_rx *)(bridge->tx + max_topics);
+    return bridge;
+}
+
+int orb_bridge_delete(orb_bridge_t *bridge)
+{
+    if (!bridge)
+    {
+        return -RT_EINVAL;
+    }
+
+    bridge->stop = RT_TRUE;
+    rt_event_send(bridge->event, BRIDGE_EV_STOP);
+    for (int i = 0; i < bridge->threads; i++)
+    {
+        rt_sem_take(bridge->done, RT_WAITING_FOREVER);
+    }
+
+    for (int i = 0; i < bridge->tx_count; i++)
+    {
+        orb_unregister_callback_ctx(&bridge->tx[i].cb);
+        orb_unsubscribe(bridge->tx[i].sub);
+    }
+    for (int i = 0; i < bridge->rx_count; i++)
+    {
+        for (int inst = 0; inst < ORB_MULTI_MAX_INSTANCES; inst++)
+        {
+            if (bridge->rx[i].adv[inst])
+            {
+                orb_unadvertise(bridge->rx[i].adv[inst]);
+            }
+        }
+    }
+    rt_event_delete(bridge->event);
+    rt_sem_delete(bridge->done);
+    rt_free(bridge);
+    return RT_EOK;
+}
+
+static struct bridge_rx *bridge_find_rx(orb_bridge_t *bridge, rt_uint16_t id)
+{
+    for (int i = 0; i < bridge->rx_count; i++)
+    {
+        if (bridge->rx[i].id == id)
+        {
+            return &bridge->rx[i];
+        }
+    }
+    return RT_NULL;
+}
+
+static void bridge_tx_notify(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    (void)meta;
+    (void)instance;
+    (void)data;
+    rt_event_send(((orb_bridge_t *)context)->event, BRIDGE_EV_TX);
+}
+
+int orb_bridge_add_tx(orb_bridge_t *bridge, const struct orb_metadata *meta, rt_uint8_t instance)
+{
+    if (!bridge || !meta || instance >= ORB_MULTI_MAX_INSTANCES || bridge->threads)
+    {
+        return -RT_EINVAL;
+    }
+    /* 消息原地拷入帧缓冲，须整条（含结构体尾部填充）放得下 */
+    if (UORB_BRIDGE_REC_SIZE + meta->o_size > UORB_BRIDGE_FRAME_MAX)
+    {
+        return -RT_EINVAL;
+    }
+    for (int i = 0; i < bridge->tx_count; i++)
+    {
+        if (bridge->tx[i].meta == meta && bridge->tx[i].instance == instance)
+        {
+            return -RT_EBUSY;
+        }
+    }
+    rt_uint16_t id = orb_bridge_topic_id(meta);
+    if (bridge_find_rx(bridge, id))
+    {
+        return -RT_EBUSY;
+    }
+    if (bridge->tx_count + bridge->rx_count >= bridge->max_topics)
+    {
+        return -RT_EFULL;
+    }
+
+    struct bridge_tx *t = &bridge->tx[bridge->tx_count];
+    t->sub = orb_subscribe_multi(meta, instance);
+    if (!t->sub)
+    {
+        return -RT_ENOMEM;
+    }
+    if (orb_register_callback_ctx(meta, instance, &t->cb, bridge_tx_notify, bridge) != RT_EOK)
+    {
+        orb_unsubscribe(t->sub);
+        t->sub = RT_NULL;
+        return -RT_ENOMEM;
+    }
+    t->meta     = meta;
+    t->id       = id;
+    t->instance = instance;
+    bridge->tx_count++;
+    return RT_EOK;
+}
+
+int orb_bridge_add_rx(orb_bridge_t *bridge, const struct orb_metadata *meta)
+{
+    if (!bridge || !meta || bridge->threads)
+    {
+        return -RT_EINVAL;
+    }
+    if (UORB_BRIDGE_REC_SIZE + meta->o_size > UORB_BRIDGE_FRAME_MAX)
+    {
+        return -RT_EINVAL;
+    }
+    rt_uint16_t id = orb_bridge_topic_id(meta);
+    if (bridge_find_rx(bridge, id))
+    {
+        return -RT_EBUSY;
+    }
+    for (int i = 0; i < bridge->tx_count; i++)
+    {
+        if (bridge->tx[i].id == id)
+        {
+            return -RT_EBUSY;
+        }
+    }
+    if (bridge->tx_count + bridge->rx_count >= bridge->max_topics)
+    {
+        return -RT_EFULL;
+    }
+
+    struct bridge_rx *r = &bridge->rx[bridge->rx_count++];
+    r->meta             = meta;
+    r->id               = id;
+    return RT_EOK;
+}
+
+static void bridge_send_frame(orb_bridge_t *bridge, rt_uint16_t len, rt_uint8_t count)
+{
+    rt_uint8_t *buf = bridge->tx_buf;
+    buf[0]          = UORB_BRIDGE_SYNC0;
+    buf[1]          = UORB_BRIDGE_SYNC1;
+    put_u16(buf + 2, len);
+    buf[4] = bridge->tx_seq++;
+    buf[5] = count;
+    put_u16(buf + UORB_BRIDGE_HDR_SIZE + len, bridge_crc16(0xFFFF, buf + 2, UORB_BRIDGE_HDR_SIZE - 2 + len));
+
+    rt_size_t total = UORB_BRIDGE_HDR_SIZE + len + UORB_BRIDGE_CRC_SIZE;
+    if (bridge->io.write(bridge->io.ctx, buf, total) == (rt_ssize_t)total)
+    {
+        bridge->stat.tx_frames++;
+        bridge->stat.tx_bytes += total;
+        bridge->stat.tx_msgs += count;
+    }
+}
+
+int orb_bridge_flush(orb_bridge_t *bridge)
+{
+    if (!bridge || !bridge->io.write)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_uint8_t *body  = bridge->tx_buf + UORB_BRIDGE_HDR_SIZE;
+    rt_uint16_t pos   = 0;
+    rt_uint8_t  count = 0;
+    int         sent  = 0;
+
+    for (int i = 0; i < bridge->tx_count; i++)
+    {
+        struct bridge_tx *t = &bridge->tx[i];
+        /* 队列主题逐条读出，最多一轮队列长度，避免发布过快时停在一个主题上 */
+        int burst = (t->sub->node) ? t->sub->node->queue_size : 1;
+        for (int n = 0; n < burst; n++)
+        {
+            if (pos + UORB_BRIDGE_REC_SIZE + t->meta->o_size > UORB_BRIDGE_FRAME_MAX || count == RT_UINT8_MAX)
+            {
+                bridge_send_frame(bridge, pos, count);
+                pos   = 0;
+                count = 0;
+            }
+            rt_uint8_t *rec = body + pos;
+            if (orb_update(t->sub, rec + UORB_BRIDGE_REC_SIZE) <= 0)
+            {
+                break;
+            }
+            /* orb_update 之后订阅者代数即这条消息的代数 */
+            put_u16(rec, t->id);
+            put_u16(rec + 2, t->meta->o_size_no_padding);
+            put_u32(rec + 4, t->sub->generation);
+            rec[8] = t->instance;
+            pos += UORB_BRIDGE_REC_SIZE + t->meta->o_size_no_padding;
+            count++;
+            sent++;
+        }
+    }
+    if (count)
+    {
+        bridge_send_frame(bridge, pos, count);
+    }
+    return sent;
+}
+
+/* 发布一帧中的全部记录 */
+static int bridge_dispatch(orb_bridge_t *bridge, const rt_uint8_t *p, rt_size_t len, rt_uint8_t count)
+{
+    int published = 0;
+    while (count--)
+    {
+        if (len < UORB_BRIDGE_REC_SIZE)
+        {
+            bridge->stat.rx_dropped += count + 1;
+            break;
+        }
+        rt_uint16_t id   = get_u16(p);
+        rt_uint16_t size = get_u16(p + 2);
+        rt_uint32_t gen  = get_u32(p + 4);
+        rt_uint8_t  inst = p[8];
+        if ((rt_size_t)UORB_BRIDGE_REC_SIZE + size > len)
+        {
+            bridge->stat.rx_dropped += count + 1;
+            break;
+        }
+        const rt_uint8_t *payload = p + UORB_BRIDGE_REC_SIZE;
+        p += UORB_BRIDGE_REC_SIZE + size;
+        len -= UORB_BRIDGE_REC_SIZE + size;
+
+        struct bridge_rx *r = bridge_find_rx(bridge, id);
+        if (!r || size != r->meta->o_size_no_padding || inst >= ORB_MULTI_MAX_INSTANCES)
+        {
+            bridge->stat.rx_dropped++;
+            continue;
+        }
+
+        /* generation 跳变说明对端有消息没有送到（队列覆盖或链路丢帧） */
+        rt_uint32_t last = r->last_gen[inst];
+        if (last && (rt_int32_t)(gen - last) > 1)
+        {
+            bridge->stat.rx_lost += gen - last - 1;
+        }
+        r->last_gen[inst] = gen;
+
+        rt_uint8_t *msg = (rt_uint8_t *)bridge->rx_msg;
+        rt_memcpy(msg, payload, size);
+        rt_memset(msg + size, 0, r->meta->o_size - size);
+        if (!r->adv[inst])
+        {
+            int local    = -1;
+            r->adv[inst] = orb_advertise_multi(r->meta, msg, &local);
+            if (!r->adv[inst])
+            {
+                bridge->stat.rx_dropped++;
+                continue;
+            }
+        }
+        else if (orb_publish(r->meta, r->adv[inst], msg) != RT_EOK)
+        {
+            bridge->stat.rx_dropped++;
+            continue;
+        }
+        published++;
+    }
+    bridge->stat.rx_msgs += published;
+    return published;
+}
+
+/* 在 rx_buf 中查找并处理完整帧，未解析的尾部移到缓冲开头 */
+static int bridge_parse(orb_bridge_t *bridge)
+{
+    rt_uint8_t *buf       = bridge->rx_buf;
+    rt_size_t   start     = 0;
+    int         published = 0;
+
+    for (;;)
+    {
+        while (start < bridge->rx_len &&
+               !(buf[start] == UORB_BRIDGE_SYNC0 && (start + 1 == bridge->rx_len || buf[start + 1] == UORB_BRIDGE_SYNC1)))
+        {
+            start++;
+        }
+        if (bridge->rx_len - start < UORB_BRIDGE_HDR_SIZE)
+        {
+            break;
+        }
+        rt_uint16_t len = get_u16(buf + start + 2);
+        if (len > UORB_BRIDGE_FRAME_MAX)
+        {
+            start++;
+            continue;
+        }
+        rt_size_t total = UORB_BRIDGE_HDR_SIZE + len + UORB_BRIDGE_CRC_SIZE;
+        if (bridge->rx_len - start < total)
+        {
+            break;
+        }
+        if (bridge_crc16(0xFFFF, buf + start + 2, UORB_BRIDGE_HDR_SIZE - 2 + len) !=
+            get_u16(buf + start + UORB_BRIDGE_HDR_SIZE + len))
+        {
+            /* 可能是误同步或帧损坏：跳过同步字节重新查找 */
+            bridge->stat.rx_crc_errors++;
+            start++;
+            continue;
+        }
+        bridge->stat.rx_frames++;
+        published += bridge_dispatch(bridge, buf + start + UORB_BRIDGE_HDR_SIZE, len, buf[start + 5]);
+        start += total;
+    }
+
+    bridge->rx_len -= (rt_uint16_t)start;
+    rt_memmove(buf, buf + start, bridge->rx_len);
+    return published;
+}
+
+int orb_bridge_input(orb_bridge_t *bridge, const void *data, rt_size_t len)
+{
+    if (!bridge || (!data && len))
+    {
+        return -RT_EINVAL;
+    }
+
+    const rt_uint8_t *p         = (const rt_uint8_t *)data;
+    int               published = 0;
+    bridge->stat.rx_bytes += len;
+    while (len)
+    {
+        rt_size_t n = sizeof(bridge->rx_buf) - bridge->rx_len;
+        if (n > len) n = len;
+        rt_memcpy(bridge->rx_buf + bridge->rx_len, p, n);
+        bridge->rx_len += (rt_uint16_t)n;
+        p += n;
+        len -= n;
+        published += bridge_parse(bridge);
+    }
+    return published;
+}
+
+int orb_bridge_get_stat(orb_bridge_t *bridge, orb_bridge_stat_t *stat)
+{
+    if (!bridge || !stat)
+    {
+        return -RT_EINVAL;
+    }
+    *stat = bridge->stat;
+    return RT_EOK;
+}
+
+int orb_bridge_set_batch_window(orb_bridge_t *bridge, rt_uint32_t ms)
+{
+    if (!bridge)
+    {
+        return -RT_EINVAL;
+    }
+    bridge->batch_ms = ms;
+    return RT_EOK;
+}
+
+static void bridge_tx_entry(void *parameter)
+{
+    orb_bridge_t *bridge = (orb_bridge_t *)parameter;
+    /* 先发出启动前已有的消息 */
+    orb_bridge_flush(bridge);
+    while (!bridge->stop)
+    {
+        rt_uint32_t set = 0;
+        rt_event_recv(bridge->event, BRIDGE_EV_TX | BRIDGE_EV_STOP, RT_EVENT_FLAG_OR | RT_EVENT_FLAG_CLEAR,
+                      RT_WAITING_FOREVER, &set);
+        if (bridge->stop)
+        {
+            break;
+        }
+        if (bridge->batch_ms)
+        {
+            rt_thread_mdelay(bridge->batch_ms);
+        }
+        orb_bridge_flush(bridge);
+    }
+    rt_sem_release(bridge->done);
+}
+
+static void bridge_rx_entry(void *parameter)
+{
+    orb_bridge_t *bridge = (orb_bridge_t *)parameter;
+    rt_uint8_t    buf[128];
+    while (!bridge->stop)
+    {
+        /* 限时读取，以便及时响应停止请求 */
+        rt_ssize_t n = bridge->io.read(bridge->io.ctx, buf, sizeof(buf), 100);
+        if (n > 0)
+        {
+            orb_bridge_input(bridge, buf, (rt_size_t)n);
+        }
+    }
+    rt_sem_release(bridge->done);
+}
+
+int orb_bridge_start(orb_bridge_t *bridge)
+{
+    if (!bridge || bridge->threads)
+    {
+        return -RT_EINVAL;
+    }
+    if ((bridge->tx_count && !bridge->io.write) || (bridge->rx_count && !bridge->io.read))
+    {
+        return -RT_EINVAL;
+    }
+
+    if (bridge->tx_count)
+    {
+        rt_thread_t tid = rt_thread_create("u_brtx", bridge_tx_entry, bridge, UORB_BRIDGE_THREAD_STACK,
+                                           UORB_BRIDGE_THREAD_PRIORITY, 10);
+        if (!tid)
+        {
+            return -RT_ENOMEM;
+        }
+        bridge->threads++;
+        rt_thread_startup(tid);
+    }
+    if (bridge->rx_count)
+    {
+        rt_thread_t tid = rt_thread_create("u_brrx", bridge_rx_entry, bridge, UORB_BRIDGE_THREAD_STACK,
+                                           UORB_BRIDGE_THREAD_PRIORITY, 10);
+        if (!tid)
+        {
+            return -RT_ENOMEM;
+        }
+        bridge->threads++;
+        rt_thread_startup(tid);
+    }
+    return RT_EOK;
+}
+
+#ifdef RT_USING_DEVICE
+#ifndef UORB_BRIDGE_MAX_DEVICES
+#define UORB_BRIDGE_MAX_DEVICES 2
+#endif
+
+/* rx_indicate 回调没有上下文参数，按设备指针查找对应的信号量 */
+struct bridge_dev
+{
+    rt_device_t         dev;
+    struct rt_semaphore rx_sem;
+};
+static struct bridge_dev _bridge_dev[UORB_BRIDGE_MAX_DEVICES];
+
+static rt_err_t bridge_dev_rx_ind(rt_device_t dev, rt_size_t size)
+{
+    (void)size;
+    for (int i = 0; i < UORB_BRIDGE_MAX_DEVICES; i++)
+    {
+        if (_bridge_dev[i].dev == dev)
+        {
+            rt_sem_release(&_bridge_dev[i].rx_sem);
+            break;
+        }
+    }
+    return RT_EOK;
+}
+
+static rt_ssize_t bridge_dev_write(void *ctx, const void *buf, rt_size_t len)
+{
+    struct bridge_dev *d    = (struct bridge_dev *)ctx;
+    rt_size_t          done = 0;
+    while (done < len)
+    {
+        rt_ssize_t n = rt_device_write(d->dev, 0, (const rt_uint8_t *)buf + done, len - done);
+        if (n <= 0)
+        {
+            break;
+        }
+        done += n;
+    }
+    return (rt_ssize_t)done;
+}
+
+static rt_ssize_t bridge_dev_read(void *ctx, void *buf, rt_size_t len, rt_int32_t timeout_ms)
+{
+    struct bridge_dev *d = (struct bridge_dev *)ctx;
+    rt_ssize_t         n = rt_device_read(d->dev, 0, buf, len);
+    if (n > 0)
+    {
+        return n;
+    }
+    if (rt_sem_take(&d->rx_sem, rt_tick_from_millisecond(timeout_ms)) != RT_EOK)
+    {
+        return 0;
+    }
+    n = rt_device_read(d->dev, 0, buf, len);
+    return n > 0 ? n : 0;
+}
+
+int orb_bridge_io_device(orb_bridge_io_t *io, rt_device_t dev)
+{
+    if (!io || !dev)
+    {
+        return -RT_EINVAL;
+    }
+
+    struct bridge_dev *d = RT_NULL;
+    rt_enter_critical();
+    for (int i = 0; i < UORB_BRIDGE_MAX_DEVICES && !d; i++)
+    {
+        if (_bridge_dev[i].dev == dev)
+        {
+            d = &_bridge_dev[i];
+        }
+    }
+    for (int i = 0; i < UORB_BRIDGE_MAX_DEVICES && !d; i++)
+    {
+        if (!_bridge_dev[i].dev)
+        {
+            d      = &_bridge_dev[i];
+            d->dev = dev;
+            rt_sem_init(&d->rx_sem, "u_brdev", 0, RT_IPC_FLAG_FIFO);
+        }
+    }
+    rt_exit_critical();
+    if (!d)
+    {
+        return -RT_EFULL;
+    }
+
+    rt_device_set_rx_indicate(dev, bridge_dev_rx_ind);
+    io->write = bridge_dev_write;
+    io->read  = bridge_dev_read;
+    io->ctx   = d;
+    return RT_EOK;
+}
+#endif /* RT_USING_DEVICE */
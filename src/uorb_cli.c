@@ -6,6 +6,7 @@
 
 #include "uorb_device_node.h"
 #include "uorb_device_if.h"
+#include "uorb_trace.h"
 #include <rtthread.h>
 #include <string.h>
 #include <stdlib.h>
@@ -17,26 +18,46 @@
 #include "uorb_demo_topics.h"
 #endif
 
-extern rt_list_t _orb_node_list;
-extern rt_bool_t _orb_node_list_initialized;
+/* 取一份节点快照（调用方释放）；节点数在两次调用间增长时按新数量重取 */
+static orb_node_stat_t *uorb_cli_snapshot(int *count)
+{
+    int              cap   = 16;
+    orb_node_stat_t *stats = RT_NULL;
+    for (;;)
+    {
+        orb_node_stat_t *grown = rt_realloc(stats, sizeof(orb_node_stat_t) * cap);
+        if (!grown)
+        {
+            rt_free(stats);
+            *count = 0;
+            return RT_NULL;
+        }
+        stats = grown;
+        int n = orb_snapshot(stats, cap);
+        if (n <= cap)
+        {
+            *count = n;
+            return stats;
+        }
+        cap = n + 8;
+    }
+}
 
+/* 按名字查找主题：遍历节点快照，不在注册表锁内做字符串比较 */
 static const struct orb_metadata *find_meta_by_name(const char *name)
 {
-    if (!_orb_node_list_initialized) return RT_NULL;
-    rt_list_t *pos;
-    rt_enter_critical();
-    rt_list_for_each(pos, &_orb_node_list)
+    int                        n     = 0;
+    const struct orb_metadata *meta  = RT_NULL;
+    orb_node_stat_t           *stats = uorb_cli_snapshot(&n);
+    for (int i = 0; stats && i < n && !meta; i++)
     {
-        orb_node_t *node = rt_list_entry(pos, orb_node_t, list);
-        if (rt_strcmp(node->meta->o_name, name) == 0)
+        if (rt_strcmp(stats[i].meta->o_name, name) == 0)
         {
-            const struct orb_metadata *m = node->meta;
-            rt_exit_critical();
-            return m;
+            meta = stats[i].meta;
         }
     }
-    rt_exit_critical();
-    return RT_NULL;
+    rt_free(stats);
+    return meta;
 }
 
 static void uorb_test_basic(void)
@@ -221,235 +242,372 @@ static void uorb_test_device(void)
 }
 #endif
 
+static rt_bool_t uorb_cli_match(const orb_node_stat_t *st, const char *filter)
+{
+    return !filter || !filter[0] || rt_strncmp(st->meta->o_name, filter, RT_NAME_MAX) == 0;
+}
+
 static void uorb_cmd_status(const char *filter)
 {
-    if (!_orb_node_list_initialized)
+    int              n     = 0;
+    orb_node_stat_t *stats = uorb_cli_snapshot(&n);
+    if (!stats)
     {
-        rt_kprintf("uORB: no topics (list not initialized)\n");
+        rt_kprintf("uORB: no memory for snapshot\n");
         return;
     }
 
     int count = 0;
-    rt_list_t *pos;
-
-    rt_enter_critical();
-    rt_list_for_each(pos, &_orb_node_list)
+    for (int i = 0; i < n; i++)
     {
-        orb_node_t *node = rt_list_entry(pos, orb_node_t, list);
-        if (filter && filter[0])
+        const orb_node_stat_t *st = &stats[i];
+        if (!uorb_cli_match(st, filter))
         {
-            if (rt_strncmp(node->meta->o_name, filter, RT_NAME_MAX) != 0)
-            {
-                continue;
-            }
+            continue;
         }
 #ifdef UORB_REGISTER_AS_DEVICE
         rt_kprintf("topic=%s inst=%d dev=/dev/%s%d q=%d gen=%u subs=%d adv=%d valid=%d size=%d\n",
-                   node->meta->o_name,
-                   node->instance,
-                   node->meta->o_name,
-                   node->instance,
-                   node->queue_size,
-                   (unsigned)node->generation,
-                   node->subscriber_count,
-                   node->advertised,
-                   node->data_valid,
-                   node->meta->o_size);
+                   st->meta->o_name,
+                   st->instance,
+                   st->meta->o_name,
+                   st->instance,
+                   st->queue_size,
+                   (unsigned)st->generation,
+                   st->subscriber_count,
+                   st->advertised,
+                   st->data_valid,
+                   st->meta->o_size);
 #else
         rt_kprintf("topic=%s inst=%d q=%d gen=%u subs=%d adv=%d valid=%d size=%d\n",
-                   node->meta->o_name,
-                   node->instance,
-                   node->queue_size,
-                   (unsigned)node->generation,
-                   node->subscriber_count,
-                   node->advertised,
-                   node->data_valid,
-                   node->meta->o_size);
+                   st->meta->o_name,
+                   st->instance,
+                   st->queue_size,
+                   (unsigned)st->generation,
+                   st->subscriber_count,
+                   st->advertised,
+                   st->data_valid,
+                   st->meta->o_size);
 #endif
         count++;
     }
-    rt_exit_critical();
+    rt_free(stats);
 
     rt_kprintf("total=%d\n", count);
 }
 
-static void uorb_cmd_top(const char *filter, int loops, int interval_ms, int max_items)
+/* top 排序方式 */
+enum
 {
-    if (loops <= 0) loops = 3;
-    if (interval_ms <= 0) interval_ms = 500;
+    TOP_SORT_NONE = 0,
+    TOP_SORT_RATE,
+    TOP_SORT_BW,
+    TOP_SORT_NAME,
+};
+
+/* 跟踪表：按节点序号开放寻址散列，查找 O(1)，不限主题个数 */
+struct top_track
+{
+    rt_uint32_t id; /* 0 表示空槽 */
+    rt_uint32_t gen;
+    rt_uint32_t supp;
+    rt_uint64_t pub;
+    rt_uint64_t copy;
+    rt_uint64_t wus;
+    rt_uint64_t rus;
+};
+
+struct top_row
+{
+    const orb_node_stat_t *st;
+    unsigned               delta;
+    unsigned               supp;
+    rt_uint32_t            bw;      /* 发布字节/秒 */
+    rt_uint32_t            copy_bw; /* 拷出字节/秒 */
+    rt_uint32_t            w_us;    /* 每秒发布耗时（微秒） */
+    rt_uint32_t            r_us;    /* 每秒拷贝耗时（微秒） */
+};
+
+static rt_uint32_t top_per_sec(rt_uint64_t delta, int dt_ms)
+{
+    return (rt_uint32_t)(delta * 1000u / (rt_uint64_t)dt_ms);
+}
 
-    unsigned last_gen_sum = 0;
+static struct top_track *top_track_slot(struct top_track *tab, rt_uint32_t mask, rt_uint32_t id)
+{
+    rt_uint32_t i = (id * 2654435761U) & mask;
+    while (tab[i].id != 0 && tab[i].id != id)
+    {
+        i = (i + 1) & mask;
+    }
+    return &tab[i];
+}
 
-    /* 跟踪每个条目的上一代数，用于估算每项频率 */
-    #define TOP_MAX_TRACK 64
-    struct top_track { const struct orb_metadata *meta; rt_uint8_t inst; unsigned prev_gen; int used; };
-    struct top_track tracks[TOP_MAX_TRACK] = {0};
+static int top_sort_key;
 
-    /* 初始化基线，避免首轮 delta 为 0 */
-    if (_orb_node_list_initialized)
+static int top_row_cmp(const void *a, const void *b)
+{
+    const struct top_row *ra = (const struct top_row *)a;
+    const struct top_row *rb = (const struct top_row *)b;
+    switch (top_sort_key)
     {
-        rt_list_t *pos0;
-        rt_enter_critical();
-        rt_list_for_each(pos0, &_orb_node_list)
-        {
-            orb_node_t *node0 = rt_list_entry(pos0, orb_node_t, list);
-            int idx0 = -1;
-            for (int i = 0; i < TOP_MAX_TRACK; i++)
-            {
-                if (tracks[i].used && tracks[i].meta == node0->meta && tracks[i].inst == node0->instance)
-                {
-                    idx0 = i; break;
-                }
-            }
-            if (idx0 < 0)
-            {
-                for (int i = 0; i < TOP_MAX_TRACK; i++)
-                {
-                    if (!tracks[i].used)
-                    {
-                        tracks[i].used = 1;
-                        tracks[i].meta = node0->meta;
-                        tracks[i].inst = node0->instance;
-                        tracks[i].prev_gen = (unsigned)node0->generation;
-                        idx0 = i; break;
-                    }
-                }
-            }
-        }
-        rt_exit_critical();
-        rt_thread_mdelay(interval_ms);
+    case TOP_SORT_RATE:
+        return (ra->delta < rb->delta) - (ra->delta > rb->delta);
+    case TOP_SORT_BW:
+        return (ra->bw < rb->bw) - (ra->bw > rb->bw);
+    case TOP_SORT_NAME:
+    {
+        int c = rt_strcmp(ra->st->meta->o_name, rb->st->meta->o_name);
+        return c ? c : (int)ra->st->instance - (int)rb->st->instance;
     }
+    default:
+        return 0;
+    }
+}
+
+/*
+ * 周期性打印各主题的更新计数。每轮只在 orb_snapshot() 内短暂持有注册表锁，
+ * 统计、排序与打印均在锁外，对发布方没有可感知的影响。
+ */
+static void uorb_cmd_top(const char *filter, int loops, int interval_ms, int max_items, int sort, rt_bool_t bw_view)
+{
+    if (loops <= 0) loops = 3;
+    if (interval_ms <= 0) interval_ms = 500;
 
-    while (loops-- > 0)
+    struct top_track *prev      = RT_NULL;
+    rt_uint32_t       prev_mask = 0;
+    rt_tick_t         last_tick = 0;
+
+    /* 第 0 轮只建立基线，避免首轮 delta 为 0 */
+    for (int round = 0; round <= loops; round++)
     {
-        if (!_orb_node_list_initialized)
+        int              n     = 0;
+        orb_node_stat_t *stats = uorb_cli_snapshot(&n);
+        rt_tick_t        now   = rt_tick_get();
+
+        rt_uint32_t size = 16;
+        while (size < (rt_uint32_t)n * 2) size <<= 1;
+        struct top_track *cur  = rt_calloc(size, sizeof(struct top_track));
+        struct top_row   *rows = rt_malloc(sizeof(struct top_row) * (n ? n : 1));
+        if (!stats || !cur || !rows)
         {
-            rt_kprintf("uORB: no topics (list not initialized)\n");
-            return;
+            rt_kprintf("uORB: no memory for snapshot\n");
+            rt_free(stats);
+            rt_free(cur);
+            rt_free(rows);
+            break;
         }
 
-        int count = 0;
-        int printed = 0;
-        rt_list_t *pos;
-        unsigned gen_sum = 0;
-
-        static rt_tick_t last_tick = 0;
-        rt_tick_t now_tick = rt_tick_get();
-        int dt_ms = 0;
-        if (last_tick == 0) dt_ms = interval_ms; else dt_ms = (int)((now_tick - last_tick) * 1000 / RT_TICK_PER_SECOND);
-        last_tick = now_tick;
-
-        rt_enter_critical();
-        /* 预统计用于表头 */
-        int count_total = 0;
-        rt_list_for_each(pos, &_orb_node_list)
+        int dt_ms = (last_tick == 0) ? interval_ms : (int)((now - last_tick) * 1000 / RT_TICK_PER_SECOND);
+        if (dt_ms <= 0) dt_ms = interval_ms;
+        last_tick = now;
+
+        int nrows = 0;
+        for (int i = 0; i < n; i++)
         {
-            orb_node_t *n = rt_list_entry(pos, orb_node_t, list);
-            if (!filter || !filter[0] || rt_strncmp(n->meta->o_name, filter, RT_NAME_MAX) == 0)
+            const orb_node_stat_t *st = &stats[i];
+            struct top_track      *t  = top_track_slot(cur, size - 1, st->id);
+            t->id                     = st->id;
+            t->gen                    = st->generation;
+            t->supp                   = st->suppressed;
+            t->pub                    = st->bytes_published;
+            t->copy                   = st->bytes_copied;
+            t->wus                    = st->write_us;
+            t->rus                    = st->read_us;
+
+            if (!uorb_cli_match(st, filter))
             {
-                count_total++;
+                continue;
             }
-        }
-        rt_kprintf("update: %ds, num topics: %d\n", (dt_ms + 500) / 1000, count_total);
-        rt_kprintf("TOPIC NAME                    INST #SUB #MSG #LOST #QSIZE\n");
-        /* 打印条目 */
-        rt_list_for_each(pos, &_orb_node_list)
-        {
-            orb_node_t *node = rt_list_entry(pos, orb_node_t, list);
-            if (filter && filter[0])
+            struct top_row *r = &rows[nrows++];
+            rt_memset(r, 0, sizeof(*r));
+            r->st = st;
+            if (prev)
             {
-                if (rt_strncmp(node->meta->o_name, filter, RT_NAME_MAX) != 0)
+                struct top_track *p = top_track_slot(prev, prev_mask, st->id);
+                if (p->id == st->id)
                 {
-                    continue;
+                    r->delta   = st->generation - p->gen;
+                    r->supp    = st->suppressed - p->supp;
+                    r->bw      = top_per_sec(st->bytes_published - p->pub, dt_ms);
+                    r->copy_bw = top_per_sec(st->bytes_copied - p->copy, dt_ms);
+                    r->w_us    = top_per_sec(st->write_us - p->wus, dt_ms);
+                    r->r_us    = top_per_sec(st->read_us - p->rus, dt_ms);
                 }
             }
-            gen_sum += (unsigned)node->generation;
+        }
 
-            /* 查找或占位跟踪项 */
-            int idx = -1;
-            for (int i = 0; i < TOP_MAX_TRACK; i++)
-            {
-                if (tracks[i].used && tracks[i].meta == node->meta && tracks[i].inst == node->instance)
-                {
-                    idx = i; break;
-                }
-            }
-            if (idx < 0)
+        if (round > 0)
+        {
+            if (sort != TOP_SORT_NONE && nrows > 1)
             {
-                for (int i = 0; i < TOP_MAX_TRACK; i++)
-                {
-                    if (!tracks[i].used)
-                    {
-                        tracks[i].used = 1;
-                        tracks[i].meta = node->meta;
-                        tracks[i].inst = node->instance;
-                        tracks[i].prev_gen = (unsigned)node->generation;
-                        idx = i; break;
-                    }
-                }
+                top_sort_key = sort;
+                qsort(rows, nrows, sizeof(struct top_row), top_row_cmp);
             }
 
-            unsigned delta = 0;
-            unsigned hz = 0;
-            if (idx >= 0)
+            rt_kprintf("update: %ds, num topics: %d\n", (dt_ms + 500) / 1000, nrows);
+            if (bw_view)
             {
-                unsigned prev = tracks[idx].prev_gen;
-                unsigned cur  = (unsigned)node->generation;
-                delta = (cur >= prev) ? (cur - prev) : 0;
-                if (interval_ms > 0)
+                /* 带宽视图：每秒发布/拷出字节数与发布/拷贝耗时（耗时需 UORB_USING_PROFILING） */
+                rt_kprintf("TOPIC NAME                    INST #MSG  PUB(B/s) COPY(B/s) W(us/s) R(us/s)\n");
+                for (int i = 0; i < nrows && (max_items <= 0 || i < max_items); i++)
                 {
-                    rt_uint64_t num = (rt_uint64_t)delta * 1000u;
-                    hz = (unsigned)(num / (rt_uint64_t)interval_ms);
+                    const struct top_row *r = &rows[i];
+#ifdef UORB_USING_PROFILING
+                    rt_kprintf("%-28s %4d %4u %9u %9u %7u %7u\n",
+                               r->st->meta->o_name, r->st->instance, r->delta,
+                               (unsigned)r->bw, (unsigned)r->copy_bw, (unsigned)r->w_us, (unsigned)r->r_us);
+#else
+                    rt_kprintf("%-28s %4d %4u %9u %9u %7s %7s\n",
+                               r->st->meta->o_name, r->st->instance, r->delta,
+                               (unsigned)r->bw, (unsigned)r->copy_bw, "-", "-");
+#endif
                 }
-                tracks[idx].prev_gen = cur;
             }
-
-            if (max_items <= 0 || printed < max_items)
+            else
             {
-                unsigned lost = 0;
-                if (node->subscriber_count > 0)
+                rt_kprintf("TOPIC NAME                    INST #SUB #MSG #LOST #QSIZE #SUPP\n");
+                for (int i = 0; i < nrows && (max_items <= 0 || i < max_items); i++)
                 {
-                    if (node->queue_size > 1)
-                    {
-                        lost = (delta > node->queue_size) ? (delta - node->queue_size) : 0;
-                    }
-                    else
+                    const struct top_row  *r    = &rows[i];
+                    const orb_node_stat_t *st   = r->st;
+                    unsigned               lost = 0;
+                    if (st->subscriber_count > 0)
                     {
-                        lost = (delta > 1) ? (delta - 1) : 0;
+                        lost = (r->delta > st->queue_size) ? (r->delta - st->queue_size) : 0;
                     }
+                    rt_kprintf("%-28s %4d %4d %4u %5u %6d %5u\n",
+                               st->meta->o_name,
+                               st->instance,
+                               st->subscriber_count,
+                               r->delta,
+                               lost,
+                               st->queue_size,
+                               r->supp);
                 }
-                rt_kprintf("%-28s %4d %4d %4u %5u %6d\n",
-                           node->meta->o_name,
-                           node->instance,
-                           node->subscriber_count,
-                           delta,
-                           lost,
-                           node->queue_size);
-                printed++;
             }
+        }
+
+        rt_free(rows);
+        rt_free(stats);
+        rt_free(prev);
+        prev      = cur;
+        prev_mask = size - 1;
 
-            count++;
+        if (round < loops)
+        {
+            rt_thread_mdelay(interval_ms);
         }
-        rt_exit_critical();
+    }
+    rt_free(prev);
+}
 
-        if (last_gen_sum != 0)
+/*
+ * 按字段打印主题消息。只做普通订阅与 orb_copy（数据锁内一次拷贝），
+ * 解码与打印都在锁外进行；限速在本地按间隔休眠，不设置订阅间隔，
+ * 因而不会触发发布端自动限速，也不占用调度锁。
+ */
+static int uorb_cmd_listener(const char *topic, int inst, int count, int rate_hz)
+{
+    const struct orb_metadata *meta = find_meta_by_name(topic);
+    if (!meta)
+    {
+        rt_kprintf("unknown topic: %s\n", topic);
+        return -1;
+    }
+    if (inst < 0 || inst >= ORB_MULTI_MAX_INSTANCES)
+    {
+        rt_kprintf("invalid instance: %d\n", inst);
+        return -1;
+    }
+    if (count <= 0) count = 1;
+
+    orb_subscr_t sub = orb_subscribe_multi(meta, (rt_uint8_t)inst);
+    void        *buf = rt_malloc(meta->o_size);
+    if (!sub || !buf)
+    {
+        rt_kprintf("listener: out of memory\n");
+        if (sub) orb_unsubscribe(sub);
+        rt_free(buf);
+        return -1;
+    }
+
+    /* 先输出已有的最新一条，之后只输出新消息 */
+    int printed = 0;
+    int ret     = orb_copy(meta, sub, buf);
+    while (printed < count)
+    {
+        if (ret <= 0)
         {
-            unsigned delta_all = (gen_sum >= last_gen_sum) ? (gen_sum - last_gen_sum) : 0;
-            unsigned hz_all = 0;
-            if (count > 0 && interval_ms > 0)
+            if (orb_wait(sub, 2000) != RT_EOK)
             {
-                rt_uint64_t num = (rt_uint64_t)delta_all * 1000u;
-                rt_uint64_t den = (rt_uint64_t)interval_ms * (rt_uint64_t)count;
-                hz_all = (unsigned)(num / den);
+                rt_kprintf("listener: no update from %s[%d]\n", topic, inst);
+                break;
             }
-            // rt_kprintf("items=%d, shown=%d, est_rate=%uHz\n", count, (max_items>0? (printed<max_items? printed:max_items):printed), hz_all);
+            ret = orb_copy(meta, sub, buf);
+            continue;
         }
-        else
+
+        rt_kprintf("TOPIC: %s instance %d #%d\n", meta->o_name, inst, printed + 1);
+        orb_print_message_internal(meta, buf, false);
+        printed++;
+        ret = 0;
+
+        if (rate_hz > 0 && printed < count)
+        {
+            rt_thread_mdelay(1000 / rate_hz);
+        }
+    }
+
+    rt_free(buf);
+    orb_unsubscribe(sub);
+    return 0;
+}
+
+static void uorb_cmd_mem(const char *filter)
+{
+    static const char *const names[ORB_MEM_CATEGORIES] = {"node", "event", "queue", "subscription", "callback", "group"};
+
+    int              n     = 0;
+    orb_node_stat_t *stats = uorb_cli_snapshot(&n);
+    orb_mem_stat_t   mem;
+    orb_mem_get(&mem);
+    if (!stats)
+    {
+        rt_kprintf("uORB: no memory for snapshot\n");
+        return;
+    }
+
+    rt_kprintf("%-20s %4s %4s %6s %8s\n", "TOPIC", "INST", "SUBS", "QUEUE", "BYTES");
+    rt_uint32_t sum = 0;
+    for (int i = 0; i < n; i++)
+    {
+        const orb_node_stat_t *st = &stats[i];
+        if (!uorb_cli_match(st, filter))
         {
-            // rt_kprintf("items=%d, shown=%d\n", count, (max_items>0? (printed<max_items? printed:max_items):printed));
+            continue;
         }
-        last_gen_sum = gen_sum;
-        rt_thread_mdelay(interval_ms);
+        rt_kprintf("%-20.20s %4d %4d %6d %8u\n", st->meta->o_name, st->instance, st->subscriber_count,
+                   st->data_valid ? st->meta->o_size * st->queue_size : 0, (unsigned)st->mem_bytes);
+        sum += st->mem_bytes;
+    }
+    rt_free(stats);
+    rt_kprintf("%-20s %25u\n", "topics", (unsigned)sum);
+
+    rt_kprintf("\n%-14s %8s %8s\n", "CATEGORY", "CURRENT", "PEAK");
+    for (int i = 0; i < ORB_MEM_CATEGORIES; i++)
+    {
+        rt_kprintf("%-14s %8u %8u\n", names[i], (unsigned)mem.current[i], (unsigned)mem.peak[i]);
+    }
+    rt_kprintf("%-14s %8u %8u\n", "total", (unsigned)mem.total, (unsigned)mem.total_peak);
+    rt_kprintf("reserved=%u (queues not yet published)\n", (unsigned)mem.reserved);
+    if (mem.budget)
+    {
+        rt_kprintf("budget=%u used=%u rejected=%u\n", (unsigned)mem.budget, (unsigned)(mem.total + mem.reserved),
+                   (unsigned)mem.rejected);
+    }
+    else
+    {
+        rt_kprintf("budget=unlimited\n");
     }
 }
 
@@ -458,9 +616,14 @@ static int uorb_main(int argc, char **argv)
     if (argc <= 1)
     {
         rt_kprintf("usage: uorb status [topic]\n");
-        rt_kprintf("       uorb top [topic] [loops] [interval_ms] [max_items]\n");
+        rt_kprintf("       uorb top [topic] [loops] [interval_ms] [max_items] [-b] [-s rate|bw|name]\n");
         rt_kprintf("       uorb test basic|interval|device|multi\n");
         rt_kprintf("       uorb wait <topic> [instance] [timeout_ms]\n");
+        rt_kprintf("       uorb listener <topic> [-i inst] [-n count] [-r rate_hz]\n");
+        rt_kprintf("       uorb mem [topic] [-B budget_bytes]\n");
+#ifdef UORB_USING_TRACE
+        rt_kprintf("       uorb trace start|stop|clear|dump\n");
+#endif
 #ifdef UORB_REGISTER_AS_DEVICE
         rt_kprintf("       uorb dev register <topic> <instance>\n");
         rt_kprintf("       uorb dev status <topic> <instance>\n");
@@ -477,11 +640,38 @@ static int uorb_main(int argc, char **argv)
 
     if (rt_strcmp(argv[1], "top") == 0)
     {
-        const char *filter = (argc >= 3) ? argv[2] : RT_NULL;
-        int loops = (argc >= 4) ? atoi(argv[3]) : 3;
-        int interval_ms = (argc >= 5) ? atoi(argv[4]) : 500;
-        int max_items = (argc >= 6) ? atoi(argv[5]) : 0;
-        uorb_cmd_top(filter, loops, interval_ms, max_items);
+        /* 位置参数：[topic] [loops] [interval_ms] [max_items]；选项 -b、-s rate|bw|name 可出现在任意位置 */
+        const char *pos[4] = {RT_NULL, RT_NULL, RT_NULL, RT_NULL};
+        int npos = 0, sort = TOP_SORT_NONE;
+        rt_bool_t bw_view = RT_FALSE;
+        for (int i = 2; i < argc; i++)
+        {
+            if (rt_strcmp(argv[i], "-b") == 0)
+            {
+                bw_view = RT_TRUE;
+            }
+            else if (rt_strcmp(argv[i], "-s") == 0 && i + 1 < argc)
+            {
+                const char *key = argv[++i];
+                if (rt_strcmp(key, "rate") == 0) sort = TOP_SORT_RATE;
+                else if (rt_strcmp(key, "bw") == 0) sort = TOP_SORT_BW;
+                else if (rt_strcmp(key, "name") == 0) sort = TOP_SORT_NAME;
+                else
+                {
+                    rt_kprintf("unknown sort key: %s (rate|bw|name)\n", key);
+                    return -1;
+                }
+            }
+            else if (npos < 4)
+            {
+                pos[npos++] = argv[i];
+            }
+        }
+        const char *filter = pos[0];
+        int loops = pos[1] ? atoi(pos[1]) : 3;
+        int interval_ms = pos[2] ? atoi(pos[2]) : 500;
+        int max_items = pos[3] ? atoi(pos[3]) : 0;
+        uorb_cmd_top(filter, loops, interval_ms, max_items, sort, bw_view);
         return 0;
     }
 
@@ -500,6 +690,53 @@ static int uorb_main(int argc, char **argv)
         return -1;
     }
 
+    if (rt_strcmp(argv[1], "listener") == 0 && argc >= 3)
+    {
+        int inst = 0, count = 1, rate_hz = 0;
+        for (int i = 3; i + 1 < argc; i += 2)
+        {
+            if (rt_strcmp(argv[i], "-i") == 0) inst = atoi(argv[i + 1]);
+            else if (rt_strcmp(argv[i], "-n") == 0) count = atoi(argv[i + 1]);
+            else if (rt_strcmp(argv[i], "-r") == 0) rate_hz = atoi(argv[i + 1]);
+            else
+            {
+                rt_kprintf("usage: uorb listener <topic> [-i inst] [-n count] [-r rate_hz]\n");
+                return -1;
+            }
+        }
+        return uorb_cmd_listener(argv[2], inst, count, rate_hz);
+    }
+
+    if (rt_strcmp(argv[1], "mem") == 0)
+    {
+        const char *filter = RT_NULL;
+        for (int i = 2; i < argc; i++)
+        {
+            if (rt_strcmp(argv[i], "-B") == 0 && i + 1 < argc)
+            {
+                orb_mem_set_budget((rt_size_t)strtoul(argv[++i], RT_NULL, 0));
+            }
+            else
+            {
+                filter = argv[i];
+            }
+        }
+        uorb_cmd_mem(filter);
+        return 0;
+    }
+
+#ifdef UORB_USING_TRACE
+    if (rt_strcmp(argv[1], "trace") == 0 && argc >= 3)
+    {
+        if (rt_strcmp(argv[2], "start") == 0) { uorb_trace_start(); return 0; }
+        if (rt_strcmp(argv[2], "stop") == 0) { uorb_trace_stop(); return 0; }
+        if (rt_strcmp(argv[2], "clear") == 0) { uorb_trace_stop(); uorb_trace_clear(); return 0; }
+        if (rt_strcmp(argv[2], "dump") == 0) { uorb_trace_dump(); return 0; }
+        rt_kprintf("usage: uorb trace start|stop|clear|dump\n");
+        return -1;
+    }
+#endif
+
     if (rt_strcmp(argv[1], "wait") == 0 && argc >= 3)
     {
         const char *topic = argv[2];
@@ -588,33 +825,28 @@ static int uorb_main(int argc, char **argv)
             else
             {
                 /* 设备不存在，回退打印节点信息 */
-                if (!_orb_node_list_initialized)
-                {
-                    rt_kprintf("no node list\n");
-                    return -1;
-                }
-                rt_list_t *pos;
+                int n = 0;
                 int found = 0;
-                rt_enter_critical();
-                rt_list_for_each(pos, &_orb_node_list)
+                orb_node_stat_t *stats = uorb_cli_snapshot(&n);
+                for (int i = 0; stats && i < n; i++)
                 {
-                    orb_node_t *node = rt_list_entry(pos, orb_node_t, list);
-                    if (node->meta == meta && node->instance == inst)
+                    const orb_node_stat_t *st = &stats[i];
+                    if (st->meta == meta && st->instance == inst)
                     {
                         rt_kprintf("node=%s[%d] q=%d gen=%u subs=%d adv=%d valid=%d size=%d [no device]\n",
-                                   node->meta->o_name,
-                                   node->instance,
-                                   node->queue_size,
-                                   (unsigned)node->generation,
-                                   node->subscriber_count,
-                                   node->advertised,
-                                   node->data_valid,
-                                   node->meta->o_size);
+                                   st->meta->o_name,
+                                   st->instance,
+                                   st->queue_size,
+                                   (unsigned)st->generation,
+                                   st->subscriber_count,
+                                   st->advertised,
+                                   st->data_valid,
+                                   st->meta->o_size);
                         found = 1;
                         break;
                     }
                 }
-                rt_exit_critical();
+                rt_free(stats);
                 if (!found)
                 {
                     rt_kprintf("node not found: %s[%d]\n", topic, inst);
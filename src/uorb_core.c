@@ -7,6 +7,8 @@
 #include "uORB.h"
 #include "uorb_device_node.h"
 #include "uorb_internal.h"
+#include "uorb_fields.h"
+#include "uorb_trace.h"
 #include <rtthread.h>
 
 /*
@@ -15,7 +17,7 @@
  *  - orb_advertise / orb_advertise_queue / orb_advertise_multi
  *  - orb_subscribe（基于 orb_subscribe_multi(…, 0)）
  *  - orb_exists / orb_group_count
- *  - orb_set_interval / orb_get_interval
+ *  - orb_set_interval / orb_get_interval（另有微秒精度与按消息时间戳节流的扩展）
  */
 
 /* -------------------------------------- */
@@ -57,15 +59,11 @@ int orb_exists(const struct orb_metadata *meta, int instance)
 
 int orb_group_count(const struct orb_metadata *meta)
 {
-    int count = 0;
-    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    if (!meta)
     {
-        if (orb_node_exists(meta, i))
-        {
-            count++;
-        }
+        return 0;
     }
-    return count;
+    return orb_node_group_count(meta);
 }
 
 /* -------------------------------------- */
@@ -78,8 +76,16 @@ int orb_set_interval(orb_subscr_t sub, unsigned interval)
     {
         return -RT_EINVAL;
     }
-    sub->interval = interval;
-    return RT_EOK;
+    if (interval > RT_UINT32_MAX / 1000u)
+    {
+        return -RT_EINVAL;
+    }
+    int ret = orb_set_interval_us(sub, (rt_uint32_t)interval * 1000u);
+    if (ret == RT_EOK)
+    {
+        sub->interval = interval;
+    }
+    return ret;
 }
 
 int orb_get_interval(orb_subscr_t sub, unsigned *interval)
@@ -92,6 +98,64 @@ int orb_get_interval(orb_subscr_t sub, unsigned *interval)
     return RT_EOK;
 }
 
+int orb_set_interval_us(orb_subscr_t sub, rt_uint32_t interval_us)
+{
+    if (!sub)
+    {
+        return -RT_EINVAL;
+    }
+    /* 换算放在设置阶段，orb_check() 只做一次减法比较 */
+    sub->interval_us  = interval_us;
+    sub->interval_clk = uorb_clock_from_us(interval_us);
+    sub->interval     = interval_us / 1000u;
+    sub->last_update  = 0;
+    sub->last_ts      = 0;
+    orb_node_refresh_rate(sub->node);
+    return RT_EOK;
+}
+
+int orb_get_interval_us(orb_subscr_t sub, rt_uint32_t *interval_us)
+{
+    if (!sub || !interval_us)
+    {
+        return -RT_EINVAL;
+    }
+    *interval_us = sub->interval_us;
+    return RT_EOK;
+}
+
+int orb_set_interval_by_timestamp(orb_subscr_t sub, rt_bool_t enable)
+{
+    /* 字段偏移取自订阅自身的元数据：发布者尚未出现时也可设置，
+     * 之后 orb_node_ready 绑定节点时会按 ts_offset 刷新发布端限速 */
+    if (!sub)
+    {
+        return -RT_EINVAL;
+    }
+    if (!enable)
+    {
+        sub->ts_offset = -1;
+        sub->last_update = 0;
+        orb_node_refresh_rate(sub->node);
+        return RT_EOK;
+    }
+
+    uorb_field_desc_t f;
+    int ret = uorb_fields_find(sub->meta, "timestamp", &f);
+    if (ret != RT_EOK)
+    {
+        return -RT_ENOENT;
+    }
+    if (f.type != UORB_FIELD_UINT64 || f.count != 1)
+    {
+        return -RT_ENOENT;
+    }
+    sub->ts_offset = (rt_int16_t)f.offset;
+    sub->last_ts   = 0;
+    orb_node_refresh_rate(sub->node);
+    return RT_EOK;
+}
+
 int orb_wait(orb_subscr_t handle, int timeout_ms)
 {
     /* 事件化实现：优先事件等待，其次轮询退避 */
@@ -114,25 +178,49 @@ int orb_wait(orb_subscr_t handle, int timeout_ms)
     if (handle->node && handle->node->notifier.event)
     {
         int waited = 0;
-        int step = 10;
+        /* 过滤订阅有独占的通知器，不会被其他等待者清掉事件，整段等待即可，只在匹配时被唤醒 */
+        int step = handle->filter ? timeout_ms : 10;
+        const rt_tick_t start = rt_tick_get();
+        UORB_TRACE(UORB_TRACE_WAIT, handle->node->id, handle->node->generation);
         while (1)
         {
             int slice = step;
             if (timeout_ms >= 0)
             {
                 int remain = timeout_ms - waited;
-                if (remain <= 0) return -RT_ETIMEOUT;
+                if (remain <= 0)
+                {
+                    UORB_TRACE(UORB_TRACE_WAKE, handle->node->id, handle->node->generation);
+                    return -RT_ETIMEOUT;
+                }
                 if (remain < step) slice = remain;
             }
-            (void)uorb_notifier_wait(&handle->node->notifier, slice);
+            if (handle->filter)
+            {
+                (void)uorb_notifier_wait(&handle->filter->notifier, slice);
+            }
+            else
+#ifdef UORB_USING_SHM
+            if (handle->node->shm)
+            {
+                /* 共享节点：在共享代数上 futex 等待，其他进程的发布也能唤醒 */
+                uorb_shm_wait(handle->node, handle->generation, slice);
+            }
+            else
+#endif
+            {
+                (void)uorb_notifier_wait(&handle->node->notifier, slice);
+            }
             (void)orb_check(handle, &updated);
             if (updated)
             {
+                UORB_TRACE(UORB_TRACE_WAKE, handle->node->id, handle->node->generation);
                 return RT_EOK;
             }
             if (timeout_ms >= 0)
             {
-                waited += slice;
+                /* 过滤订阅可能被已消费匹配留下的事件提前唤醒，按实际经过时间计 */
+                waited = handle->filter ? (int)((rt_tick_get() - start) * 1000 / RT_TICK_PER_SECOND) : waited + slice;
             }
         }
     }
@@ -0,0 +1,283 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_defer.h"
+#include "uorb_device_node.h"
+#include <rtthread.h>
+
+#ifdef UORB_USING_DEFERRED_PUBLISH
+
+#define DBG_TAG "uorb.defer"
+#define DBG_LVL DBG_WARNING
+#include <rtdbg.h>
+
+#if (UORB_DEFER_QUEUE_SIZE & (UORB_DEFER_QUEUE_SIZE - 1)) != 0
+#error "UORB_DEFER_QUEUE_SIZE must be a power of two"
+#endif
+
+#define DEFER_MASK (UORB_DEFER_QUEUE_SIZE - 1)
+
+/*
+ * 有界 MPSC 队列（每槽一个序号）：槽序号等于 pos 时可写，生产者以 CAS 推进 tail 占位，
+ * 写完消息后把序号置为 pos + 1 发布；消费者看到 pos + 1 才读取，读完置为 pos + 队列长度
+ * 交还给下一轮生产者。生产者之间、生产者与消费者之间都不加锁。
+ */
+struct defer_slot
+{
+    rt_uint32_t seq;
+    orb_node_t *node;
+    rt_uint64_t payload[(UORB_DEFER_SLOT_SIZE + 7) / 8];
+};
+
+struct defer_queue
+{
+    rt_uint32_t       tail; /* 生产者占位位置 */
+    rt_uint32_t       head; /* 消费者位置，只由投递线程修改 */
+    struct defer_slot slot[UORB_DEFER_QUEUE_SIZE];
+};
+
+static struct defer_queue _dq[UORB_CPUS_NR];
+static rt_sem_t           _dq_sem;
+static rt_thread_t        _dq_thread;
+static volatile rt_bool_t _dq_ready;
+static rt_bool_t          _dq_started;
+static rt_uint32_t        _dq_sleeping; /* 投递线程即将或正在等待信号量 */
+static orb_defer_stat_t   _dq_stat;
+
+int uorb_defer_enqueue(orb_node_t *node, const void *data)
+{
+    struct defer_queue *q   = &_dq[uorb_cpu_id()];
+    rt_uint32_t         pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+    struct defer_slot  *slot;
+
+    while (1)
+    {
+        slot = &q->slot[pos & DEFER_MASK];
+        rt_uint32_t seq  = __atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE);
+        rt_int32_t  diff = (rt_int32_t)(seq - pos);
+        if (diff == 0)
+        {
+            if (__atomic_compare_exchange_n(&q->tail, &pos, pos + 1, RT_TRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+            {
+                break;
+            }
+        }
+        else if (diff < 0)
+        {
+            /* 消费者还没交还该槽：队列满 */
+            __atomic_add_fetch(&_dq_stat.dropped, 1, __ATOMIC_RELAXED);
+            return -RT_EFULL;
+        }
+        else
+        {
+            pos = __atomic_load_n(&q->tail, __ATOMIC_RELAXED);
+        }
+    }
+
+    slot->node = node;
+    rt_memcpy(slot->payload, data, node->meta->o_size);
+    __atomic_store_n(&slot->seq, pos + 1, __ATOMIC_RELEASE);
+
+    rt_uint32_t depth = pos + 1 - __atomic_load_n(&q->head, __ATOMIC_RELAXED);
+    if (depth > __atomic_load_n(&_dq_stat.max_depth, __ATOMIC_RELAXED))
+    {
+        __atomic_store_n(&_dq_stat.max_depth, depth, __ATOMIC_RELAXED);
+    }
+    __atomic_add_fetch(&_dq_stat.enqueued, 1, __ATOMIC_RELAXED);
+
+    /* 与投递线程的“置睡眠标志后复查队列”配对：只有它可能错过本条时才唤醒 */
+    __atomic_thread_fence(__ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&_dq_sleeping, __ATOMIC_RELAXED) && __atomic_exchange_n(&_dq_sleeping, 0, __ATOMIC_ACQ_REL))
+    {
+        rt_sem_release(_dq_sem);
+    }
+    return RT_EOK;
+}
+
+/* 取出一个 CPU 队列中已发布的消息并投递；返回处理的条数 */
+static int defer_drain(struct defer_queue *q)
+{
+    int n = 0;
+    while (1)
+    {
+        struct defer_slot *slot = &q->slot[q->head & DEFER_MASK];
+        if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) != q->head + 1)
+        {
+            /* 空，或生产者已占位尚未写完（写完后会唤醒本线程） */
+            return n;
+        }
+        if (slot->node && slot->node->advertised)
+        {
+            orb_node_publish(slot->node, slot->payload);
+        }
+        __atomic_store_n(&slot->seq, q->head + UORB_DEFER_QUEUE_SIZE, __ATOMIC_RELEASE);
+        __atomic_store_n(&q->head, q->head + 1, __ATOMIC_RELEASE);
+        __atomic_add_fetch(&_dq_stat.delivered, 1, __ATOMIC_RELAXED);
+        n++;
+    }
+}
+
+static rt_bool_t defer_empty(void)
+{
+    for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+    {
+        struct defer_queue *q = &_dq[cpu];
+        if (__atomic_load_n(&q->slot[q->head & DEFER_MASK].seq, __ATOMIC_ACQUIRE) == q->head + 1)
+        {
+            return RT_FALSE;
+        }
+    }
+    return RT_TRUE;
+}
+
+static void defer_entry(void *param)
+{
+    (void)param;
+    while (1)
+    {
+        int n = 0;
+        for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+        {
+            n += defer_drain(&_dq[cpu]);
+        }
+        if (n > 0)
+        {
+            continue;
+        }
+
+        __atomic_store_n(&_dq_sleeping, 1, __ATOMIC_RELAXED);
+        __atomic_thread_fence(__ATOMIC_SEQ_CST);
+        if (defer_empty())
+        {
+            rt_sem_take(_dq_sem, RT_WAITING_FOREVER);
+        }
+        else if (!__atomic_exchange_n(&_dq_sleeping, 0, __ATOMIC_ACQ_REL))
+        {
+            /* 生产者已清标志并释放了信号量，消耗掉以免下次空转 */
+            rt_sem_take(_dq_sem, RT_WAITING_FOREVER);
+        }
+    }
+}
+
+/* 初始化队列并启动投递线程；可重复调用 */
+static int uorb_defer_init(void)
+{
+    orb_registry_lock();
+    rt_bool_t claim = !_dq_started;
+    _dq_started     = RT_TRUE;
+    orb_registry_unlock();
+
+    if (!claim)
+    {
+        while (!_dq_ready && _dq_started)
+        {
+            rt_thread_mdelay(1);
+        }
+        return _dq_ready ? RT_EOK : -RT_ENOMEM;
+    }
+
+    for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+    {
+        for (rt_uint32_t i = 0; i < UORB_DEFER_QUEUE_SIZE; i++)
+        {
+            _dq[cpu].slot[i].seq = i;
+        }
+    }
+    _dq_sem    = rt_sem_create("uorb_dq", 0, RT_IPC_FLAG_PRIO);
+    _dq_thread = _dq_sem ? rt_thread_create("uorb_dq", defer_entry, RT_NULL, UORB_DEFER_THREAD_STACK,
+                                            UORB_DEFER_THREAD_PRIORITY, 10) :
+                           RT_NULL;
+    if (!_dq_thread)
+    {
+        LOG_E("delivery thread create failed");
+        if (_dq_sem)
+        {
+            rt_sem_delete(_dq_sem);
+            _dq_sem = RT_NULL;
+        }
+        _dq_started = RT_FALSE;
+        return -RT_ENOMEM;
+    }
+    _dq_ready = RT_TRUE;
+    rt_thread_startup(_dq_thread);
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(uorb_defer_init);
+
+int orb_set_publish_deferred(orb_advert_t handle, rt_bool_t enable)
+{
+    if (!handle || handle->meta->o_size > UORB_DEFER_SLOT_SIZE)
+    {
+        return -RT_EINVAL;
+    }
+    if (orb_node_is_shm(handle))
+    {
+        return -RT_ENOSYS;
+    }
+    if (enable && !_dq_ready && uorb_defer_init() != RT_EOK)
+    {
+        return -RT_ENOMEM;
+    }
+    handle->deferred = enable;
+    return RT_EOK;
+}
+
+int orb_defer_get_stat(orb_defer_stat_t *stat)
+{
+    if (!stat)
+    {
+        return -RT_EINVAL;
+    }
+    stat->enqueued  = __atomic_load_n(&_dq_stat.enqueued, __ATOMIC_RELAXED);
+    stat->delivered = __atomic_load_n(&_dq_stat.delivered, __ATOMIC_RELAXED);
+    stat->dropped   = __atomic_load_n(&_dq_stat.dropped, __ATOMIC_RELAXED);
+    stat->max_depth = __atomic_load_n(&_dq_stat.max_depth, __ATOMIC_RELAXED);
+    return RT_EOK;
+}
+
+void uorb_defer_forget(orb_node_t *node)
+{
+    if (!_dq_ready)
+    {
+        return;
+    }
+
+    if (rt_thread_self() == _dq_thread)
+    {
+        /* 在投递回调中删除节点：不能等待自身，把队列中指向该节点的消息作废。
+         * 已发布的槽只有投递线程会读写 node，这里无需与生产者同步 */
+        for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+        {
+            struct defer_queue *q    = &_dq[cpu];
+            rt_uint32_t         tail = __atomic_load_n(&q->tail, __ATOMIC_ACQUIRE);
+            for (rt_uint32_t pos = q->head; pos != tail; pos++)
+            {
+                struct defer_slot *slot = &q->slot[pos & DEFER_MASK];
+                if (__atomic_load_n(&slot->seq, __ATOMIC_ACQUIRE) == pos + 1 && slot->node == node)
+                {
+                    slot->node = RT_NULL;
+                }
+            }
+        }
+        return;
+    }
+
+    /* 等投递线程越过此刻之前入队的全部消息（节点已标记为未公告，这些消息会被跳过） */
+    rt_uint32_t tail[UORB_CPUS_NR];
+    for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+    {
+        tail[cpu] = __atomic_load_n(&_dq[cpu].tail, __ATOMIC_ACQUIRE);
+    }
+    for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+    {
+        while ((rt_int32_t)(tail[cpu] - __atomic_load_n(&_dq[cpu].head, __ATOMIC_ACQUIRE)) > 0)
+        {
+            rt_thread_mdelay(1);
+        }
+    }
+}
+
+#endif /* UORB_USING_DEFERRED_PUBLISH */
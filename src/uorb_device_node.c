@@ -12,6 +12,8 @@
 #include <stdbool.h>
 #include <rtthread.h>
 #include "uorb_device_node.h"
+#include "uorb_trace.h"
+#include "uorb_fields.h"
 #ifdef UORB_REGISTER_AS_DEVICE
 #include "uorb_device_if.h"
 #endif
@@ -20,16 +22,139 @@
 rt_list_t _orb_node_list;
 rt_bool_t _orb_node_list_initialized = RT_FALSE;
 
+/* 注册表锁：仅保护节点链表本身；发布/读取只使用各节点自己的锁，SMP 下不同主题互不串行 */
+static struct rt_spinlock _orb_registry_lock;
+
+/* 主题组：同一 meta 的全部实例，按 meta 指针散列。
+ * 查找节点与分配实例只访问组内固定大小的数组，与系统中节点总数无关；
+ * 节点链表仍保留给 CLI 等遍历场景。组随最后一个节点删除而释放。 */
+typedef struct orb_group_s
+{
+    struct orb_group_s        *next;
+    const struct orb_metadata *meta;
+    rt_uint32_t                advertised;     /* 已公告实例位图：计数与首个实例查询为 O(1) */
+    rt_uint32_t                present;        /* 已有节点的实例位图：组是否为空为 O(1) */
+    orb_node_t                *nodes[ORB_MULTI_MAX_INSTANCES];
+} orb_group_t;
+
+#define ORB_GROUP_HASH_BITS 4
+#define ORB_GROUP_BUCKETS   (1U << ORB_GROUP_HASH_BITS)
+
+static orb_group_t *_orb_groups[ORB_GROUP_BUCKETS];
+
+/* 节点序号，在注册表锁内递增；0 保留为无效值 */
+static rt_uint32_t _orb_node_seq;
+
+/* 内存统计：各类别当前/峰值字节数，在注册表锁内更新 */
+#ifndef UORB_MEM_BUDGET
+#define UORB_MEM_BUDGET 0
+#endif
+static orb_mem_stat_t _orb_mem = {.budget = UORB_MEM_BUDGET};
+
 // 初始化节点列表
 static void orb_node_list_init(void)
 {
     if (!_orb_node_list_initialized)
     {
+        rt_spin_lock_init(&_orb_registry_lock);
         rt_list_init(&_orb_node_list);
         _orb_node_list_initialized = RT_TRUE;
     }
 }
 
+void orb_registry_lock(void)
+{
+    orb_node_list_init();
+    rt_spin_lock(&_orb_registry_lock);
+}
+
+void orb_registry_unlock(void)
+{
+    rt_spin_unlock(&_orb_registry_lock);
+}
+
+/* 需持有注册表锁；bytes 为负表示释放 */
+static void orb_mem_charge_locked(int category, rt_ssize_t bytes)
+{
+    _orb_mem.current[category] += bytes;
+    _orb_mem.total             += bytes;
+    if (_orb_mem.current[category] > _orb_mem.peak[category])
+    {
+        _orb_mem.peak[category] = _orb_mem.current[category];
+    }
+    if (_orb_mem.total > _orb_mem.total_peak)
+    {
+        _orb_mem.total_peak = _orb_mem.total;
+    }
+}
+
+static void orb_mem_charge(int category, rt_ssize_t bytes)
+{
+    orb_registry_lock();
+    orb_mem_charge_locked(category, bytes);
+    orb_registry_unlock();
+}
+
+static inline rt_uint32_t orb_group_hash(const struct orb_metadata *meta)
+{
+    return ((rt_uint32_t)((rt_ubase_t)meta >> 3) * 2654435761U) >> (32 - ORB_GROUP_HASH_BITS);
+}
+
+/* 需持有注册表锁 */
+static orb_group_t *orb_group_find_locked(const struct orb_metadata *meta)
+{
+    orb_group_t *group = _orb_groups[orb_group_hash(meta)];
+    while (group && group->meta != meta)
+    {
+        group = group->next;
+    }
+    return group;
+}
+
+static inline int orb_popcount32(rt_uint32_t v)
+{
+    v = v - ((v >> 1) & 0x55555555U);
+    v = (v & 0x33333333U) + ((v >> 2) & 0x33333333U);
+    return (int)((((v + (v >> 4)) & 0x0F0F0F0FU) * 0x01010101U) >> 24);
+}
+
+/* 需持有注册表锁：节点取消公告时清除组内位图 */
+static void orb_group_clear_advertised_locked(orb_node_t *node)
+{
+    orb_group_t *group = orb_group_find_locked(node->meta);
+    if (group && node->instance < ORB_MULTI_MAX_INSTANCES && group->nodes[node->instance] == node)
+    {
+        group->advertised &= ~(1U << node->instance);
+    }
+}
+
+/* 需持有注册表锁；节点已从链表摘除。组变空时从散列表摘除并返回，由调用方在锁外释放 */
+static orb_group_t *orb_group_detach_locked(orb_node_t *node)
+{
+    orb_group_t *group = orb_group_find_locked(node->meta);
+    if (!group || node->instance >= ORB_MULTI_MAX_INSTANCES || group->nodes[node->instance] != node)
+    {
+        return RT_NULL;
+    }
+
+    /* 每个实例只有一个节点（orb_node_create 不产生重复节点），腾出槽位即可 */
+    group->nodes[node->instance] = RT_NULL;
+    group->present &= ~(1U << node->instance);
+    group->advertised &= ~(1U << node->instance);
+    if (group->present)
+    {
+        return RT_NULL;
+    }
+
+    orb_group_t **pp = &_orb_groups[orb_group_hash(group->meta)];
+    while (*pp != group)
+    {
+        pp = &(*pp)->next;
+    }
+    *pp = group->next;
+    return group;
+}
+
 // Determine the data range
 static inline bool is_in_range(unsigned left, unsigned value, unsigned right)
 {
@@ -97,11 +222,204 @@ static int get_default_queue_len(const struct orb_metadata *meta)
     return (v > 0 && v <= 255) ? v : -1;
 }
 
+/* 节点实际使用的队列长度：queue_size=0 时取主题默认队列长度（若配置），否则为1 */
+static rt_uint8_t orb_node_queue_len(const struct orb_metadata *meta, rt_uint8_t queue_size)
+{
+    if (queue_size == 0)
+    {
+        int defq   = get_default_queue_len(meta);
+        queue_size = (defq > 0) ? (rt_uint8_t)defq : 1;
+    }
+    return round_pow_of_two_8(queue_size);
+}
+
 static int get_default_instances(const struct orb_metadata *meta)
 {
     if (!meta || !meta->o_fields) return -1;
     int v = parse_meta_value(meta->o_fields, "instances");
-    return (v > 0 && v <= ORB_MULTI_MAX_INSTANCES) ? v : -1;
+    if (v <= 0)
+    {
+        return -1;
+    }
+    /* 主题声明的实例数超出编译期上限时按上限处理 */
+    return (v > ORB_MULTI_MAX_INSTANCES) ? ORB_MULTI_MAX_INSTANCES : v;
+}
+
+/*
+ * 计算发布端生效间隔：取发布方声明值与自动推导值中较大者。
+ * 自动模式下只有当全部消费者都是按本地时钟节流的订阅者时才取最快订阅者间隔；
+ * 存在回调、未节流或按消息时间戳节流的订阅者时不做自动限速，避免它们丢样。
+ * 调用方需持有 node->lock。
+ */
+static void orb_node_refresh_rate_locked(orb_node_t *node)
+{
+    rt_uint32_t us = node->pub_interval_us;
+
+    if (node->auto_rate && rt_list_isempty(&node->callbacks))
+    {
+        rt_uint32_t fastest = RT_UINT32_MAX;
+        int         n       = 0;
+        rt_list_t  *pos;
+        rt_list_for_each(pos, &node->subscribers)
+        {
+            orb_subscribe_t *sub = rt_list_entry(pos, orb_subscribe_t, node_entry);
+            if (sub->interval_us == 0 || sub->ts_offset >= 0)
+            {
+                fastest = 0;
+                break;
+            }
+            if (sub->interval_us < fastest)
+            {
+                fastest = sub->interval_us;
+            }
+            n++;
+        }
+        /* subscriber_count 还包含回调等非订阅者引用 */
+        if (n > 0 && n == node->subscriber_count && fastest > us)
+        {
+            us = fastest;
+        }
+    }
+
+    node->pub_interval_clk = uorb_clock_from_us(us);
+}
+
+void orb_node_refresh_rate(orb_node_t *node)
+{
+    if (!node)
+    {
+        return;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    orb_node_refresh_rate_locked(node);
+    rt_spin_unlock_irqrestore(&node->lock, level);
+}
+
+/* 判断本次发布是否应被丢弃；未配置限速/抽取时只有两次读比较 */
+static rt_bool_t orb_node_suppress(orb_node_t *node)
+{
+    if (node->pub_interval_clk == 0 && node->decimation <= 1)
+    {
+        return RT_FALSE;
+    }
+
+    rt_bool_t drop  = RT_FALSE;
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+
+    if (node->decimation > 1)
+    {
+        drop = (node->decim_count != 0);
+        if (++node->decim_count >= node->decimation)
+        {
+            node->decim_count = 0;
+        }
+    }
+
+    if (!drop && node->pub_interval_clk != 0)
+    {
+        uorb_clock_t now     = uorb_clock_now();
+        uorb_clock_t elapsed = now - node->last_pub;
+        if (node->last_pub != 0 && elapsed < node->pub_interval_clk)
+        {
+            drop = RT_TRUE;
+        }
+        else if (node->last_pub != 0 && elapsed < 2 * node->pub_interval_clk)
+        {
+            /* 与订阅端一致：基准按周期推进，避免放行时刻逐次漂移 */
+            node->last_pub += node->pub_interval_clk;
+        }
+        else
+        {
+            node->last_pub = now;
+        }
+    }
+
+    if (drop)
+    {
+        node->suppressed++;
+    }
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return drop;
+}
+
+/* 逐机器字比较（异或累积，编译器可向量化），不足一字的尾部逐字节比较 */
+static rt_bool_t orb_mem_equal(const rt_uint8_t *a, const rt_uint8_t *b, rt_size_t len)
+{
+    rt_ubase_t diff = 0;
+    for (; len >= sizeof(rt_ubase_t); len -= sizeof(rt_ubase_t))
+    {
+        rt_ubase_t x, y;
+        memcpy(&x, a, sizeof(x));
+        memcpy(&y, b, sizeof(y));
+        diff |= x ^ y;
+        a += sizeof(rt_ubase_t);
+        b += sizeof(rt_ubase_t);
+    }
+    while (len--)
+    {
+        diff |= (rt_ubase_t)(*a++ ^ *b++);
+    }
+    return diff == 0;
+}
+
+/* 比较两条消息，跳过 skip 处的 8 字节 timestamp（skip 为 -1 时整体比较） */
+static rt_bool_t orb_msg_equal(const rt_uint8_t *a, const rt_uint8_t *b, rt_size_t size, rt_int16_t skip)
+{
+    if (skip < 0 || (rt_size_t)skip + sizeof(rt_uint64_t) > size)
+    {
+        return orb_mem_equal(a, b, size);
+    }
+    const rt_size_t tail = (rt_size_t)skip + sizeof(rt_uint64_t);
+    return orb_mem_equal(a, b, (rt_size_t)skip) && orb_mem_equal(a + tail, b + tail, size - tail);
+}
+
+/*
+ * 变化发布：内容与最新一条相同且未到心跳间隔时丢弃（计入 suppressed）。
+ * 比较在数据锁内进行，长度取 o_size_no_padding，不比较尾部填充。
+ */
+static rt_bool_t orb_node_unchanged(orb_node_t *node, const void *data)
+{
+    if (!node->on_change || orb_node_is_shm(node))
+    {
+        return RT_FALSE;
+    }
+
+    const struct orb_metadata *meta = node->meta;
+    const rt_size_t            size = (meta->o_size_no_padding && meta->o_size_no_padding <= meta->o_size) ?
+                                          meta->o_size_no_padding :
+                                          meta->o_size;
+    const uorb_clock_t now  = uorb_clock_now();
+    rt_bool_t          same = RT_FALSE;
+    rt_base_t          level = rt_spin_lock_irqsave(&node->lock);
+
+    if (node->data_valid && node->data)
+    {
+        const rt_uint8_t *last = node->data + meta->o_size * ((node->generation - 1) % node->queue_size);
+        same = orb_msg_equal(last, (const rt_uint8_t *)data, size, node->change_ts_offset);
+        if (same && node->heartbeat_clk != 0 && now - node->last_accept >= node->heartbeat_clk)
+        {
+            same = RT_FALSE;
+        }
+    }
+
+    if (same)
+    {
+        node->suppressed++;
+    }
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return same;
+}
+
+/* 消息确定放行后才推进心跳基准（限速/抽取丢弃的消息不算放行） */
+static void orb_node_accept(orb_node_t *node)
+{
+    if (!node->on_change)
+    {
+        return;
+    }
+    rt_base_t level   = rt_spin_lock_irqsave(&node->lock);
+    node->last_accept = uorb_clock_now();
+    rt_spin_unlock_irqrestore(&node->lock, level);
 }
 
 orb_node_t *orb_node_create(const struct orb_metadata *meta, const rt_uint8_t instance, rt_uint8_t queue_size)
@@ -110,11 +428,9 @@ orb_node_t *orb_node_create(const struct orb_metadata *meta, const rt_uint8_t in
 
     orb_node_list_init(); // Ensure list is initialized
 
-    /* 当调用方给出 queue_size=0 时，使用主题的默认队列长度（若配置），否则回退为1 */
-    if (queue_size == 0)
+    if (instance >= ORB_MULTI_MAX_INSTANCES)
     {
-        int defq = get_default_queue_len(meta);
-        queue_size = (defq > 0) ? (rt_uint8_t)defq : 1;
+        return RT_NULL;
     }
 
     orb_node_t *node = (orb_node_t *)rt_calloc(sizeof(orb_node_t), 1);
@@ -125,7 +441,7 @@ orb_node_t *orb_node_create(const struct orb_metadata *meta, const rt_uint8_t in
 
     node->meta             = meta;
     node->instance         = instance;
-    node->queue_size       = round_pow_of_two_8(queue_size);
+    node->queue_size       = orb_node_queue_len(meta, queue_size);
     node->generation       = 0;
     node->advertised       = 0;
     node->subscriber_count = 0;
@@ -133,14 +449,87 @@ orb_node_t *orb_node_create(const struct orb_metadata *meta, const rt_uint8_t in
     node->data             = RT_NULL;
     // Initialize callbacks list
     rt_list_init(&node->callbacks);
+    rt_list_init(&node->filters);
+    rt_spin_lock_init(&node->lock);
+    rt_spin_lock_init(&node->cb_lock);
     node->dev_min_interval = 0;
     node->last_dev_read    = 0;
     node->pending_delete   = RT_FALSE;
+    node->priority         = ORB_PRIO_DEFAULT;
+    rt_list_init(&node->subscribers);
+#ifdef UORB_USING_ISR_PUBLISH
+    rt_list_init(&node->isr_entry);
+#endif
 
     /* 初始化事件通知器 */
     uorb_notifier_init(&node->notifier, "uorb_evt");
 
+#ifdef UORB_USING_SHM
+    /* 已连接共享内存段时，环形缓冲与代数放在共享主题项中 */
+    uorb_shm_bind(node);
+#endif
+
+    /* 主题组在锁外分配：加锁后若已被其他线程创建则丢弃备用块 */
+    orb_group_t *spare = RT_NULL;
+    orb_registry_lock();
+    orb_group_t *group = orb_group_find_locked(meta);
+    if (!group)
+    {
+        orb_registry_unlock();
+        spare = (orb_group_t *)rt_calloc(1, sizeof(orb_group_t));
+        if (!spare)
+        {
+            uorb_notifier_deinit(&node->notifier);
+            rt_free(node);
+            return RT_NULL;
+        }
+        orb_registry_lock();
+        group = orb_group_find_locked(meta);
+        if (!group)
+        {
+            rt_uint32_t bucket = orb_group_hash(meta);
+            group              = spare;
+            spare              = RT_NULL;
+            orb_mem_charge_locked(ORB_MEM_GROUP, sizeof(orb_group_t));
+            group->meta        = meta;
+            group->next        = _orb_groups[bucket];
+            _orb_groups[bucket] = group;
+        }
+    }
+    orb_node_t *existing = group->nodes[instance];
+    if (existing)
+    {
+        /* 并发创建了同一实例：沿用已登记的节点，丢弃本线程新建的节点 */
+        orb_registry_unlock();
+        if (spare)
+        {
+            rt_free(spare);
+        }
+        uorb_notifier_deinit(&node->notifier);
+        rt_free(node);
+        return existing;
+    }
+    if (++_orb_node_seq == 0)
+    {
+        _orb_node_seq = 1;
+    }
+    node->id = _orb_node_seq;
     rt_list_insert_after(_orb_node_list.prev, &node->list);
+    group->nodes[instance] = node;
+    group->present |= 1U << instance;
+    node->queue_reserved = node->data ? 0 : (rt_uint32_t)meta->o_size * node->queue_size;
+    _orb_mem.reserved += node->queue_reserved;
+    orb_mem_charge_locked(ORB_MEM_NODE, sizeof(orb_node_t));
+    if (node->notifier.event)
+    {
+        orb_mem_charge_locked(ORB_MEM_EVENT, sizeof(struct rt_event));
+    }
+    orb_registry_unlock();
+
+    if (spare)
+    {
+        rt_free(spare);
+    }
 
     // 注册设备
     // char name[RT_NAME_MAX];
@@ -158,21 +547,61 @@ rt_err_t orb_node_delete(orb_node_t *node)
     }
 
     node->advertised = false;
+#ifdef UORB_USING_SHM
+    uorb_shm_advertise(node, RT_FALSE);
+#endif
+#ifdef UORB_USING_ISR_PUBLISH
+    uorb_isr_forget(node);
+#endif
+#ifdef UORB_USING_DEFERRED_PUBLISH
+    uorb_defer_forget(node);
+#endif
 
-    // 从链表中移除
+    // 从链表与主题组中移除
+    orb_registry_lock();
+    orb_group_clear_advertised_locked(node);
     rt_list_remove(&node->list);
-    
-    // 释放data内存
+    orb_group_t *empty = orb_group_detach_locked(node);
+    /* 延迟删除的节点会再次进入这里：只扣除仍持有的部分 */
+    rt_bool_t release = (node->subscriber_count == 0);
+    if (empty)
+    {
+        orb_mem_charge_locked(ORB_MEM_GROUP, -(rt_ssize_t)sizeof(orb_group_t));
+    }
+    if (node->data && !orb_node_is_shm(node))
+    {
+        orb_mem_charge_locked(ORB_MEM_QUEUE, -(rt_ssize_t)(node->meta->o_size * node->queue_size));
+    }
+    if (node->notifier.event)
+    {
+        orb_mem_charge_locked(ORB_MEM_EVENT, -(rt_ssize_t)sizeof(struct rt_event));
+    }
+    if (release)
+    {
+        orb_mem_charge_locked(ORB_MEM_NODE, -(rt_ssize_t)sizeof(orb_node_t));
+    }
+    _orb_mem.reserved    -= node->queue_reserved;
+    node->queue_reserved  = 0;
+    orb_registry_unlock();
+    if (empty)
+    {
+        rt_free(empty);
+    }
+
+    // 释放data内存（共享环形缓冲随共享段存在，不释放）
     if (node->data)
     {
-        rt_free(node->data);
+        if (!orb_node_is_shm(node))
+        {
+            rt_free(node->data);
+        }
         node->data = RT_NULL;
     }
 
     // 释放事件通知器
     uorb_notifier_deinit(&node->notifier);
 
-    if (node->subscriber_count == 0)
+    if (release)
     {
         rt_free(node);
     }
@@ -188,26 +617,45 @@ rt_err_t orb_node_delete(orb_node_t *node)
 
 orb_node_t *orb_node_find(const struct orb_metadata *meta, int instance)
 {
-    orb_node_list_init(); // Ensure list is initialized
-    
-    // 遍历_node_list
-    rt_list_t  *pos;
-    orb_node_t *node;
-
-    rt_enter_critical();
-    rt_list_for_each(pos, &_orb_node_list)
+    if (instance < 0 || instance >= ORB_MULTI_MAX_INSTANCES)
     {
-        node = rt_list_entry(pos, orb_node_t, list);
-        if (node->meta == meta && node->instance == instance)
-        {
-            rt_exit_critical();
-            return node;
-        }
+        return RT_NULL;
     }
-    rt_exit_critical();
 
+    // 按 meta 散列定位主题组，再按实例号直接索引
+    orb_registry_lock();
+    orb_group_t *group = orb_group_find_locked(meta);
+    orb_node_t  *node  = group ? group->nodes[instance] : RT_NULL;
+    orb_registry_unlock();
+
+    return node;
+}
+
+int orb_node_group_count(const struct orb_metadata *meta)
+{
+    orb_registry_lock();
+    orb_group_t *group = orb_group_find_locked(meta);
+    int          count = group ? orb_popcount32(group->advertised) : 0;
+    orb_registry_unlock();
+
+    return count;
+}
+
+orb_node_t *orb_node_find_first(const struct orb_metadata *meta)
+{
+    orb_node_t *node = RT_NULL;
+
+    /* 优先已公告的最小实例，否则回退实例0 */
+    orb_registry_lock();
+    orb_group_t *group = orb_group_find_locked(meta);
+    if (group)
+    {
+        int first = __rt_ffs((int)group->advertised);
+        node      = group->nodes[first > 0 ? first - 1 : 0];
+    }
+    orb_registry_unlock();
 
-    return RT_NULL;
+    return node;
 }
 
 bool orb_node_exists(const struct orb_metadata *meta, int instance)
@@ -232,6 +680,33 @@ bool orb_node_exists(const struct orb_metadata *meta, int instance)
     return false;
 }
 
+rt_uint32_t orb_node_select(rt_uint32_t current, rt_uint32_t cursor, rt_uint8_t queue_size, rt_uint32_t *next)
+{
+    if (queue_size == 1)
+    {
+        *next = current;
+        return 0;
+    }
+
+    // 多队列场景：
+    // 如果订阅者的generation等于当前generation，说明没有新数据，回退一代，防止重复读取
+    if (current == cursor)
+    {
+        cursor--;
+    }
+
+    // 检查cursor是否在合法范围内（即数据是否还在队列中，未被覆盖）
+    // 如果不在范围内，说明数据已被覆盖，只能读取最早可用的数据
+    if (!is_in_range(current - queue_size, cursor, current - 1))
+    {
+        cursor = current - queue_size;
+    }
+
+    // 读取后，generation自增，表示已消费一条数据
+    *next = cursor + 1;
+    return cursor;
+}
+
 int orb_node_read(orb_node_t *node, void *data, rt_uint32_t *generation)
 {
     RT_ASSERT(node != RT_NULL);
@@ -247,37 +722,41 @@ int orb_node_read(orb_node_t *node, void *data, rt_uint32_t *generation)
         return 0;
     }
 
-    // 当前节点的数据代数（generation），每次写入数据时自增
-    const unsigned current_generation = node->generation;
-    unsigned       updated_generation = generation ? (*generation) : current_generation;
+#ifdef UORB_USING_PROFILING
+    const rt_uint64_t t0 = uorb_prof_now();
+#endif
+
+    /* 数据锁只覆盖一次消息拷贝，与其他主题的发布/读取互不影响 */
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
 
+    // 当前节点的数据代数（generation），每次写入数据时自增
+    const rt_uint32_t current_generation = node->generation;
+    rt_uint32_t       updated_generation = generation ? (*generation) : current_generation;
 
-    if (node->queue_size == 1)
+#ifdef UORB_USING_SHM
+    if (node->shm)
     {
-        rt_memcpy(data, node->data, node->meta->o_size);
-        updated_generation = current_generation;
+        /* 共享环形缓冲：其他进程可能正在写入，按顺序锁重试；尚无任何发布时与本地一致返回 0 */
+        if (uorb_shm_read_locked(node, data, updated_generation, &updated_generation) == 0)
+        {
+            rt_spin_unlock_irqrestore(&node->lock, level);
+            return 0;
+        }
     }
     else
+#endif
     {
-        // 多队列场景：
-        // 如果订阅者的generation等于当前generation，说明没有新数据，回退一代，防止重复读取
-        if (current_generation == updated_generation)
-        {
-            updated_generation--;
-        }
-
-        // 检查updated_generation是否在合法范围内（即数据是否还在队列中，未被覆盖）
-        // 如果不在范围内，说明数据已被覆盖，只能读取最早可用的数据
-        if (!is_in_range(current_generation - node->queue_size, updated_generation, current_generation - 1))
-        {
-            updated_generation = current_generation - node->queue_size;
-        }
+        const rt_uint32_t index = orb_node_select(current_generation, updated_generation, node->queue_size, &updated_generation);
+        rt_memcpy(data, node->data + (node->meta->o_size * (index % node->queue_size)), node->meta->o_size);
+    }
 
-        rt_memcpy(data, node->data + (node->meta->o_size * (updated_generation % node->queue_size)), node->meta->o_size);
+    node->bytes_copied += node->meta->o_size;
+#ifdef UORB_USING_PROFILING
+    node->read_time += uorb_prof_since(t0);
+#endif
+    rt_spin_unlock_irqrestore(&node->lock, level);
 
-        // 读取后，generation自增，表示已消费一条数据
-        updated_generation++;
-    }
+    UORB_TRACE(UORB_TRACE_COPY, node->id, updated_generation);
 
     if (generation)
     {
@@ -287,56 +766,299 @@ int orb_node_read(orb_node_t *node, void *data, rt_uint32_t *generation)
     return node->meta->o_size;
 }
 
-int orb_node_write(orb_node_t *node, const void *data)
+/* 以整数读取 p 处的单个元素（ORB_FILTER_BITS 用，p 无需对齐） */
+static rt_uint64_t orb_filter_bits(const rt_uint8_t *p, rt_uint8_t type)
 {
-    RT_ASSERT(node != RT_NULL);
-    
-    // 添加对data参数的NULL检查，返回错误而非断言失败  
-    if (data == RT_NULL)
+    switch (type)
     {
-        return -RT_EINVAL;
+    case UORB_FIELD_INT8:
+    case UORB_FIELD_UINT8:
+    case UORB_FIELD_BOOL:
+        return *p;
+    case UORB_FIELD_INT16:
+    case UORB_FIELD_UINT16:
+    {
+        rt_uint16_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    case UORB_FIELD_INT32:
+    case UORB_FIELD_UINT32:
+    {
+        rt_uint32_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    case UORB_FIELD_INT64:
+    case UORB_FIELD_UINT64:
+    {
+        rt_uint64_t v;
+        memcpy(&v, p, sizeof(v));
+        return v;
+    }
+    default:
+        return 0;
     }
+}
 
-    // create buffer
-    if (!node->data)
+/*
+ * 回调内（派发线程已持有本节点 cb_lock）注册/注销回调或过滤订阅时不再加锁：
+ * cb_lock 不可重入，SMP 下重复加锁即自锁。cb_owner 只会由本线程置为自身，比较无需加锁。
+ */
+static rt_bool_t orb_cb_lock(orb_node_t *node)
+{
+    rt_thread_t self = rt_thread_self();
+    if (self && node->cb_owner == self)
     {
-        const size_t size = node->meta->o_size * node->queue_size;
-        node->data        = rt_calloc(size, 1);
+        return RT_FALSE;
     }
+    rt_spin_lock(&node->cb_lock);
+    return RT_TRUE;
+}
 
-    // buffer invalid
-    if (!node->data)
+static void orb_cb_unlock(orb_node_t *node, rt_bool_t locked)
+{
+    if (locked)
     {
-        return -RT_ERROR;
+        rt_spin_unlock(&node->cb_lock);
     }
+}
 
-    rt_enter_critical();
+/* 持有 cb_lock：摘除回调；派发游标正指向它时先前移，回调内注销自身或其后的回调都不会打断遍历 */
+static void orb_cb_unlink_locked(orb_node_t *node, rt_list_t *entry)
+{
+    if (node->cb_next == entry)
+    {
+        node->cb_next = entry->next;
+    }
+    rt_list_remove(entry);
+}
+
+/* 求值谓词并记录本次字段值；调用方持有 cb_lock，同一节点的发布在此串行 */
+static rt_bool_t orb_filter_match(orb_filter_t *f, const void *data)
+{
+    const rt_uint8_t *p = (const rt_uint8_t *)data + f->offset;
+    if (f->op == ORB_FILTER_BITS)
+    {
+        return (orb_filter_bits(p, f->type) & f->mask) != 0;
+    }
+
+    const double v   = uorb_field_value(p, f->type);
+    rt_bool_t    hit = RT_FALSE;
+    switch (f->op)
+    {
+    case ORB_FILTER_EQ:      hit = (v == f->value); break;
+    case ORB_FILTER_NE:      hit = (v != f->value); break;
+    case ORB_FILTER_GT:      hit = (v > f->value); break;
+    case ORB_FILTER_GE:      hit = (v >= f->value); break;
+    case ORB_FILTER_LT:      hit = (v < f->value); break;
+    case ORB_FILTER_LE:      hit = (v <= f->value); break;
+    case ORB_FILTER_CHANGED: hit = (!f->has_last || v != f->last); break;
+    case ORB_FILTER_RISE:    hit = (v >= f->value && (!f->has_last || f->last < f->value)); break;
+    case ORB_FILTER_FALL:    hit = (v < f->value && (!f->has_last || f->last >= f->value)); break;
+    default: break;
+    }
+    f->last     = v;
+    f->has_last = RT_TRUE;
+    return hit;
+}
+
+/* 匹配时把消息拷入订阅者私有缓冲并只唤醒该订阅者 */
+static void orb_filter_dispatch(orb_node_t *node, orb_filter_t *f, const void *data)
+{
+    if (!orb_filter_match(f, data))
+    {
+        return;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    rt_memcpy(f->msg, data, node->meta->o_size);
+    f->matched++;
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    uorb_notifier_notify(&f->notifier);
+}
+
+static void orb_filter_link(orb_node_t *node, orb_filter_t *f)
+{
+    rt_bool_t locked = orb_cb_lock(node);
+    rt_list_insert_before(&node->filters, &f->list);
+    f->node = node;
+    orb_cb_unlock(node, locked);
+}
+
+static void orb_filter_free(orb_filter_t *f, const struct orb_metadata *meta)
+{
+    if (f->node)
+    {
+        rt_bool_t locked = orb_cb_lock(f->node);
+        rt_list_remove(&f->list);
+        orb_cb_unlock(f->node, locked);
+        f->node = RT_NULL;
+    }
+    if (f->notifier.event)
+    {
+        uorb_notifier_deinit(&f->notifier);
+        orb_mem_charge(ORB_MEM_EVENT, -(rt_ssize_t)sizeof(struct rt_event));
+    }
+    rt_free(f);
+    orb_mem_charge(ORB_MEM_SUBSCRIPTION, -(rt_ssize_t)(sizeof(orb_filter_t) + meta->o_size));
+}
+
+/* 过滤订阅：拷出最近一条匹配的消息，尚无匹配时返回 0 */
+static int orb_filter_read(orb_subscribe_t *handle, void *buffer)
+{
+    orb_node_t   *node = handle->node;
+    orb_filter_t *f    = handle->filter;
+    int           ret  = 0;
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    if (f->matched != 0)
+    {
+        rt_memcpy(buffer, f->msg, node->meta->o_size);
+        f->consumed = f->matched;
+        node->bytes_copied += node->meta->o_size;
+        ret = node->meta->o_size;
+    }
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return ret;
+}
+
+int orb_node_alloc(orb_node_t *node)
+{
+    // create buffer（在锁外分配；并发首写时只保留一份）
+    if (!node->data)
+    {
+        const size_t size = node->meta->o_size * node->queue_size;
+        rt_uint8_t  *buf  = rt_calloc(size, 1);
+        if (buf)
+        {
+            rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+            rt_uint32_t reserved = 0;
+            if (!node->data)
+            {
+                node->data           = buf;
+                buf                  = RT_NULL;
+                reserved             = node->queue_reserved;
+                node->queue_reserved = 0;
+            }
+            rt_spin_unlock_irqrestore(&node->lock, level);
+            if (buf)
+            {
+                rt_free(buf);
+            }
+            else
+            {
+                /* 预留转为实际占用 */
+                orb_registry_lock();
+                _orb_mem.reserved -= reserved;
+                orb_mem_charge_locked(ORB_MEM_QUEUE, size);
+                orb_registry_unlock();
+            }
+        }
+    }
+
+    return node->data ? RT_EOK : -RT_ENOMEM;
+}
+
+rt_uint32_t orb_node_store(orb_node_t *node, const void *data)
+{
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
 
     // copy data to buffer
     rt_memcpy(node->data + (node->meta->o_size * (node->generation % node->queue_size)), data, node->meta->o_size);
 
-    // invoke callbacks
+    // mark data valid
+    node->data_valid = true;
+
+    // update generation
+    const rt_uint32_t generation = ++node->generation;
+    node->bytes_published += node->meta->o_size;
+
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return generation;
+}
+
+void orb_node_deliver(orb_node_t *node, const void *data, rt_uint32_t generation)
+{
+    /* 回调在数据锁外派发：回调内可安全地 orb_copy 本主题，也可注册/注销本主题的回调；
+     * 回调内向同一主题发布会重入 cb_lock（SMP 下自锁），不支持 */
+    rt_thread_t self = rt_thread_self();
+    RT_ASSERT(!self || node->cb_owner != self);
+
     rt_list_t      *pos;
     orb_callback_t *item;
-    rt_list_for_each(pos, &node->callbacks)
+    rt_spin_lock(&node->cb_lock);
+    node->cb_owner = self;
+    for (pos = node->callbacks.next; pos != &node->callbacks; pos = node->cb_next)
     {
-        item = rt_list_entry(pos, orb_callback_t, list);
-        if (item->call)
+        node->cb_next = pos->next;
+        item          = rt_list_entry(pos, orb_callback_t, list);
+        if (item->fn)
+        {
+            /* 直接传递调用方的消息缓冲（内容与刚写入的槽一致），回调期间有效 */
+            item->fn(node->meta, node->instance, data, item->context);
+        }
+        else if (item->call)
         {
             item->call();
         }
     }
+    node->cb_next = RT_NULL;
+    rt_list_for_each(pos, &node->filters)
+    {
+        orb_filter_dispatch(node, rt_list_entry(pos, orb_filter_t, list), data);
+    }
+    node->cb_owner = RT_NULL;
+    rt_spin_unlock(&node->cb_lock);
 
     // 通知订阅者（事件）
     uorb_notifier_notify(&node->notifier);
+    UORB_TRACE(UORB_TRACE_NOTIFY, node->id, generation);
+}
 
-    // mark data valid
-    node->data_valid = true;
+int orb_node_write(orb_node_t *node, const void *data)
+{
+    RT_ASSERT(node != RT_NULL);
+    
+    // 添加对data参数的NULL检查，返回错误而非断言失败  
+    if (data == RT_NULL)
+    {
+        return -RT_EINVAL;
+    }
 
-    // update generation
-    node->generation++;
+#ifdef UORB_USING_PROFILING
+    const rt_uint64_t t0 = uorb_prof_now();
+#endif
+
+    // buffer invalid
+    if (orb_node_alloc(node) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+
+    rt_uint32_t generation;
+#ifdef UORB_USING_SHM
+    if (node->shm)
+    {
+        /* 写入共享环形缓冲并唤醒其他进程的等待者 */
+        generation = uorb_shm_write(node, data);
+    }
+    else
+#endif
+    {
+        generation = orb_node_store(node, data);
+    }
+
+    UORB_TRACE(UORB_TRACE_PUBLISH, node->id, generation);
 
-    rt_exit_critical();
+    orb_node_deliver(node, data, generation);
+
+#ifdef UORB_USING_PROFILING
+    /* 含回调派发与通知的完整发布耗时 */
+    const rt_uint64_t dt    = uorb_prof_since(t0);
+    rt_base_t         level = rt_spin_lock_irqsave(&node->lock);
+    node->write_time += dt;
+    rt_spin_unlock_irqrestore(&node->lock, level);
+#endif
 
     return node->meta->o_size;
 }
@@ -350,17 +1072,36 @@ bool orb_node_ready(orb_subscribe_t *handle)
 
     if (handle->node)
     {
+        ORB_NODE_SYNC(handle->node);
         return handle->node->advertised;
     }
 
-    handle->node = orb_node_find(handle->meta, handle->instance);
+    orb_node_t *node = orb_node_find(handle->meta, handle->instance);
+#ifdef UORB_USING_SHM
+    if (!node)
+    {
+        /* 本进程没有该实例：其他进程已在共享段中公告时建本地节点绑定过去 */
+        node = uorb_shm_lookup(handle->meta, handle->instance);
+    }
+#endif
 
-    if (handle->node)
+    if (node)
     {
-        handle->node->subscriber_count++;
-        handle->generation = handle->node->generation;
+        ORB_NODE_SYNC(node);
+        rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+        node->subscriber_count++;
+        handle->generation = node->generation;
+        rt_list_insert_before(&node->subscribers, &handle->node_entry);
+        orb_node_refresh_rate_locked(node);
+        rt_spin_unlock_irqrestore(&node->lock, level);
+        handle->node = node;
+        if (handle->filter)
+        {
+            /* 先设过滤后绑定：绑定时挂入节点 */
+            orb_filter_link(node, handle->filter);
+        }
 
-        return handle->node->advertised;
+        return node->advertised;
     }
 
     return false;
@@ -369,18 +1110,29 @@ bool orb_node_ready(orb_subscribe_t *handle)
 orb_subscribe_t *orb_subscribe_multi(const struct orb_metadata *meta, uint8_t instance)
 {
     orb_subscribe_t *sub = rt_calloc(sizeof(orb_subscribe_t), 1);
+    if (!sub)
+    {
+        return RT_NULL;
+    }
+    orb_mem_charge(ORB_MEM_SUBSCRIPTION, sizeof(orb_subscribe_t));
 
     sub->meta       = meta;
     sub->instance   = instance;
     sub->interval   = 0;
+    sub->ts_offset  = -1;
     sub->generation = 0;
+    rt_list_init(&sub->node_entry);
     sub->node       = orb_node_find(meta, instance);
     
     // 如果找到了节点，增加订阅者计数并初始化generation
     if (sub->node)
     {
+        rt_base_t level = rt_spin_lock_irqsave(&sub->node->lock);
         sub->node->subscriber_count++;
         sub->generation = sub->node->generation;
+        rt_list_insert_before(&sub->node->subscribers, &sub->node_entry);
+        orb_node_refresh_rate_locked(sub->node);
+        rt_spin_unlock_irqrestore(&sub->node->lock, level);
     }
 
     return sub;
@@ -393,26 +1145,110 @@ int orb_unsubscribe(orb_subscribe_t *handle)
         return -RT_EINVAL;
     }
 
+    if (handle->filter)
+    {
+        orb_filter_free(handle->filter, handle->meta);
+        handle->filter = RT_NULL;
+    }
+
     if (handle->node)
     {
-        handle->node->subscriber_count--;
+        orb_node_t *node  = handle->node;
+        rt_base_t   level = rt_spin_lock_irqsave(&node->lock);
+        node->subscriber_count--;
+        rt_list_remove(&handle->node_entry);
+        orb_node_refresh_rate_locked(node);
+        rt_bool_t last = (node->subscriber_count == 0);
+        rt_spin_unlock_irqrestore(&node->lock, level);
         /* 若已标记延迟删除且无订阅者且未公告，则回收节点 */
-        if (handle->node->subscriber_count == 0 && (handle->node->pending_delete || !handle->node->advertised))
+        if (last && (node->pending_delete || !node->advertised))
         {
-            orb_node_delete(handle->node);
+            orb_node_delete(node);
         }
     }
 
     /* 清理订阅者状态，避免悬挂（即便随后释放） */
     handle->callback_registered = RT_FALSE;
     handle->last_update = 0;
+    handle->last_ts     = 0;
     handle->node       = RT_NULL;
     handle->generation = 0;
 
     rt_free(handle);
+    orb_mem_charge(ORB_MEM_SUBSCRIPTION, -(rt_ssize_t)sizeof(orb_subscribe_t));
     return RT_EOK;
 }
 
+/* 读取最新一条消息中 offset 处的 uint64（如 timestamp），不拷贝整条消息 */
+int orb_node_peek_u64(orb_node_t *node, rt_uint16_t offset, rt_uint64_t *value)
+{
+    if (!node || !value || offset + sizeof(rt_uint64_t) > node->meta->o_size)
+    {
+        return -RT_EINVAL;
+    }
+
+    int ret = -RT_EEMPTY;
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    if (node->data && node->generation != 0)
+    {
+        rt_uint32_t idx = (node->generation - 1) % node->queue_size;
+        rt_memcpy(value, node->data + node->meta->o_size * idx + offset, sizeof(rt_uint64_t));
+        ret = RT_EOK;
+    }
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return ret;
+}
+
+/*
+ * 读取游标 *generation 处（下一条未读消息）offset 处的 uint64，不拷贝整条消息。
+ * 游标已被覆盖时移到最早可用的一条，返回跳过的条数；无未读消息返回 -RT_EEMPTY。
+ */
+int orb_node_peek_next_u64(orb_node_t *node, rt_uint32_t *generation, rt_uint16_t offset, rt_uint64_t *value)
+{
+    if (!node || !generation || !value || offset + sizeof(rt_uint64_t) > node->meta->o_size)
+    {
+        return -RT_EINVAL;
+    }
+
+    int       ret   = -RT_EEMPTY;
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    if (node->data && *generation != node->generation)
+    {
+        const rt_uint32_t current = node->generation;
+        const rt_int32_t  depth   = node->queue_size;
+        const rt_int32_t  lag     = (rt_int32_t)(current - *generation);
+        ret                       = 0;
+        if (lag > depth || lag < 0)
+        {
+            ret         = lag > depth ? lag - depth : 0;
+            *generation = current - (rt_uint32_t)(lag > depth ? depth : 1);
+        }
+        rt_uint32_t idx = *generation % depth;
+        rt_memcpy(value, node->data + node->meta->o_size * idx + offset, sizeof(rt_uint64_t));
+    }
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return ret;
+}
+
+/* 节流判定：距上次拷贝是否已满一个间隔（调用方保证 interval_clk != 0） */
+static rt_bool_t orb_sub_interval_elapsed(orb_subscribe_t *handle, orb_node_t *node)
+{
+    if (handle->ts_offset >= 0)
+    {
+        rt_uint64_t ts = 0;
+        if (handle->last_ts != 0 &&
+            orb_node_peek_u64(node, (rt_uint16_t)handle->ts_offset, &ts) == RT_EOK &&
+            ts - handle->last_ts < handle->interval_us)
+        {
+            return RT_FALSE;
+        }
+        return RT_TRUE;
+    }
+
+    return handle->last_update == 0 ||
+           (uorb_clock_t)(uorb_clock_now() - handle->last_update) >= handle->interval_clk;
+}
+
 //  检查订阅者是否有新数据可读，并支持定时检查
 int orb_check(orb_subscribe_t *handle, rt_bool_t *updated)
 {
@@ -426,21 +1262,68 @@ int orb_check(orb_subscribe_t *handle, rt_bool_t *updated)
         return -RT_ERROR;
     }
 
-    // 简化逻辑：检查generation是否不同来确定是否有更新
-    if (handle->interval == 0 || (rt_tick_get() - handle->last_update) * 1000 / RT_TICK_PER_SECOND >= handle->interval)
+    orb_node_t *node = handle->node;
+    *updated = RT_FALSE;
+
+    if (handle->filter)
+    {
+        /* 过滤订阅：只有匹配的发布算作更新，不做节流 */
+        const rt_uint32_t matched = handle->filter->matched;
+        *updated                  = (matched != handle->filter->consumed);
+        handle->filter->consumed  = matched;
+        return RT_EOK;
+    }
+
+    if (handle->generation == node->generation)
     {
-        *updated = handle->generation != handle->node->generation;
-        if (*updated)
+        return RT_EOK;
+    }
+
+    /* 未节流的订阅者不做任何时间运算；间隔已在 orb_set_interval*() 时换算好 */
+    if (handle->interval_clk != 0 && !orb_sub_interval_elapsed(handle, node))
+    {
+        return RT_EOK;
+    }
+
+    /* 推进 generation，使得一次检查消费一次更新信号 */
+    *updated = RT_TRUE;
+    handle->generation = node->generation;
+    return RT_EOK;
+}
+
+/*
+ * 记录本次拷贝的时刻，作为下一次间隔的起点。
+ * 若距离上次不足两个间隔，则基准只前进一个间隔而不是取当前值，
+ * 避免检查时刻的抖动逐次累积成降采样频率的漂移。
+ */
+static void orb_sub_mark_copied(orb_subscribe_t *handle, const void *buffer)
+{
+    if (handle->ts_offset >= 0)
+    {
+        rt_uint64_t ts;
+        rt_memcpy(&ts, (const rt_uint8_t *)buffer + handle->ts_offset, sizeof(ts));
+        rt_uint64_t elapsed = ts - handle->last_ts;
+        if (handle->last_ts == 0 || elapsed < handle->interval_us || elapsed >= 2ULL * handle->interval_us)
         {
-            /* 推进 generation，使得一次检查消费一次更新信号 */
-            handle->generation = handle->node->generation;
+            handle->last_ts = ts;
+        }
+        else
+        {
+            handle->last_ts += handle->interval_us;
         }
-        return RT_EOK;
     }
     else
     {
-        *updated = RT_FALSE;
-        return RT_EOK;
+        uorb_clock_t now     = uorb_clock_now();
+        uorb_clock_t elapsed = now - handle->last_update;
+        if (handle->last_update == 0 || elapsed < handle->interval_clk || elapsed >= 2 * handle->interval_clk)
+        {
+            handle->last_update = now;
+        }
+        else
+        {
+            handle->last_update += handle->interval_clk;
+        }
     }
 }
 
@@ -453,15 +1336,69 @@ int orb_copy(const struct orb_metadata *meta, orb_subscribe_t *handle, void *buf
     if (!orb_node_ready(handle))
         return -RT_ERROR;
 
+    if (handle->filter)
+    {
+        return orb_filter_read(handle, buffer);
+    }
+
     // 读取数据并更新订阅者generation
     int ret = orb_node_read(handle->node, buffer, &handle->generation);
-    if (ret > 0)
+    if (ret > 0 && handle->interval_clk != 0)
     {
-        // 更新时间戳
-        handle->last_update = rt_tick_get();
-        return ret;
+        orb_sub_mark_copied(handle, buffer);
     }
-    return ret; // 返回实际的错误码或0
+    return ret; // 返回拷贝字节数、0 或错误码
+}
+
+int orb_update(orb_subscribe_t *handle, void *buffer)
+{
+    if (!handle || !buffer)
+    {
+        return -RT_EINVAL;
+    }
+
+    orb_node_t *node = handle->node;
+    if (!node)
+    {
+        /* 先订阅后公告：首次绑定节点 */
+        if (!orb_node_ready(handle))
+        {
+            return 0;
+        }
+        node = handle->node;
+    }
+    else
+    {
+        ORB_NODE_SYNC(node);
+        if (!node->advertised)
+        {
+            return 0;
+        }
+    }
+
+    if (handle->filter)
+    {
+        return (handle->filter->matched != handle->filter->consumed) ? orb_filter_read(handle, buffer) : 0;
+    }
+
+    /* 常见路径：一次代数比较即可确认无更新 */
+    if (handle->generation == node->generation)
+    {
+        return 0;
+    }
+
+    if (handle->interval_clk != 0 && !orb_sub_interval_elapsed(handle, node))
+    {
+        return 0;
+    }
+
+    /* 与 orb_copy 相同：队列主题按订阅者代数逐条读取 */
+    int ret = orb_node_read(node, buffer, &handle->generation);
+    if (ret > 0 && handle->interval_clk != 0)
+    {
+        orb_sub_mark_copied(handle, buffer);
+    }
+    return ret;
 }
 
 orb_advert_t orb_advertise_multi_queue(const struct orb_metadata *meta, const void *data, int *instance,
@@ -474,12 +1411,9 @@ orb_advert_t orb_advertise_multi_queue(const struct orb_metadata *meta, const vo
 
     orb_node_t *node = RT_NULL;
 
-    // 允许的最大instance个数
-
-    int max_inst = ORB_MULTI_MAX_INSTANCES;
-    int inst     = 0;
-
+    // 允许的最大instance个数：主题的 %instances，未配置时为编译期上限
     int def_inst = get_default_instances(meta);
+    int max_inst;
 
     if (!instance)
     {
@@ -488,53 +1422,81 @@ orb_advert_t orb_advertise_multi_queue(const struct orb_metadata *meta, const vo
     }
     else
     {
-        /* 允许在提供instance指针时遍历全部可用实例上限 */
-        max_inst = ORB_MULTI_MAX_INSTANCES;
+        max_inst = (def_inst > 0) ? def_inst : ORB_MULTI_MAX_INSTANCES;
     }
 
-    int selected_inst = -1;
+    rt_uint32_t range         = (max_inst >= 32) ? 0xFFFFFFFFU : ((1U << max_inst) - 1U);
+    orb_node_t *created       = RT_NULL;
+    int         selected_inst = -1;
+    rt_size_t   need          = 0;
+    rt_size_t   used          = 0;
+    rt_size_t   budget        = 0;
 
-    // 搜索实例是否存在，不存在则创建，存在则判断是否公告
-    for (inst = 0; inst < max_inst; inst++)
+    /* 在注册表锁内按位图占用最小的空闲实例；实例尚无节点时在锁外创建后重试 */
+    while (selected_inst < 0)
     {
-        node = orb_node_find(meta, inst);
-
+        orb_registry_lock();
+        orb_group_t *group = orb_group_find_locked(meta);
+        rt_uint32_t  avail = ~(group ? group->advertised : 0U) & range;
+        if (!avail)
+        {
+            orb_registry_unlock();
+            break;
+        }
+        int inst = __rt_ffs((int)avail) - 1;
+        node     = group ? group->nodes[inst] : RT_NULL;
         if (node)
         {
-            if (!node->advertised)
+            group->advertised |= 1U << inst;
+            // 标记为已经公告，只有公告过的主题才能copy和publish数据
+            node->priority   = ORB_PRIO_DEFAULT;
+            node->advertised = true;
+            selected_inst    = inst;
+        }
+        else if (_orb_mem.budget && !created)
+        {
+            budget = _orb_mem.budget;
+            /* 需要新建节点：按节点、事件、环形缓冲与主题组估算，超出预算则拒绝 */
+            need = sizeof(orb_node_t) + sizeof(struct rt_event) +
+                   meta->o_size * orb_node_queue_len(meta, (rt_uint8_t)queue_size) + (group ? 0 : sizeof(orb_group_t));
+            used = _orb_mem.total + _orb_mem.reserved;
+            if (used + need > budget)
             {
-                selected_inst = inst;
+                _orb_mem.rejected++;
+                orb_registry_unlock();
                 break;
             }
-            else
-            {
-                // 已经公告，占用该实例，继续查找
-                node = RT_NULL;
-                continue;
-            }
+            need = 0;
         }
-        else
+        orb_registry_unlock();
+        created = RT_NULL;
+
+        if (selected_inst < 0)
         {
             /* 当调用方未指定队列长度(传入0)时，orb_node_create 将使用默认队列长度（若有） */
-            node = orb_node_create(meta, inst, (rt_uint8_t)queue_size);
-            if (!node)
+            created = orb_node_create(meta, (rt_uint8_t)inst, (rt_uint8_t)queue_size);
+            if (!created)
             {
-                // 创建失败，继续尝试下一个实例
-                continue;
+                break;
             }
-            selected_inst = inst;
-            break;
         }
     }
 
     // 未找到可用实例
-    if (selected_inst < 0 || !node)
+    if (selected_inst < 0)
     {
+        if (need)
+        {
+            LOG_E("advertise %s failed: needs %u bytes, %u of budget %u in use (uorb mem)", meta->o_name,
+                  (unsigned)need, (unsigned)used, (unsigned)budget);
+        }
         return RT_NULL;
     }
 
-    // 标记为已经公告，只有公告过的主题才能copy和publish数据
-    node->advertised = true;
+#ifdef UORB_USING_SHM
+    uorb_shm_advertise(node, RT_TRUE);
+#endif
+
     if (data)
     {
         orb_node_write(node, data);
@@ -559,6 +1521,12 @@ int orb_unadvertise(orb_node_t *node)
     }
 
     node->advertised = false;
+    orb_registry_lock();
+    orb_group_clear_advertised_locked(node);
+    orb_registry_unlock();
+#ifdef UORB_USING_SHM
+    uorb_shm_advertise(node, RT_FALSE);
+#endif
 
     /* 若无人订阅则释放节点（与设备化策略配合：设备注销也会尝试回收） */
     if (node->subscriber_count == 0)
@@ -583,19 +1551,7 @@ int orb_publish(const struct orb_metadata *meta, orb_node_t *node, const void *d
     else if (meta && !node)
     {
         /* 优先选择已公告的最小实例，若不存在则回退实例0 */
-        for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
-        {
-            orb_node_t *candidate = orb_node_find(meta, i);
-            if (candidate && candidate->advertised)
-            {
-                node = candidate;
-                break;
-            }
-        }
-        if (!node)
-        {
-            node = orb_node_find(meta, 0);
-        }
+        node = orb_node_find_first(meta);
         if (!node)
         {
             return -RT_ENOENT;
@@ -616,6 +1572,27 @@ int orb_publish(const struct orb_metadata *meta, orb_node_t *node, const void *d
         return -RT_EINVAL;
     }
 
+#ifdef UORB_USING_DEFERRED_PUBLISH
+    /* 延迟发布：调用方只付出一次入队，其余在投递线程中完成 */
+    if (node->deferred)
+    {
+        return uorb_defer_enqueue(node, data);
+    }
+#endif
+
+    return orb_node_publish(node, data);
+}
+
+int orb_node_publish(orb_node_t *node, const void *data)
+{
+    /* 限速/抽取命中时不触碰环形缓冲，也不通知订阅者。先判断内容变化：
+     * 未变化的消息不应占用限速周期或抽取计数 */
+    if (orb_node_unchanged(node, data) || orb_node_suppress(node))
+    {
+        return RT_EOK;
+    }
+    orb_node_accept(node);
+
     if (orb_node_write(node, data) == node->meta->o_size)
     {
         return RT_EOK;
@@ -641,7 +1618,11 @@ int orb_register_callback(const struct orb_metadata *meta, uint8_t instance, voi
         return -RT_ERROR;
     }
     item->call = fn;
+    orb_mem_charge(ORB_MEM_CALLBACK, sizeof(orb_callback_t));
+    rt_bool_t locked = orb_cb_lock(node);
     rt_list_insert_after(&node->callbacks, &item->list);
+    orb_cb_unlock(node, locked);
+    orb_node_refresh_rate(node);
     return RT_EOK;
 }
 
@@ -656,16 +1637,392 @@ int orb_unregister_callback(const struct orb_metadata *meta, uint8_t instance, v
     {
         return -RT_ERROR;
     }
-    rt_list_t *pos, *tmp;
+    rt_list_t      *pos, *tmp;
+    orb_callback_t *found  = RT_NULL;
+    rt_bool_t       locked = orb_cb_lock(node);
     rt_list_for_each_safe(pos, tmp, &node->callbacks)
     {
         orb_callback_t *item = rt_list_entry(pos, orb_callback_t, list);
         if (item->call == fn)
         {
-            rt_list_remove(&item->list);
-            rt_free(item);
-            return RT_EOK;
+            orb_cb_unlink_locked(node, &item->list);
+            found = item;
+            break;
         }
     }
+    orb_cb_unlock(node, locked);
+    if (found)
+    {
+        rt_free(found);
+        orb_mem_charge(ORB_MEM_CALLBACK, -(rt_ssize_t)sizeof(orb_callback_t));
+        orb_node_refresh_rate(node);
+        return RT_EOK;
+    }
     return -RT_ERROR;
 }
+
+int orb_register_callback_ctx(const struct orb_metadata *meta, uint8_t instance, orb_callback_t *cb,
+                              orb_callback_fn_t fn, void *context)
+{
+    if (!meta || !cb || !fn || cb->node || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* 允许先注册后公告：节点不存在时创建未公告节点 */
+    orb_node_t *node = orb_node_find(meta, instance);
+    if (!node)
+    {
+        node = orb_node_create(meta, instance, 0);
+        if (!node)
+        {
+            return -RT_ENOMEM;
+        }
+    }
+
+    cb->call    = RT_NULL;
+    cb->fn      = fn;
+    cb->context = context;
+    cb->node    = node;
+
+    /* 回调持有订阅者引用，保证取消公告后节点不会被释放 */
+    rt_bool_t locked = orb_cb_lock(node);
+    rt_list_insert_before(&node->callbacks, &cb->list);
+    orb_cb_unlock(node, locked);
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    node->subscriber_count++;
+    orb_node_refresh_rate_locked(node);
+    rt_spin_unlock_irqrestore(&node->lock, level);
+
+    return RT_EOK;
+}
+
+int orb_unregister_callback_ctx(orb_callback_t *cb)
+{
+    if (!cb || !cb->node)
+    {
+        return -RT_EINVAL;
+    }
+
+    orb_node_t *node = cb->node;
+
+    rt_bool_t locked = orb_cb_lock(node);
+    orb_cb_unlink_locked(node, &cb->list);
+    orb_cb_unlock(node, locked);
+    cb->node = RT_NULL;
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    node->subscriber_count--;
+    orb_node_refresh_rate_locked(node);
+    rt_bool_t last = (node->subscriber_count == 0);
+    rt_spin_unlock_irqrestore(&node->lock, level);
+
+    /* 在本节点的回调内注销时节点仍在派发，不在此释放；未公告的空节点留待之后公告或注销时回收 */
+    if (last && locked && (node->pending_delete || !node->advertised))
+    {
+        orb_node_delete(node);
+    }
+
+    return RT_EOK;
+}
+
+/* 解析字段并挂上过滤；BITS 使用 mask，其余谓词使用 value */
+static int orb_filter_attach(orb_subscribe_t *handle, const char *field, orb_filter_op_t op, double value,
+                             rt_uint64_t mask)
+{
+    if (!handle || !field)
+    {
+        return -RT_EINVAL;
+    }
+
+    uorb_field_desc_t desc;
+    int               ret = uorb_fields_find(handle->meta, field, &desc);
+    if (ret != RT_EOK)
+    {
+        return (ret == -RT_ENOENT) ? -RT_ENOENT : -RT_EINVAL;
+    }
+    if (desc.count != 1 || desc.type == UORB_FIELD_CHAR ||
+        (op == ORB_FILTER_BITS && (desc.type == UORB_FIELD_FLOAT || desc.type == UORB_FIELD_DOUBLE)))
+    {
+        return -RT_EINVAL;
+    }
+
+    const rt_size_t size = sizeof(orb_filter_t) + handle->meta->o_size;
+    orb_filter_t   *f    = rt_calloc(1, size);
+    if (!f)
+    {
+        return -RT_ENOMEM;
+    }
+    if (uorb_notifier_init(&f->notifier, "uorb_flt") != RT_EOK)
+    {
+        rt_free(f);
+        return -RT_ENOMEM;
+    }
+    orb_mem_charge(ORB_MEM_SUBSCRIPTION, size);
+    orb_mem_charge(ORB_MEM_EVENT, sizeof(struct rt_event));
+
+    f->offset = desc.offset;
+    f->type   = desc.type;
+    f->op     = (rt_uint8_t)op;
+    f->value  = value;
+    f->mask   = mask;
+    rt_list_init(&f->list);
+
+    orb_clear_filter(handle);
+    handle->filter = f;
+    if (handle->node)
+    {
+        orb_filter_link(handle->node, f);
+    }
+    return RT_EOK;
+}
+
+int orb_set_filter(orb_subscribe_t *handle, const char *field, orb_filter_op_t op, double value)
+{
+    /* 位掩码经 double 传递会丢失 2^53 以上的位，须用 orb_set_filter_bits() */
+    if ((unsigned)op >= ORB_FILTER_BITS)
+    {
+        return -RT_EINVAL;
+    }
+    return orb_filter_attach(handle, field, op, value, 0);
+}
+
+int orb_set_filter_bits(orb_subscribe_t *handle, const char *field, rt_uint64_t mask)
+{
+    if (!mask)
+    {
+        return -RT_EINVAL;
+    }
+    return orb_filter_attach(handle, field, ORB_FILTER_BITS, 0, mask);
+}
+
+int orb_clear_filter(orb_subscribe_t *handle)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    if (handle->filter)
+    {
+        orb_filter_t *f = handle->filter;
+        handle->filter  = RT_NULL;
+        orb_filter_free(f, handle->meta);
+        /* 之后按普通订阅判断更新：从当前代数开始 */
+        if (handle->node)
+        {
+            handle->generation = handle->node->generation;
+        }
+    }
+    return RT_EOK;
+}
+
+int orb_set_publish_interval_us(orb_advert_t handle, rt_uint32_t interval_us)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&handle->lock);
+    handle->pub_interval_us = interval_us;
+    handle->last_pub        = 0;
+    orb_node_refresh_rate_locked(handle);
+    rt_spin_unlock_irqrestore(&handle->lock, level);
+    return RT_EOK;
+}
+
+int orb_set_publish_decimation(orb_advert_t handle, rt_uint16_t factor)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&handle->lock);
+    handle->decimation  = factor;
+    handle->decim_count = 0;
+    rt_spin_unlock_irqrestore(&handle->lock, level);
+    return RT_EOK;
+}
+
+int orb_set_publish_auto_rate(orb_advert_t handle, rt_bool_t enable)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&handle->lock);
+    handle->auto_rate = enable;
+    orb_node_refresh_rate_locked(handle);
+    rt_spin_unlock_irqrestore(&handle->lock, level);
+    return RT_EOK;
+}
+
+int orb_set_publish_on_change(orb_advert_t handle, rt_bool_t enable, rt_uint32_t heartbeat_us)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* 只跳过单个 uint64 的 timestamp 字段；字段描述无法解析时整条比较 */
+    rt_int16_t        ts_offset = -1;
+    uorb_field_desc_t f;
+    if (enable && uorb_fields_find(handle->meta, "timestamp", &f) == RT_EOK && f.type == UORB_FIELD_UINT64 &&
+        f.count == 1)
+    {
+        ts_offset = (rt_int16_t)f.offset;
+    }
+
+    rt_base_t level = rt_spin_lock_irqsave(&handle->lock);
+    handle->on_change        = enable;
+    handle->change_ts_offset = ts_offset;
+    handle->heartbeat_clk    = uorb_clock_from_us(heartbeat_us);
+    handle->last_accept      = uorb_clock_now();
+    rt_spin_unlock_irqrestore(&handle->lock, level);
+    return RT_EOK;
+}
+
+int orb_get_publish_suppressed(orb_advert_t handle, rt_uint32_t *count)
+{
+    if (!handle || !count)
+    {
+        return -RT_EINVAL;
+    }
+    *count = handle->suppressed;
+    return RT_EOK;
+}
+
+int orb_set_priority(orb_advert_t handle, rt_uint8_t priority)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    handle->priority = priority;
+    return RT_EOK;
+}
+
+int orb_get_priority(orb_advert_t handle, rt_uint8_t *priority)
+{
+    if (!handle || !priority)
+    {
+        return -RT_EINVAL;
+    }
+    *priority = handle->priority;
+    return RT_EOK;
+}
+
+/* 需持有注册表锁；耗时字段先存原始计数，由调用方在锁外换算 */
+static void orb_node_fill_stat_locked(const orb_node_t *node, orb_node_stat_t *st)
+{
+    st->meta             = node->meta;
+    st->id               = node->id;
+    st->generation       = node->generation;
+    st->suppressed       = node->suppressed;
+    st->instance         = node->instance;
+    st->queue_size       = node->queue_size;
+    st->subscriber_count = node->subscriber_count;
+    st->priority         = node->priority;
+    st->advertised       = node->advertised;
+    st->data_valid       = node->data_valid;
+    st->bytes_published  = node->bytes_published;
+    st->bytes_copied     = node->bytes_copied;
+    st->mem_bytes        = sizeof(orb_node_t) + node->subscriber_count * sizeof(orb_subscribe_t);
+    if (node->notifier.event)
+    {
+        st->mem_bytes += sizeof(struct rt_event);
+    }
+    if (node->data && !orb_node_is_shm(node))
+    {
+        st->mem_bytes += node->meta->o_size * node->queue_size;
+    }
+#ifdef UORB_USING_PROFILING
+    st->write_us         = node->write_time;
+    st->read_us          = node->read_time;
+#else
+    st->write_us         = 0;
+    st->read_us          = 0;
+#endif
+}
+
+static void orb_node_stat_to_us(orb_node_stat_t *st)
+{
+#ifdef UORB_USING_PROFILING
+    st->write_us = uorb_prof_to_us(st->write_us);
+    st->read_us  = uorb_prof_to_us(st->read_us);
+#else
+    RT_UNUSED(st);
+#endif
+}
+
+int orb_snapshot(orb_node_stat_t *stats, int max)
+{
+    if (max > 0 && !stats)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* 注册表锁内只做计数拷贝，换算、格式化与打印由调用方在锁外完成 */
+    int        n = 0;
+    rt_list_t *pos;
+    orb_registry_lock();
+    rt_list_for_each(pos, &_orb_node_list)
+    {
+        if (n < max)
+        {
+            orb_node_fill_stat_locked(rt_list_entry(pos, orb_node_t, list), &stats[n]);
+        }
+        n++;
+    }
+    orb_registry_unlock();
+
+    for (int i = 0; i < n && i < max; i++)
+    {
+        orb_node_stat_to_us(&stats[i]);
+    }
+    return n;
+}
+
+int orb_node_stat(const struct orb_metadata *meta, int instance, orb_node_stat_t *stat)
+{
+    if (!meta || !stat || instance < 0 || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return -RT_EINVAL;
+    }
+
+    int ret = -RT_ENOENT;
+    orb_registry_lock();
+    orb_group_t *group = orb_group_find_locked(meta);
+    if (group && group->nodes[instance])
+    {
+        orb_node_fill_stat_locked(group->nodes[instance], stat);
+        ret = RT_EOK;
+    }
+    orb_registry_unlock();
+
+    if (ret == RT_EOK)
+    {
+        orb_node_stat_to_us(stat);
+    }
+    return ret;
+}
+
+int orb_mem_get(orb_mem_stat_t *stat)
+{
+    if (!stat)
+    {
+        return -RT_EINVAL;
+    }
+    orb_registry_lock();
+    *stat = _orb_mem;
+    orb_registry_unlock();
+    return RT_EOK;
+}
+
+int orb_mem_set_budget(rt_size_t bytes)
+{
+    orb_registry_lock();
+    _orb_mem.budget = bytes;
+    orb_registry_unlock();
+    return RT_EOK;
+}
@@ -0,0 +1,293 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_fields.h"
+#include "uorb_device_node.h"
+#include <rtthread.h>
+#include <string.h>
+
+struct field_type_info
+{
+    const char *name;
+    rt_uint8_t  type;
+    rt_uint8_t  size;
+};
+
+static const struct field_type_info field_types[] = {
+    {"int8",   UORB_FIELD_INT8,   1},
+    {"uint8",  UORB_FIELD_UINT8,  1},
+    {"int16",  UORB_FIELD_INT16,  2},
+    {"uint16", UORB_FIELD_UINT16, 2},
+    {"int32",  UORB_FIELD_INT32,  4},
+    {"uint32", UORB_FIELD_UINT32, 4},
+    {"int64",  UORB_FIELD_INT64,  8},
+    {"uint64", UORB_FIELD_UINT64, 8},
+    {"float",  UORB_FIELD_FLOAT,  4},
+    {"double", UORB_FIELD_DOUBLE, 8},
+    {"bool",   UORB_FIELD_BOOL,   1},
+    {"char",   UORB_FIELD_CHAR,   1},
+};
+
+static rt_bool_t is_space(char c)
+{
+    return c == ' ' || c == '\t';
+}
+
+static rt_bool_t is_ident(char c)
+{
+    return (c >= 'a' && c <= 'z') || (c >= 'A' && c <= 'Z') || (c >= '0' && c <= '9') || c == '_';
+}
+
+static const struct field_type_info *lookup_type(const char *p, int len)
+{
+    /* 兼容 "uint64_t" 写法 */
+    if (len > 2 && p[len - 2] == '_' && p[len - 1] == 't')
+    {
+        len -= 2;
+    }
+    for (rt_size_t i = 0; i < sizeof(field_types) / sizeof(field_types[0]); i++)
+    {
+        if ((int)rt_strlen(field_types[i].name) == len && rt_strncmp(field_types[i].name, p, len) == 0)
+        {
+            return &field_types[i];
+        }
+    }
+    return RT_NULL;
+}
+
+/* 解析若干个 "[N]"，返回元素个数乘积；格式错误返回 0 */
+static int parse_dims(const char **pp, const char *end)
+{
+    const char *p = *pp;
+    int count = 1;
+    while (p < end && *p == '[')
+    {
+        p++;
+        int n = 0;
+        while (p < end && *p >= '0' && *p <= '9')
+        {
+            n = n * 10 + (*p - '0');
+            p++;
+        }
+        if (p >= end || *p != ']' || n <= 0)
+        {
+            return 0;
+        }
+        p++;
+        count *= n;
+    }
+    *pp = p;
+    return count;
+}
+
+const char *uorb_field_type_name(rt_uint8_t type)
+{
+    for (rt_size_t i = 0; i < sizeof(field_types) / sizeof(field_types[0]); i++)
+    {
+        if (field_types[i].type == type)
+        {
+            return field_types[i].name;
+        }
+    }
+    return "?";
+}
+
+double uorb_field_value(const void *p, rt_uint8_t type)
+{
+    switch (type)
+    {
+    case UORB_FIELD_INT8:   { rt_int8_t v;   rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_UINT8:  { rt_uint8_t v;  rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_BOOL:   { rt_uint8_t v;  rt_memcpy(&v, p, sizeof(v)); return v ? 1 : 0; }
+    case UORB_FIELD_INT16:  { rt_int16_t v;  rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_UINT16: { rt_uint16_t v; rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_INT32:  { rt_int32_t v;  rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_UINT32: { rt_uint32_t v; rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_INT64:  { rt_int64_t v;  rt_memcpy(&v, p, sizeof(v)); return (double)v; }
+    case UORB_FIELD_UINT64: { rt_uint64_t v; rt_memcpy(&v, p, sizeof(v)); return (double)v; }
+    case UORB_FIELD_FLOAT:  { float v;       rt_memcpy(&v, p, sizeof(v)); return v; }
+    case UORB_FIELD_DOUBLE: { double v;      rt_memcpy(&v, p, sizeof(v)); return v; }
+    default: return 0;
+    }
+}
+
+int uorb_fields_parse(const struct orb_metadata *meta, uorb_field_desc_t *out, int max_fields)
+{
+    if (!meta || !meta->o_fields || (max_fields > 0 && !out))
+    {
+        return -RT_EINVAL;
+    }
+
+    const char *p      = meta->o_fields;
+    int         nfield = 0;
+    rt_uint32_t offset = 0;
+
+    while (*p)
+    {
+        const char *seg = p;
+        while (*p && *p != ';') p++;
+        const char *end = p;
+        if (*p == ';') p++;
+
+        while (seg < end && is_space(*seg)) seg++;
+        while (end > seg && is_space(end[-1])) end--;
+        /* 空段与 "@key=value" 元标签不属于结构体字段 */
+        if (seg == end || *seg == '@')
+        {
+            continue;
+        }
+
+        const char *tname = seg;
+        while (seg < end && is_ident(*seg)) seg++;
+        const struct field_type_info *ti = lookup_type(tname, (int)(seg - tname));
+        if (!ti)
+        {
+            return -RT_ENOSYS;
+        }
+        int count = parse_dims(&seg, end);
+        if (count == 0)
+        {
+            return -RT_ENOSYS;
+        }
+
+        while (seg < end && is_space(*seg)) seg++;
+        const char *fname = seg;
+        while (seg < end && is_ident(*seg)) seg++;
+        int name_len = (int)(seg - fname);
+        if (name_len == 0 || name_len > RT_UINT8_MAX)
+        {
+            return -RT_ENOSYS;
+        }
+        int count2 = parse_dims(&seg, end);
+        if (count2 == 0 || seg != end)
+        {
+            return -RT_ENOSYS;
+        }
+        count *= count2;
+
+        /* 自然对齐 */
+        offset = (offset + ti->size - 1) & ~(rt_uint32_t)(ti->size - 1);
+
+        if (nfield < max_fields)
+        {
+            out[nfield].name      = fname;
+            out[nfield].name_len  = (rt_uint8_t)name_len;
+            out[nfield].type      = ti->type;
+            out[nfield].type_size = ti->size;
+            out[nfield].offset    = (rt_uint16_t)offset;
+            out[nfield].count     = (rt_uint16_t)count;
+        }
+        nfield++;
+        offset += (rt_uint32_t)ti->size * (rt_uint32_t)count;
+    }
+
+    if (offset > meta->o_size)
+    {
+        return -RT_ERROR;
+    }
+
+    return nfield;
+}
+
+/* 布局缓存：每个主题只解析一次；元数据为静态常量，缓存项随之常驻不释放 */
+struct fields_cache
+{
+    struct fields_cache       *next;
+    const struct orb_metadata *meta;
+    int                        count;
+    uorb_field_desc_t          fields[];
+};
+
+static struct fields_cache *_fields_cache;
+
+static struct fields_cache *fields_cache_find(const struct orb_metadata *meta)
+{
+    for (struct fields_cache *c = _fields_cache; c; c = c->next)
+    {
+        if (c->meta == meta)
+        {
+            return c;
+        }
+    }
+    return RT_NULL;
+}
+
+const uorb_field_desc_t *uorb_fields_layout(const struct orb_metadata *meta, int *count)
+{
+    if (!meta || !count)
+    {
+        return RT_NULL;
+    }
+
+    orb_registry_lock();
+    struct fields_cache *c = fields_cache_find(meta);
+    orb_registry_unlock();
+    if (c)
+    {
+        *count = c->count;
+        return c->fields;
+    }
+
+    /* 在锁外解析与分配；并发首次查询时只保留一份 */
+    int n = uorb_fields_parse(meta, RT_NULL, 0);
+    if (n < 0)
+    {
+        *count = n;
+        return RT_NULL;
+    }
+    struct fields_cache *fresh = rt_malloc(sizeof(struct fields_cache) + sizeof(uorb_field_desc_t) * n);
+    if (!fresh)
+    {
+        *count = -RT_ENOMEM;
+        return RT_NULL;
+    }
+    fresh->meta  = meta;
+    fresh->count = uorb_fields_parse(meta, fresh->fields, n);
+
+    orb_registry_lock();
+    c = fields_cache_find(meta);
+    if (!c)
+    {
+        fresh->next   = _fields_cache;
+        _fields_cache = fresh;
+        c             = fresh;
+        fresh         = RT_NULL;
+    }
+    orb_registry_unlock();
+    if (fresh)
+    {
+        rt_free(fresh);
+    }
+
+    *count = c->count;
+    return c->fields;
+}
+
+int uorb_fields_find(const struct orb_metadata *meta, const char *name, uorb_field_desc_t *out)
+{
+    if (!name || !out)
+    {
+        return -RT_EINVAL;
+    }
+
+    int                      n      = 0;
+    const uorb_field_desc_t *fields = uorb_fields_layout(meta, &n);
+    if (!fields)
+    {
+        return meta ? n : -RT_EINVAL;
+    }
+
+    rt_size_t len = rt_strlen(name);
+    for (int i = 0; i < n; i++)
+    {
+        if (fields[i].name_len == len && rt_strncmp(fields[i].name, name, len) == 0)
+        {
+            *out = fields[i];
+            return RT_EOK;
+        }
+    }
+    return -RT_ENOENT;
+}
@@ -0,0 +1,262 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_group.h"
+#include "uorb_device_node.h"
+#include "uorb_fields.h"
+#include <rtthread.h>
+
+struct orb_sub_group_s
+{
+    const struct orb_metadata *meta;
+    orb_subscribe_t           *subs[ORB_MULTI_MAX_INSTANCES];
+    rt_uint32_t                seen_gen[ORB_MULTI_MAX_INSTANCES]; /* 上次观察到的节点代数 */
+    uorb_clock_t               seen_at[ORB_MULTI_MAX_INSTANCES];  /* 观察到代数变化的本地时刻 */
+    uorb_clock_t               timeout_clk;                       /* 0 表示不做超时判定 */
+    rt_int16_t                 ts_offset;                         /* -1 表示主题无 timestamp */
+    rt_uint8_t                 policy;
+    rt_int8_t                  selected;                          /* 当前选中实例，-1 表示无 */
+    rt_int8_t                  delivered;                         /* 上次 orb_group_update 输出的实例 */
+};
+
+orb_sub_group_t *orb_subscribe_group(const struct orb_metadata *meta)
+{
+    if (!meta)
+    {
+        return RT_NULL;
+    }
+
+    orb_sub_group_t *group = rt_calloc(1, sizeof(orb_sub_group_t));
+    if (!group)
+    {
+        return RT_NULL;
+    }
+    group->meta      = meta;
+    group->ts_offset = -1;
+    group->selected  = -1;
+    group->delivered = -1;
+
+    uorb_field_desc_t f;
+    if (uorb_fields_find(meta, "timestamp", &f) == RT_EOK && f.type == UORB_FIELD_UINT64 && f.count == 1)
+    {
+        group->ts_offset = (rt_int16_t)f.offset;
+    }
+
+    /* 每个实例一个普通订阅；节点尚不存在时由 orb_node_ready 在之后绑定 */
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        group->subs[i] = orb_subscribe_multi(meta, (uint8_t)i);
+        if (!group->subs[i])
+        {
+            orb_unsubscribe_group(group);
+            return RT_NULL;
+        }
+    }
+
+    return group;
+}
+
+int orb_unsubscribe_group(orb_sub_group_t *group)
+{
+    if (!group)
+    {
+        return -RT_EINVAL;
+    }
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        if (group->subs[i])
+        {
+            orb_unsubscribe(group->subs[i]);
+        }
+    }
+    rt_free(group);
+    return RT_EOK;
+}
+
+int orb_group_set_policy(orb_sub_group_t *group, orb_group_policy_t policy, rt_uint32_t timeout_us)
+{
+    if (!group || policy > ORB_GROUP_FAILOVER)
+    {
+        return -RT_EINVAL;
+    }
+    group->policy      = (rt_uint8_t)policy;
+    group->timeout_clk = timeout_us ? uorb_clock_from_us(timeout_us) : 0;
+    return RT_EOK;
+}
+
+/* 返回已公告且有数据的节点；未绑定的实例顺带尝试绑定 */
+static orb_node_t *group_node(orb_sub_group_t *group, int i)
+{
+    orb_subscribe_t *sub = group->subs[i];
+    if (!sub->node && !orb_node_ready(sub))
+    {
+        return RT_NULL;
+    }
+    orb_node_t *node = sub->node;
+    return (node && node->advertised && node->data_valid) ? node : RT_NULL;
+}
+
+/* 记录各实例的代数变化时刻，返回有变化的实例位图 */
+static rt_uint32_t group_refresh(orb_sub_group_t *group, uorb_clock_t now)
+{
+    rt_uint32_t mask = 0;
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        orb_node_t *node = group_node(group, i);
+        if (!node)
+        {
+            continue;
+        }
+        rt_uint32_t gen = node->generation;
+        if (gen != group->seen_gen[i])
+        {
+            group->seen_gen[i] = gen;
+            group->seen_at[i]  = now;
+            mask |= 1U << i;
+        }
+    }
+    return mask;
+}
+
+static rt_bool_t group_healthy(orb_sub_group_t *group, int i, uorb_clock_t now)
+{
+    if (!group_node(group, i))
+    {
+        return RT_FALSE;
+    }
+    return group->timeout_clk == 0 || (uorb_clock_t)(now - group->seen_at[i]) <= group->timeout_clk;
+}
+
+static int group_pick(orb_sub_group_t *group, uorb_clock_t now)
+{
+    if (group->policy == ORB_GROUP_FAILOVER && group->selected >= 0 && group_healthy(group, group->selected, now))
+    {
+        return group->selected;
+    }
+
+    int          best     = -1;
+    rt_uint64_t  best_ts  = 0;
+    uorb_clock_t best_age = 0;
+    rt_uint8_t   best_pri = 0;
+
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        if (!group_healthy(group, i, now))
+        {
+            continue;
+        }
+        orb_node_t  *node = group->subs[i]->node;
+        rt_uint64_t  ts   = 0;
+        uorb_clock_t age  = (uorb_clock_t)(now - group->seen_at[i]);
+        if (group->ts_offset >= 0)
+        {
+            (void)orb_node_peek_u64(node, (rt_uint16_t)group->ts_offset, &ts);
+        }
+
+        rt_bool_t better;
+        if (best < 0)
+        {
+            better = RT_TRUE;
+        }
+        else if (group->policy == ORB_GROUP_NEWEST)
+        {
+            better = (group->ts_offset >= 0) ? (ts > best_ts) : (age < best_age);
+        }
+        else
+        {
+            better = node->priority > best_pri;
+        }
+
+        if (better)
+        {
+            best     = i;
+            best_ts  = ts;
+            best_age = age;
+            best_pri = node->priority;
+        }
+    }
+    return best;
+}
+
+rt_uint32_t orb_group_updated(orb_sub_group_t *group)
+{
+    if (!group)
+    {
+        return 0;
+    }
+    return group_refresh(group, uorb_clock_now());
+}
+
+int orb_group_select(orb_sub_group_t *group)
+{
+    if (!group)
+    {
+        return -RT_EINVAL;
+    }
+    uorb_clock_t now = uorb_clock_now();
+    (void)group_refresh(group, now);
+    group->selected = (rt_int8_t)group_pick(group, now);
+    return group->selected >= 0 ? group->selected : -RT_ENOENT;
+}
+
+int orb_group_update(orb_sub_group_t *group, void *buffer, int *instance)
+{
+    if (!group || !buffer)
+    {
+        return -RT_EINVAL;
+    }
+
+    int sel = orb_group_select(group);
+    if (sel < 0)
+    {
+        return 0;
+    }
+
+    int ret;
+    if (sel != group->delivered)
+    {
+        /* 切换实例：立即给出新实例的最新数据 */
+        ret = orb_copy(group->meta, group->subs[sel], buffer);
+        if (ret > 0)
+        {
+            group->delivered = (rt_int8_t)sel;
+        }
+    }
+    else
+    {
+        ret = orb_update(group->subs[sel], buffer);
+    }
+
+    if (ret > 0 && instance)
+    {
+        *instance = sel;
+    }
+    return ret;
+}
+
+int orb_group_copy(orb_sub_group_t *group, int instance, void *buffer)
+{
+    if (!group || !buffer || instance < 0 || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return -RT_EINVAL;
+    }
+    orb_node_t *node = group_node(group, instance);
+    if (!node)
+    {
+        return 0;
+    }
+    /* 不传入订阅代数：直接取最新一条，orb_group_update 的未读消息保持不变 */
+    return orb_node_read(node, buffer, RT_NULL);
+}
+
+orb_subscr_t orb_group_handle(orb_sub_group_t *group, int instance)
+{
+    if (!group || instance < 0 || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return RT_NULL;
+    }
+    return group->subs[instance];
+}
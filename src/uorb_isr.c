@@ -0,0 +1,298 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_isr.h"
+#include "uorb_device_node.h"
+#include "uorb_trace.h"
+#include <rtthread.h>
+
+#ifdef UORB_USING_ISR_PUBLISH
+
+#define DBG_TAG "uorb.isr"
+#define DBG_LVL DBG_WARNING
+#include <rtdbg.h>
+
+/* 待派发节点链表：中断与下半部之间只通过该自旋锁（关中断）交接 */
+static struct rt_spinlock _isr_lock;
+static rt_list_t          _isr_pending;
+static rt_sem_t           _isr_sem;
+static rt_thread_t        _isr_thread;
+static orb_node_t        *_isr_current;   /* 下半部正在派发的节点 */
+static volatile rt_bool_t _isr_ready;
+static rt_bool_t          _isr_started;
+
+/* 下半部的消息缓冲，按最大的 o_size 增长（仅下半部线程使用） */
+static rt_uint8_t *_isr_buf;
+static rt_size_t   _isr_buf_size;
+
+static rt_uint32_t _isr_delivered;
+static rt_uint32_t _isr_dropped;
+
+/*
+ * 取出下一条未派发的消息；已被环形缓冲覆盖的计入丢失。
+ * buf 为空（缓冲分配失败）时直接跳到最新代数，全部计入丢失。
+ * @return RT_TRUE 取到一条，代数写入 generation；RT_FALSE 已派发到最新
+ */
+static rt_bool_t uorb_isr_next(orb_node_t *node, void *buf, rt_uint32_t *generation)
+{
+    rt_base_t         level = rt_spin_lock_irqsave(&node->lock);
+    const rt_uint32_t last  = node->generation;
+    rt_uint32_t       next  = node->isr_generation + 1;
+    rt_uint32_t       lost  = 0;
+    if (node->isr_generation == last)
+    {
+        rt_spin_unlock_irqrestore(&node->lock, level);
+        return RT_FALSE;
+    }
+    if (!buf)
+    {
+        lost = last - node->isr_generation;
+        next = last;
+    }
+    else if (last - node->isr_generation > node->queue_size)
+    {
+        lost = last - node->isr_generation - node->queue_size;
+        next = last - node->queue_size + 1;
+    }
+    if (buf)
+    {
+        rt_memcpy(buf, node->data + node->meta->o_size * ((next - 1) % node->queue_size), node->meta->o_size);
+    }
+    node->isr_generation = next;
+    rt_spin_unlock_irqrestore(&node->lock, level);
+
+    level = rt_spin_lock_irqsave(&_isr_lock);
+    _isr_dropped += lost;
+    if (buf)
+    {
+        _isr_delivered++;
+    }
+    rt_spin_unlock_irqrestore(&_isr_lock, level);
+    *generation = next;
+    return RT_TRUE;
+}
+
+/* 回调内删除了节点时 uorb_isr_forget() 会清空 _isr_current */
+static rt_bool_t uorb_isr_still_current(orb_node_t *node)
+{
+    rt_base_t level = rt_spin_lock_irqsave(&_isr_lock);
+    rt_bool_t same  = _isr_current == node;
+    rt_spin_unlock_irqrestore(&_isr_lock, level);
+    return same;
+}
+
+static void uorb_isr_entry(void *param)
+{
+    (void)param;
+    while (1)
+    {
+        rt_sem_take(_isr_sem, RT_WAITING_FOREVER);
+
+        /* 一次唤醒处理完全部待派发节点，多余的信号量计数只会空转一轮 */
+        while (1)
+        {
+            rt_base_t level = rt_spin_lock_irqsave(&_isr_lock);
+            if (rt_list_isempty(&_isr_pending))
+            {
+                rt_spin_unlock_irqrestore(&_isr_lock, level);
+                break;
+            }
+            orb_node_t *node = rt_list_entry(_isr_pending.next, orb_node_t, isr_entry);
+            rt_list_remove(&node->isr_entry);
+            rt_list_init(&node->isr_entry);
+            _isr_current = node;
+            rt_spin_unlock_irqrestore(&_isr_lock, level);
+
+            if (node->meta->o_size > _isr_buf_size)
+            {
+                rt_uint8_t *buf = rt_realloc(_isr_buf, node->meta->o_size);
+                if (buf)
+                {
+                    _isr_buf      = buf;
+                    _isr_buf_size = node->meta->o_size;
+                }
+            }
+            if (node->meta->o_size <= _isr_buf_size)
+            {
+                /* 按代数逐条派发环形缓冲中尚未派发的消息 */
+                rt_uint32_t generation;
+                while (uorb_isr_next(node, _isr_buf, &generation))
+                {
+                    orb_node_deliver(node, _isr_buf, generation);
+                    if (!uorb_isr_still_current(node))
+                    {
+                        break;
+                    }
+                }
+            }
+            else
+            {
+                /* 内存不足时至少唤醒等待者，数据已在环形缓冲中 */
+                rt_uint32_t generation;
+                (void)uorb_isr_next(node, RT_NULL, &generation);
+                uorb_notifier_notify(&node->notifier);
+            }
+
+            level        = rt_spin_lock_irqsave(&_isr_lock);
+            _isr_current = RT_NULL;
+            rt_spin_unlock_irqrestore(&_isr_lock, level);
+        }
+    }
+}
+
+/* 创建信号量与下半部线程；可重复调用 */
+static int uorb_isr_init(void)
+{
+    orb_registry_lock();
+    rt_bool_t claim = !_isr_started;
+    _isr_started    = RT_TRUE;
+    orb_registry_unlock();
+
+    if (!claim)
+    {
+        /* 其他线程正在初始化 */
+        while (!_isr_ready && _isr_started)
+        {
+            rt_thread_mdelay(1);
+        }
+        return _isr_ready ? RT_EOK : -RT_ENOMEM;
+    }
+
+    rt_spin_lock_init(&_isr_lock);
+    rt_list_init(&_isr_pending);
+    _isr_sem    = rt_sem_create("uorb_bh", 0, RT_IPC_FLAG_PRIO);
+    _isr_thread = _isr_sem ? rt_thread_create("uorb_bh", uorb_isr_entry, RT_NULL, UORB_ISR_THREAD_STACK,
+                                              UORB_ISR_THREAD_PRIORITY, 10) :
+                             RT_NULL;
+    if (!_isr_thread)
+    {
+        LOG_E("bottom half create failed");
+        if (_isr_sem)
+        {
+            rt_sem_delete(_isr_sem);
+            _isr_sem = RT_NULL;
+        }
+        _isr_started = RT_FALSE;
+        return -RT_ENOMEM;
+    }
+    _isr_ready = RT_TRUE;
+    rt_thread_startup(_isr_thread);
+    return RT_EOK;
+}
+INIT_COMPONENT_EXPORT(uorb_isr_init);
+
+int orb_prepare_isr(orb_advert_t handle)
+{
+    if (!handle)
+    {
+        return -RT_EINVAL;
+    }
+    if (orb_node_is_shm(handle))
+    {
+        return -RT_ENOSYS;
+    }
+    if (!_isr_ready && uorb_isr_init() != RT_EOK)
+    {
+        return -RT_ENOMEM;
+    }
+    if (orb_node_alloc(handle) != RT_EOK)
+    {
+        return -RT_ENOMEM;
+    }
+    /* 之前的发布已在线程上下文派发过 */
+    rt_base_t level        = rt_spin_lock_irqsave(&handle->lock);
+    handle->isr_generation = handle->generation;
+    rt_spin_unlock_irqrestore(&handle->lock, level);
+    handle->isr_ready = RT_TRUE;
+    return RT_EOK;
+}
+
+int orb_publish_isr(const struct orb_metadata *meta, orb_advert_t handle, const void *data)
+{
+    if (!handle || !data || (meta && handle->meta != meta) || !handle->advertised)
+    {
+        return -RT_EINVAL;
+    }
+    if (!_isr_ready)
+    {
+        return -RT_EBUSY;
+    }
+
+    /* 检查 isr_ready、写槽与入链在同一把锁内完成：uorb_isr_forget() 清标志后，
+     * 不会再有中断发布把正在删除的节点挂回待派发链表 */
+    rt_base_t level = rt_spin_lock_irqsave(&_isr_lock);
+    if (!handle->isr_ready)
+    {
+        rt_spin_unlock_irqrestore(&_isr_lock, level);
+        return -RT_EBUSY;
+    }
+
+    const rt_uint32_t generation = orb_node_store(handle, data);
+    UORB_TRACE(UORB_TRACE_PUBLISH, handle->id, generation);
+
+    /* 已在待派发链表上时无需再唤醒：下半部会按代数派发到最新 */
+    rt_bool_t first = rt_list_isempty(&handle->isr_entry);
+    if (first)
+    {
+        rt_list_insert_before(&_isr_pending, &handle->isr_entry);
+    }
+    rt_spin_unlock_irqrestore(&_isr_lock, level);
+
+    if (first)
+    {
+        rt_sem_release(_isr_sem);
+    }
+    return RT_EOK;
+}
+
+int orb_isr_get_stat(rt_uint32_t *delivered, rt_uint32_t *dropped)
+{
+    if (!_isr_ready)
+    {
+        return -RT_ENOSYS;
+    }
+    rt_base_t level = rt_spin_lock_irqsave(&_isr_lock);
+    if (delivered)
+    {
+        *delivered = _isr_delivered;
+    }
+    if (dropped)
+    {
+        *dropped = _isr_dropped;
+    }
+    rt_spin_unlock_irqrestore(&_isr_lock, level);
+    return RT_EOK;
+}
+
+void uorb_isr_forget(orb_node_t *node)
+{
+    if (!_isr_ready)
+    {
+        return;
+    }
+
+    rt_base_t level = rt_spin_lock_irqsave(&_isr_lock);
+    node->isr_ready = RT_FALSE;
+    if (!rt_list_isempty(&node->isr_entry))
+    {
+        rt_list_remove(&node->isr_entry);
+        rt_list_init(&node->isr_entry);
+    }
+    /* 等下半部派发完该节点；回调内删除节点时让下半部停止派发它 */
+    if (_isr_current == node && rt_thread_self() == _isr_thread)
+    {
+        _isr_current = RT_NULL;
+    }
+    while (_isr_current == node)
+    {
+        rt_spin_unlock_irqrestore(&_isr_lock, level);
+        rt_thread_mdelay(1);
+        level = rt_spin_lock_irqsave(&_isr_lock);
+    }
+    rt_spin_unlock_irqrestore(&_isr_lock, level);
+}
+
+#endif /* UORB_USING_ISR_PUBLISH */
@@ -0,0 +1,306 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_merge.h"
+#include "uorb_device_node.h"
+#include "uorb_fields.h"
+#include <rtthread.h>
+
+struct merge_src
+{
+    orb_subscribe_t *sub;       /* sub->generation 即游标 */
+    rt_uint16_t      ts_offset;
+    rt_bool_t        queued;    /* 已在堆中 */
+    rt_bool_t        has_last;
+    rt_uint64_t      head_ts;   /* 游标处消息的 timestamp */
+    rt_uint64_t      last_ts;   /* 最近输出的 timestamp */
+    rt_uint32_t      seen_gen;  /* 最近观察到的节点代数 */
+    uorb_clock_t     last_at;   /* 观察到代数变化的本地时刻 */
+    rt_uint32_t      lost;
+};
+
+struct orb_merge_s
+{
+    int               max_sources;
+    int               count;
+    int               heap_len;
+    uorb_clock_t      stall_clk;
+    rt_uint16_t      *heap;     /* 源序号，按 head_ts 升序 */
+    struct merge_src *src;
+};
+
+orb_merge_t *orb_merge_create(int max_sources)
+{
+    if (max_sources <= 0 || max_sources > RT_UINT16_MAX)
+    {
+        return RT_NULL;
+    }
+
+    /* 一次分配：控制块 + 源数组 + 堆 */
+    rt_size_t    size  = sizeof(orb_merge_t) + max_sources * (sizeof(struct merge_src) + sizeof(rt_uint16_t));
+    orb_merge_t *merge = rt_calloc(1, size);
+    if (!merge)
+    {
+        return RT_NULL;
+    }
+    merge->max_sources = max_sources;
+    merge->stall_clk   = uorb_clock_from_us(UORB_MERGE_STALL_US);
+    merge->src         = (struct merge_src *)(merge + 1);
+    merge->heap        = (rt_uint16_t *)(merge->src + max_sources);
+    return merge;
+}
+
+int orb_merge_delete(orb_merge_t *merge)
+{
+    if (!merge)
+    {
+        return -RT_EINVAL;
+    }
+    for (int i = 0; i < merge->count; i++)
+    {
+        orb_unsubscribe(merge->src[i].sub);
+    }
+    rt_free(merge);
+    return RT_EOK;
+}
+
+int orb_merge_add(orb_merge_t *merge, const struct orb_metadata *meta, uint8_t instance)
+{
+    if (!merge || !meta || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return -RT_EINVAL;
+    }
+    if (merge->count >= merge->max_sources)
+    {
+        return -RT_EFULL;
+    }
+
+    uorb_field_desc_t f;
+    if (uorb_fields_find(meta, "timestamp", &f) != RT_EOK || f.type != UORB_FIELD_UINT64 || f.count != 1)
+    {
+        return -RT_EINVAL;
+    }
+
+    /* 先建节点再订阅：游标从代数 0 开始，公告后的第一条也不会错过 */
+    if (!orb_node_find(meta, instance) && !orb_node_create(meta, instance, 0))
+    {
+        return -RT_ENOMEM;
+    }
+    orb_subscribe_t *sub = orb_subscribe_multi(meta, instance);
+    if (!sub)
+    {
+        return -RT_ENOMEM;
+    }
+
+    struct merge_src *s = &merge->src[merge->count];
+    rt_memset(s, 0, sizeof(*s));
+    s->sub       = sub;
+    s->ts_offset = (rt_uint16_t)f.offset;
+    s->seen_gen  = sub->generation;
+    s->last_at   = uorb_clock_now();
+    return merge->count++;
+}
+
+int orb_merge_set_stall_timeout(orb_merge_t *merge, rt_uint32_t timeout_us)
+{
+    if (!merge)
+    {
+        return -RT_EINVAL;
+    }
+    merge->stall_clk = timeout_us ? uorb_clock_from_us(timeout_us) : 0;
+    return RT_EOK;
+}
+
+static rt_bool_t merge_less(const orb_merge_t *merge, int a, int b)
+{
+    const struct merge_src *sa = &merge->src[a];
+    const struct merge_src *sb = &merge->src[b];
+    return sa->head_ts < sb->head_ts || (sa->head_ts == sb->head_ts && a < b);
+}
+
+static void merge_sift_up(orb_merge_t *merge, int pos)
+{
+    rt_uint16_t *h = merge->heap;
+    while (pos > 0)
+    {
+        int parent = (pos - 1) / 2;
+        if (!merge_less(merge, h[pos], h[parent]))
+        {
+            break;
+        }
+        rt_uint16_t t = h[pos];
+        h[pos]        = h[parent];
+        h[parent]     = t;
+        pos           = parent;
+    }
+}
+
+static void merge_sift_down(orb_merge_t *merge, int pos)
+{
+    rt_uint16_t *h = merge->heap;
+    for (;;)
+    {
+        int l = 2 * pos + 1, r = l + 1, m = pos;
+        if (l < merge->heap_len && merge_less(merge, h[l], h[m]))
+        {
+            m = l;
+        }
+        if (r < merge->heap_len && merge_less(merge, h[r], h[m]))
+        {
+            m = r;
+        }
+        if (m == pos)
+        {
+            break;
+        }
+        rt_uint16_t t = h[pos];
+        h[pos]        = h[m];
+        h[m]          = t;
+        pos           = m;
+    }
+}
+
+/* 查看源游标处的 timestamp；有未读消息返回 RT_TRUE */
+static rt_bool_t merge_peek(orb_merge_t *merge, int i, uorb_clock_t now)
+{
+    struct merge_src *s    = &merge->src[i];
+    orb_node_t       *node = s->sub->node;
+    if (!node)
+    {
+        return RT_FALSE;
+    }
+
+    rt_uint32_t gen = node->generation;
+    if (gen != s->seen_gen)
+    {
+        s->seen_gen = gen;
+        s->last_at  = now;
+    }
+
+    int ret = orb_node_peek_next_u64(node, &s->sub->generation, s->ts_offset, &s->head_ts);
+    if (ret < 0)
+    {
+        return RT_FALSE;
+    }
+    s->lost += (rt_uint32_t)ret;
+    return RT_TRUE;
+}
+
+/*
+ * 没有未读消息的源是否还要等：未停滞，且可能发布早于 ts 的消息。
+ * 尚未输出过消息的源即使还没公告也要等，避免启动阶段先到的源抢先输出；
+ * 输出过后又取消公告的源不再等待。
+ */
+static rt_bool_t merge_blocks(const orb_merge_t *merge, const struct merge_src *s, rt_uint64_t ts, uorb_clock_t now)
+{
+    if (merge->stall_clk == 0 || !s->sub->node)
+    {
+        return RT_FALSE;
+    }
+    if (!s->sub->node->advertised && s->has_last)
+    {
+        return RT_FALSE;
+    }
+    if (s->has_last && s->last_ts >= ts)
+    {
+        return RT_FALSE;
+    }
+    return (uorb_clock_t)(now - s->last_at) <= merge->stall_clk;
+}
+
+int orb_merge_next(orb_merge_t *merge, void *buffer, rt_size_t size, int *source)
+{
+    if (!merge || !buffer)
+    {
+        return -RT_EINVAL;
+    }
+
+    uorb_clock_t now = uorb_clock_now();
+
+    /* 补齐堆：不在堆中的源查看是否有了未读消息 */
+    for (int i = 0; i < merge->count; i++)
+    {
+        if (!merge->src[i].queued && merge_peek(merge, i, now))
+        {
+            merge->src[i].queued           = RT_TRUE;
+            merge->heap[merge->heap_len++] = (rt_uint16_t)i;
+            merge_sift_up(merge, merge->heap_len - 1);
+        }
+    }
+
+    if (merge->heap_len == 0)
+    {
+        return 0;
+    }
+
+    /* 堆顶入堆后可能已被覆盖：重新查看，timestamp 只会变大，下沉即可 */
+    int top;
+    for (;;)
+    {
+        top                = merge->heap[0];
+        rt_uint64_t before = merge->src[top].head_ts;
+        if (!merge_peek(merge, top, now) || merge->src[top].head_ts == before)
+        {
+            break;
+        }
+        merge_sift_down(merge, 0);
+    }
+
+    struct merge_src *s = &merge->src[top];
+    for (int i = 0; i < merge->count; i++)
+    {
+        if (!merge->src[i].queued && merge_blocks(merge, &merge->src[i], s->head_ts, now))
+        {
+            return 0;
+        }
+    }
+
+    orb_node_t *node = s->sub->node;
+    if (size < node->meta->o_size)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_uint32_t cursor = s->sub->generation;
+    int         ret    = orb_node_read(node, buffer, &s->sub->generation);
+    if (ret <= 0)
+    {
+        return ret;
+    }
+    if (s->sub->generation - cursor > 1)
+    {
+        s->lost += s->sub->generation - cursor - 1;
+    }
+    rt_memcpy(&s->last_ts, (const rt_uint8_t *)buffer + s->ts_offset, sizeof(s->last_ts));
+    s->has_last = RT_TRUE;
+
+    /* 源还有未读消息则原地更新键值，否则出堆 */
+    if (merge_peek(merge, top, now))
+    {
+        merge_sift_down(merge, 0);
+    }
+    else
+    {
+        s->queued      = RT_FALSE;
+        merge->heap[0]  = merge->heap[--merge->heap_len];
+        merge_sift_down(merge, 0);
+    }
+
+    if (source)
+    {
+        *source = top;
+    }
+    return ret;
+}
+
+rt_uint32_t orb_merge_lost(orb_merge_t *merge, int source)
+{
+    if (!merge || source < 0 || source >= merge->count)
+    {
+        return 0;
+    }
+    return merge->src[source].lost;
+}
@@ -5,17 +5,140 @@
 */
 
 #include "uORB.h"
+#include "uorb_fields.h"
 #include <rtthread.h>
 #include <stdbool.h>
 #include <stdint.h>
 #include <stddef.h>
 
+/* 数组最多打印的元素个数，其余以 "..." 省略 */
+#define PRINT_MAX_ELEMENTS 16
+
 const char *orb_get_c_type(unsigned char short_type)
 {
 	RT_UNUSED(short_type);
 	return RT_NULL;
 }
 
+/* rt_kprintf 不保证支持 64 位整数与浮点，统一先格式化为字符串 */
+static int print_u64(char *buf, int size, rt_uint64_t v)
+{
+	char tmp[21];
+	int  n = 0;
+	do
+	{
+		tmp[n++] = (char)('0' + v % 10);
+		v /= 10;
+	} while (v && n < (int)sizeof(tmp));
+
+	int len = 0;
+	while (n > 0 && len < size - 1)
+	{
+		buf[len++] = tmp[--n];
+	}
+	buf[len] = '\0';
+	return len;
+}
+
+int uorb_field_format(const void *data, rt_uint8_t type, char *buf, int size)
+{
+	const rt_uint8_t *p = (const rt_uint8_t *)data;
+	if (!p || !buf || size <= 1)
+	{
+		return 0;
+	}
+
+	switch (type)
+	{
+	case UORB_FIELD_INT64:
+	{
+		rt_int64_t v;
+		rt_memcpy(&v, p, sizeof(v));
+		if (v < 0)
+		{
+			buf[0] = '-';
+			return 1 + print_u64(buf + 1, size - 1, (rt_uint64_t)0 - (rt_uint64_t)v);
+		}
+		return print_u64(buf, size, (rt_uint64_t)v);
+	}
+	case UORB_FIELD_UINT64:
+	{
+		rt_uint64_t v;
+		rt_memcpy(&v, p, sizeof(v));
+		return print_u64(buf, size, v);
+	}
+	case UORB_FIELD_FLOAT:
+	case UORB_FIELD_DOUBLE:
+	{
+		/* 定点 4 位小数：整数与小数部分分开换算，避免放大后超出 64 位 */
+		double v   = uorb_field_value(p, type);
+		int    len = 0;
+		if (v != v)
+		{
+			return rt_snprintf(buf, size, "nan");
+		}
+		if (v < 0)
+		{
+			buf[len++] = '-';
+			v          = -v;
+		}
+		if (v >= 1e18)
+		{
+			return len + rt_snprintf(buf + len, size - len, "inf");
+		}
+		rt_uint64_t ip   = (rt_uint64_t)v;
+		unsigned    frac = (unsigned)((v - (double)ip) * 10000.0 + 0.5);
+		if (frac >= 10000u)
+		{
+			ip++;
+			frac -= 10000u;
+		}
+		len += print_u64(buf + len, size - len, ip);
+		return len + rt_snprintf(buf + len, size - len, ".%04u", frac);
+	}
+	case UORB_FIELD_UINT8:
+	case UORB_FIELD_UINT16:
+	case UORB_FIELD_UINT32:
+		return rt_snprintf(buf, size, "%u", (unsigned)uorb_field_value(p, type));
+	case UORB_FIELD_BOOL:
+		return rt_snprintf(buf, size, "%s", p[0] ? "true" : "false");
+	default:
+		return rt_snprintf(buf, size, "%d", (int)uorb_field_value(p, type));
+	}
+}
+
+static void print_field(const uorb_field_desc_t *f, const rt_uint8_t *msg)
+{
+	/* 字段名指向 o_fields 内部，不以 '\0' 结尾 */
+	const char       *name = f->name;
+	int               nlen = f->name_len;
+	const rt_uint8_t *p    = msg + f->offset;
+
+	if (f->type == UORB_FIELD_CHAR)
+	{
+		/* char 数组按字符串打印（不要求以 '\0' 结尾） */
+		rt_kprintf("    %.*s: \"%.*s\"\n", nlen, name, (int)rt_strnlen((const char *)p, f->count), (const char *)p);
+		return;
+	}
+
+	char value[32];
+	if (f->count == 1)
+	{
+		uorb_field_format(p, f->type, value, sizeof(value));
+		rt_kprintf("    %.*s: %s\n", nlen, name, value);
+		return;
+	}
+
+	rt_kprintf("    %.*s: [", nlen, name);
+	int shown = f->count < PRINT_MAX_ELEMENTS ? f->count : PRINT_MAX_ELEMENTS;
+	for (int i = 0; i < shown; i++)
+	{
+		uorb_field_format(p + i * f->type_size, f->type, value, sizeof(value));
+		rt_kprintf(i ? ", %s" : "%s", value);
+	}
+	rt_kprintf(f->count > shown ? ", ...]\n" : "]\n");
+}
+
 void orb_print_message_internal(const struct orb_metadata *meta, const void *data, bool print_topic_name)
 {
 	if (!meta || !data)
@@ -35,7 +158,19 @@ void orb_print_message_internal(const struct orb_metadata *meta, const void *dat
 		rt_kprintf("size=%d\n", size);
 	}
 
-	/* 十六进制转储（每行16字节） */
+	/* 按字段解码：布局每个主题只解析一次，之后走缓存 */
+	int count = 0;
+	const uorb_field_desc_t *fields = uorb_fields_layout(meta, &count);
+	if (fields)
+	{
+		for (int i = 0; i < count; i++)
+		{
+			print_field(&fields[i], bytes);
+		}
+		return;
+	}
+
+	/* 无法解析字段签名时退化为十六进制转储（每行16字节） */
 	for (int i = 0; i < size; i += 16)
 	{
 		rt_kprintf("  %03x: ", i);
@@ -46,4 +181,4 @@ void orb_print_message_internal(const struct orb_metadata *meta, const void *dat
 		}
 		rt_kprintf("\n");
 	}
-} 
\ No newline at end of file
+}
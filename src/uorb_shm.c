@@ -0,0 +1,420 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#define LOG_TAG "uorb.shm"
+#define LOG_LVL LOG_LVL_INFO
+
+#include "uorb_shm.h"
+#include "uorb_device_node.h"
+#include "uORB.h"
+#include <rtthread.h>
+#include <rtdbg.h>
+
+#ifdef UORB_USING_SHM
+#include <errno.h>
+#include <fcntl.h>
+#include <limits.h>
+#include <sched.h>
+#include <string.h>
+#include <time.h>
+#include <unistd.h>
+#include <linux/futex.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <sys/syscall.h>
+
+#define UORB_SHM_MAGIC    0x42524f55u /* "UORB" */
+#define UORB_SHM_VERSION  1
+#define UORB_SHM_NAME_MAX 32
+#ifndef UORB_SHM_TOPICS
+#define UORB_SHM_TOPICS 128
+#endif
+
+/* 段内对象只含定长字段，各进程映射地址不同，环形缓冲以相对段首的偏移表示 */
+struct uorb_shm_topic
+{
+    char        name[UORB_SHM_NAME_MAX]; /* o_name，空串表示空闲项 */
+    rt_uint32_t o_size;
+    rt_uint32_t offset;                  /* 环形缓冲相对段首的偏移 */
+    rt_uint8_t  instance;
+    rt_uint8_t  queue_size;
+    rt_uint16_t reserved;
+    rt_uint32_t seq;                     /* 顺序锁：奇数表示写入中，同时让多个写者互斥 */
+    rt_uint32_t generation;              /* 与 orb_node_t.generation 同义，也是 futex 字 */
+    rt_uint32_t waiters;                 /* futex 等待者数，为 0 时发布不做系统调用 */
+    rt_uint32_t advertisers;             /* 各进程公告者合计 */
+};
+
+struct uorb_shm_header
+{
+    rt_uint32_t           magic;         /* 创建者初始化完成后最后写入 */
+    rt_uint32_t           version;
+    rt_uint32_t           size;
+    rt_uint32_t           topics_nr;
+    rt_uint32_t           lock;          /* 主题表与分配器的自旋锁 */
+    rt_uint32_t           used;          /* 已分配到的偏移 */
+    struct uorb_shm_topic topics[UORB_SHM_TOPICS];
+};
+
+static struct uorb_shm_header *_shm;
+
+static void shm_table_lock(struct uorb_shm_header *hdr)
+{
+    rt_uint32_t expect = 0;
+    while (!__atomic_compare_exchange_n(&hdr->lock, &expect, 1, RT_FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+    {
+        expect = 0;
+        sched_yield();
+    }
+}
+
+static void shm_table_unlock(struct uorb_shm_header *hdr)
+{
+    __atomic_store_n(&hdr->lock, 0, __ATOMIC_RELEASE);
+}
+
+static struct uorb_shm_topic *shm_find_locked(struct uorb_shm_header *hdr, const char *name, rt_uint8_t instance)
+{
+    for (rt_uint32_t i = 0; i < hdr->topics_nr; i++)
+    {
+        struct uorb_shm_topic *t = &hdr->topics[i];
+        if (t->name[0] && t->instance == instance && rt_strncmp(t->name, name, UORB_SHM_NAME_MAX) == 0)
+        {
+            return t;
+        }
+    }
+    return RT_NULL;
+}
+
+static struct uorb_shm_topic *shm_alloc_locked(struct uorb_shm_header *hdr, const struct orb_metadata *meta,
+                                               rt_uint8_t instance, rt_uint8_t queue_size)
+{
+    rt_uint32_t offset = RT_ALIGN(hdr->used, 8);
+    rt_uint32_t bytes  = (rt_uint32_t)meta->o_size * queue_size;
+    if (offset + bytes > hdr->size)
+    {
+        return RT_NULL;
+    }
+    for (rt_uint32_t i = 0; i < hdr->topics_nr; i++)
+    {
+        struct uorb_shm_topic *t = &hdr->topics[i];
+        if (!t->name[0])
+        {
+            t->o_size     = meta->o_size;
+            t->offset     = offset;
+            t->instance   = instance;
+            t->queue_size = queue_size;
+            rt_strncpy(t->name, meta->o_name, UORB_SHM_NAME_MAX - 1);
+            hdr->used = offset + bytes;
+            return t;
+        }
+    }
+    return RT_NULL;
+}
+
+int orb_shm_attach(const char *name, rt_size_t size)
+{
+    if (_shm)
+    {
+        return -RT_EBUSY;
+    }
+    if (!name || size < sizeof(struct uorb_shm_header) || size > RT_UINT32_MAX)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_bool_t creator = RT_TRUE;
+    int       fd      = shm_open(name, O_RDWR | O_CREAT | O_EXCL, 0666);
+    if (fd < 0 && errno == EEXIST)
+    {
+        creator = RT_FALSE;
+        fd      = shm_open(name, O_RDWR, 0666);
+    }
+    if (fd < 0)
+    {
+        LOG_E("shm_open %s failed (%d)", name, errno);
+        return -RT_ERROR;
+    }
+
+    if (creator)
+    {
+        if (ftruncate(fd, (off_t)size) != 0)
+        {
+            close(fd);
+            shm_unlink(name);
+            return -RT_ERROR;
+        }
+    }
+    else
+    {
+        /* 创建者可能尚未设置大小：短暂等待 */
+        struct stat st;
+        for (int i = 0; i < 100 && (fstat(fd, &st) != 0 || (rt_size_t)st.st_size < sizeof(struct uorb_shm_header)); i++)
+        {
+            rt_thread_mdelay(10);
+        }
+        size = (rt_size_t)st.st_size;
+        if (size < sizeof(struct uorb_shm_header))
+        {
+            close(fd);
+            return -RT_ERROR;
+        }
+    }
+
+    void *base = mmap(RT_NULL, size, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+    close(fd);
+    if (base == MAP_FAILED)
+    {
+        return -RT_ERROR;
+    }
+
+    struct uorb_shm_header *hdr = (struct uorb_shm_header *)base;
+    if (creator)
+    {
+        /* ftruncate 已清零 */
+        hdr->version   = UORB_SHM_VERSION;
+        hdr->size      = (rt_uint32_t)size;
+        hdr->topics_nr = UORB_SHM_TOPICS;
+        hdr->used      = RT_ALIGN(sizeof(struct uorb_shm_header), 64);
+        __atomic_store_n(&hdr->magic, UORB_SHM_MAGIC, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        for (int i = 0; i < 100 && __atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != UORB_SHM_MAGIC; i++)
+        {
+            rt_thread_mdelay(10);
+        }
+        if (__atomic_load_n(&hdr->magic, __ATOMIC_ACQUIRE) != UORB_SHM_MAGIC || hdr->version != UORB_SHM_VERSION ||
+            hdr->topics_nr != UORB_SHM_TOPICS || hdr->size != size)
+        {
+            LOG_E("%s: incompatible segment", name);
+            munmap(base, size);
+            return -RT_ERROR;
+        }
+    }
+
+    _shm = hdr;
+    return RT_EOK;
+}
+
+void orb_shm_detach(void)
+{
+    struct uorb_shm_header *hdr = _shm;
+    if (hdr)
+    {
+        _shm = RT_NULL;
+        munmap(hdr, hdr->size);
+    }
+}
+
+int orb_shm_unlink(const char *name)
+{
+    return (name && shm_unlink(name) == 0) ? RT_EOK : -RT_ERROR;
+}
+
+rt_bool_t orb_shm_attached(void)
+{
+    return _shm != RT_NULL;
+}
+
+void uorb_shm_bind(orb_node_t *node)
+{
+    struct uorb_shm_header    *hdr  = _shm;
+    const struct orb_metadata *meta = node->meta;
+    if (!hdr)
+    {
+        return;
+    }
+    if (rt_strlen(meta->o_name) >= UORB_SHM_NAME_MAX)
+    {
+        LOG_W("%s: name too long, kept local", meta->o_name);
+        return;
+    }
+
+    shm_table_lock(hdr);
+    struct uorb_shm_topic *t = shm_find_locked(hdr, meta->o_name, node->instance);
+    if (!t)
+    {
+        t = shm_alloc_locked(hdr, meta, node->instance, node->queue_size);
+    }
+    shm_table_unlock(hdr);
+
+    if (!t)
+    {
+        LOG_W("%s%d: segment full, kept local", meta->o_name, node->instance);
+        return;
+    }
+    if (t->o_size != meta->o_size)
+    {
+        LOG_W("%s%d: size %u differs from shared %u, kept local", meta->o_name, node->instance,
+              (unsigned)meta->o_size, (unsigned)t->o_size);
+        return;
+    }
+
+    /* 队列长度以首个创建者为准 */
+    node->shm        = t;
+    node->queue_size = t->queue_size;
+    node->data       = (rt_uint8_t *)hdr + t->offset;
+    node->generation = __atomic_load_n(&t->generation, __ATOMIC_ACQUIRE);
+    node->data_valid = node->generation != 0;
+}
+
+orb_node_t *uorb_shm_lookup(const struct orb_metadata *meta, int instance)
+{
+    struct uorb_shm_header *hdr = _shm;
+    if (!hdr || !meta || instance < 0 || instance >= ORB_MULTI_MAX_INSTANCES)
+    {
+        return RT_NULL;
+    }
+
+    shm_table_lock(hdr);
+    struct uorb_shm_topic *t = shm_find_locked(hdr, meta->o_name, (rt_uint8_t)instance);
+    shm_table_unlock(hdr);
+    if (!t || __atomic_load_n(&t->advertisers, __ATOMIC_ACQUIRE) == 0)
+    {
+        return RT_NULL;
+    }
+
+    /* 本进程并发创建了同一实例时返回先登记的节点 */
+    return orb_node_create(meta, (rt_uint8_t)instance, t->queue_size);
+}
+
+void uorb_shm_sync(orb_node_t *node)
+{
+    struct uorb_shm_topic *t   = node->shm;
+    rt_uint32_t            gen = __atomic_load_n(&t->generation, __ATOMIC_ACQUIRE);
+    rt_bool_t adv = node->shm_advertised || __atomic_load_n(&t->advertisers, __ATOMIC_RELAXED) != 0;
+    if (gen == node->generation && adv == node->advertised)
+    {
+        return;
+    }
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    if ((rt_int32_t)(gen - node->generation) > 0)
+    {
+        node->generation = gen;
+        node->data_valid = RT_TRUE;
+    }
+    node->advertised = adv;
+    rt_spin_unlock_irqrestore(&node->lock, level);
+}
+
+void uorb_shm_advertise(orb_node_t *node, rt_bool_t advertised)
+{
+    if (!node->shm || node->shm_advertised == advertised)
+    {
+        return;
+    }
+    node->shm_advertised = advertised;
+    if (advertised)
+    {
+        __atomic_add_fetch(&node->shm->advertisers, 1, __ATOMIC_RELEASE);
+    }
+    else
+    {
+        __atomic_sub_fetch(&node->shm->advertisers, 1, __ATOMIC_RELEASE);
+    }
+}
+
+rt_uint32_t uorb_shm_write(orb_node_t *node, const void *data)
+{
+    struct uorb_shm_topic *t    = node->shm;
+    const rt_size_t        size = node->meta->o_size;
+
+    /* 顺序锁置为奇数即取得写权 */
+    rt_uint32_t seq;
+    for (;;)
+    {
+        seq = __atomic_load_n(&t->seq, __ATOMIC_RELAXED);
+        if (!(seq & 1) &&
+            __atomic_compare_exchange_n(&t->seq, &seq, seq + 1, RT_FALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED))
+        {
+            break;
+        }
+        sched_yield();
+    }
+    __atomic_thread_fence(__ATOMIC_RELEASE);
+
+    const rt_uint32_t gen = t->generation + 1;
+    rt_memcpy(node->data + size * ((gen - 1) % t->queue_size), data, size);
+    /* 代数与等待者计数都用顺序一致：要么发布者看到等待者，要么等待者的 futex 看到新代数 */
+    __atomic_store_n(&t->generation, gen, __ATOMIC_SEQ_CST);
+    __atomic_store_n(&t->seq, seq + 2, __ATOMIC_RELEASE);
+    if (__atomic_load_n(&t->waiters, __ATOMIC_SEQ_CST))
+    {
+        syscall(SYS_futex, &t->generation, FUTEX_WAKE, INT_MAX, RT_NULL, RT_NULL, 0);
+    }
+
+    rt_base_t level = rt_spin_lock_irqsave(&node->lock);
+    if ((rt_int32_t)(gen - node->generation) > 0)
+    {
+        node->generation = gen;
+    }
+    node->data_valid = RT_TRUE;
+    node->bytes_published += size;
+    rt_spin_unlock_irqrestore(&node->lock, level);
+    return gen;
+}
+
+rt_uint32_t uorb_shm_read_locked(orb_node_t *node, void *data, rt_uint32_t cursor, rt_uint32_t *next)
+{
+    struct uorb_shm_topic *t    = node->shm;
+    const rt_size_t        size = node->meta->o_size;
+
+    for (;;)
+    {
+        rt_uint32_t seq = __atomic_load_n(&t->seq, __ATOMIC_ACQUIRE);
+        if (seq & 1)
+        {
+            sched_yield();
+            continue;
+        }
+        rt_uint32_t current = __atomic_load_n(&t->generation, __ATOMIC_RELAXED);
+        if (current == 0)
+        {
+            *next = cursor;
+            return 0;
+        }
+        rt_uint32_t index = orb_node_select(current, cursor, t->queue_size, next);
+        rt_memcpy(data, node->data + size * (index % t->queue_size), size);
+        __atomic_thread_fence(__ATOMIC_ACQUIRE);
+        if (__atomic_load_n(&t->seq, __ATOMIC_RELAXED) == seq)
+        {
+            if ((rt_int32_t)(current - node->generation) > 0)
+            {
+                node->generation = current;
+                node->data_valid = RT_TRUE;
+            }
+            return current;
+        }
+    }
+}
+
+void uorb_shm_wait(orb_node_t *node, rt_uint32_t seen, rt_int32_t timeout_ms)
+{
+    struct uorb_shm_topic *t = node->shm;
+    __atomic_add_fetch(&t->waiters, 1, __ATOMIC_SEQ_CST);
+    if (__atomic_load_n(&t->generation, __ATOMIC_SEQ_CST) == seen)
+    {
+        struct timespec ts = {timeout_ms / 1000, (timeout_ms % 1000) * 1000000L};
+        syscall(SYS_futex, &t->generation, FUTEX_WAIT, seen, timeout_ms >= 0 ? &ts : RT_NULL, RT_NULL, 0);
+    }
+    __atomic_sub_fetch(&t->waiters, 1, __ATOMIC_SEQ_CST);
+}
+
+#ifdef UORB_SHM_AUTO_ATTACH
+static int uorb_shm_auto_attach(void)
+{
+    if (orb_shm_attach(UORB_SHM_NAME, UORB_SHM_SIZE) != RT_EOK)
+    {
+        LOG_E("attach %s failed, topics stay local", UORB_SHM_NAME);
+    }
+    return 0;
+}
+INIT_COMPONENT_EXPORT(uorb_shm_auto_attach);
+#endif
+
+#endif /* UORB_USING_SHM */
@@ -0,0 +1,154 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_trace.h"
+#include "uorb_internal.h"
+#include "uORB.h"
+#include <rtthread.h>
+
+#if (UORB_TRACE_BUF_SIZE & (UORB_TRACE_BUF_SIZE - 1)) != 0
+#error "UORB_TRACE_BUF_SIZE must be a power of two"
+#endif
+
+/* 每 CPU 一个环形缓冲：只有本 CPU 在关中断状态下写入，无需锁 */
+struct uorb_trace_ring
+{
+    rt_uint32_t      head;     /* 已写入的记录总数 */
+    rt_uint64_t      last_raw; /* 上一条记录的 uorb_prof_now() 原始值 */
+    rt_uint64_t      wrap;     /* 已累计的计数器回绕量 */
+    uorb_trace_rec_t rec[UORB_TRACE_BUF_SIZE];
+};
+
+static struct uorb_trace_ring _trace_rings[UORB_CPUS_NR];
+
+volatile rt_bool_t g_uorb_trace_on;
+
+void uorb_trace_record(rt_uint8_t event, rt_uint32_t node_id, rt_uint32_t generation)
+{
+    /* 先关中断再取 CPU 号：记录期间线程不会迁移，也不会被本 CPU 上的其他记录打断 */
+#ifdef RT_USING_SMP
+    rt_base_t level = rt_hw_local_irq_disable();
+#else
+    rt_base_t level = rt_hw_interrupt_disable();
+#endif
+    int                     cpu  = uorb_cpu_id();
+    struct uorb_trace_ring *ring = &_trace_rings[cpu];
+    uorb_trace_rec_t       *rec  = &ring->rec[ring->head & (UORB_TRACE_BUF_SIZE - 1)];
+    ring->head++;
+
+    /* 时间戳扩展为单调的 64 位值：cputime 常是 32 位计数器（DWT CYCCNT）零扩展而来，
+     * 同一 CPU 上读数变小即发生了回绕。要求本 CPU 每个计数周期内至少有一条记录
+     * （168 MHz 下约 25 s），空闲更久时跨越空闲段的间隔会少算整周期，同一 CPU 内顺序不变 */
+    rt_uint64_t raw = uorb_prof_now();
+    if (raw < ring->last_raw)
+    {
+        ring->wrap += 1ULL << 32;
+    }
+    ring->last_raw = raw;
+
+    rec->timestamp  = raw + ring->wrap;
+    rec->node_id    = node_id;
+    rec->generation = generation;
+    rec->thread     = (rt_uint32_t)(rt_ubase_t)rt_thread_self();
+    rec->event      = event;
+    rec->cpu        = (rt_uint8_t)cpu;
+    rec->flags      = rt_interrupt_get_nest() ? UORB_TRACE_FLAG_ISR : 0;
+    rec->reserved   = 0;
+#ifdef RT_USING_SMP
+    rt_hw_local_irq_enable(level);
+#else
+    rt_hw_interrupt_enable(level);
+#endif
+}
+
+void uorb_trace_start(void)
+{
+    g_uorb_trace_on = RT_TRUE;
+}
+
+void uorb_trace_stop(void)
+{
+    g_uorb_trace_on = RT_FALSE;
+}
+
+void uorb_trace_clear(void)
+{
+    for (int i = 0; i < UORB_CPUS_NR; i++)
+    {
+        _trace_rings[i].head = 0;
+    }
+}
+
+int uorb_trace_copy(int cpu, uorb_trace_rec_t *out, int max, rt_uint32_t *lost)
+{
+    if (cpu < 0 || cpu >= UORB_CPUS_NR || (max > 0 && !out))
+    {
+        return -RT_EINVAL;
+    }
+
+    const struct uorb_trace_ring *ring  = &_trace_rings[cpu];
+    rt_uint32_t                   head  = ring->head;
+    rt_uint32_t                   avail = head < UORB_TRACE_BUF_SIZE ? head : UORB_TRACE_BUF_SIZE;
+    if (lost)
+    {
+        *lost = head - avail;
+    }
+
+    rt_uint32_t n = (rt_uint32_t)max < avail ? (rt_uint32_t)max : avail;
+    for (rt_uint32_t i = 0; i < n; i++)
+    {
+        out[i] = ring->rec[(head - n + i) & (UORB_TRACE_BUF_SIZE - 1)];
+    }
+    return (int)n;
+}
+
+static const char *const trace_event_names[] = {"?", "PUB", "NOTIFY", "COPY", "WAIT", "WAKE"};
+
+void uorb_trace_dump(void)
+{
+    uorb_trace_stop();
+
+    /* 时间换算：每 1e9 个计数对应的微秒数（与时间戳一样以十六进制输出） */
+    rt_uint64_t us_per_g = uorb_prof_to_us(1000000000ULL);
+    rt_kprintf("# uorb-trace v1 cpus=%d us_per_gcount=%08x%08x\n", UORB_CPUS_NR, (unsigned)(us_per_g >> 32),
+               (unsigned)us_per_g);
+
+    /* 节点表：序号 -> 主题名与实例 */
+    int              count = orb_snapshot(RT_NULL, 0);
+    orb_node_stat_t *stats = count > 0 ? rt_malloc(sizeof(orb_node_stat_t) * count) : RT_NULL;
+    if (stats)
+    {
+        int n = orb_snapshot(stats, count);
+        for (int i = 0; i < n && i < count; i++)
+        {
+            rt_kprintf("N %u %s %d\n", (unsigned)stats[i].id, stats[i].meta->o_name, stats[i].instance);
+        }
+        rt_free(stats);
+    }
+
+    /* 记录：T cpu 时间戳(16位十六进制) 事件 节点 线程 代数 标志 */
+    for (int cpu = 0; cpu < UORB_CPUS_NR; cpu++)
+    {
+        const struct uorb_trace_ring *ring  = &_trace_rings[cpu];
+        rt_uint32_t                   head  = ring->head;
+        rt_uint32_t                   avail = head < UORB_TRACE_BUF_SIZE ? head : UORB_TRACE_BUF_SIZE;
+        if (head > avail)
+        {
+            rt_kprintf("# cpu %d lost %u\n", cpu, (unsigned)(head - avail));
+        }
+        for (rt_uint32_t i = head - avail; i != head; i++)
+        {
+            const uorb_trace_rec_t *r  = &ring->rec[i & (UORB_TRACE_BUF_SIZE - 1)];
+            const char             *ev = r->event < sizeof(trace_event_names) / sizeof(trace_event_names[0])
+                                             ? trace_event_names[r->event]
+                                             : "?";
+            rt_kprintf("T %d %08x%08x %s %u %08x %u %u\n", r->cpu, (unsigned)(r->timestamp >> 32),
+                       (unsigned)r->timestamp, ev, (unsigned)r->node_id, (unsigned)r->thread,
+                       (unsigned)r->generation, (unsigned)r->flags);
+        }
+    }
+    rt_kprintf("# end\n");
+}
@@ -7,6 +7,13 @@
 #include "uorb_internal.h"
 #include <rtthread.h>
 #include <string.h>
+#ifdef RT_USING_CPUTIME
+#include <rtdevice.h>
+#endif
+#if (defined(UORB_USING_PROFILING) || defined(UORB_USING_TRACE)) && (defined(__linux__) || defined(__APPLE__))
+#define UORB_PROF_HOST
+#include <time.h>
+#endif
 
 int uorb_lock_init(uorb_lock_t *lock, const char *name)
 {
@@ -77,6 +84,87 @@ void uorb_notifier_notify(uorb_notifier_t *notifier)
     rt_event_send(notifier->event, UORB_EVENT_UPDATE);
 }
 
+#ifdef RT_USING_CPUTIME
+/* 标定用计数：1e9 个 cputime 计数对应的微秒数，首次换算时计算一次 */
+#define UORB_CLOCK_CAL_COUNTS 1000000000ULL
+static rt_uint64_t g_uorb_clock_cal_us = 0;
+#endif
+
+uorb_clock_t uorb_clock_now(void)
+{
+#ifdef RT_USING_CPUTIME
+    return (uorb_clock_t)clock_cpu_gettime();
+#else
+    return rt_tick_get();
+#endif
+}
+
+uorb_clock_t uorb_clock_from_us(rt_uint32_t us)
+{
+    if (us == 0)
+    {
+        return 0;
+    }
+#ifdef RT_USING_CPUTIME
+    if (g_uorb_clock_cal_us == 0)
+    {
+        g_uorb_clock_cal_us = clock_cpu_microsecond(UORB_CLOCK_CAL_COUNTS);
+        if (g_uorb_clock_cal_us == 0)
+        {
+            g_uorb_clock_cal_us = 1;
+        }
+    }
+    uorb_clock_t counts = (uorb_clock_t)((rt_uint64_t)us * UORB_CLOCK_CAL_COUNTS / g_uorb_clock_cal_us);
+    return counts ? counts : 1;
+#else
+    /* 向上取整到节拍：保证实际间隔不短于设定值 */
+    return (uorb_clock_t)(((rt_uint64_t)us * RT_TICK_PER_SECOND + 999999u) / 1000000u);
+#endif
+}
+
+rt_uint64_t uorb_prof_now(void)
+{
+#if defined(UORB_PROF_HOST)
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return (rt_uint64_t)ts.tv_sec * 1000000000ULL + (rt_uint64_t)ts.tv_nsec;
+#elif defined(RT_USING_CPUTIME)
+    return (rt_uint64_t)clock_cpu_gettime();
+#else
+    return (rt_uint64_t)rt_tick_get();
+#endif
+}
+
+rt_uint64_t uorb_prof_since(rt_uint64_t t0)
+{
+    const rt_uint64_t now = uorb_prof_now();
+#if defined(UORB_PROF_HOST)
+    return now - t0;
+#elif defined(RT_USING_CPUTIME)
+    /* 按 32 位回绕：被测区间远小于 2^32 个计数，对 64 位计数器同样成立 */
+    return (rt_uint32_t)(now - t0);
+#else
+    return (rt_tick_t)(now - t0);
+#endif
+}
+
+rt_uint64_t uorb_prof_to_us(rt_uint64_t counts)
+{
+#if defined(UORB_PROF_HOST)
+    return counts / 1000u;
+#elif defined(RT_USING_CPUTIME)
+    /* 复用 uorb_clock 的标定值；分整段与余数换算，避免累计值相乘溢出 */
+    if (g_uorb_clock_cal_us == 0)
+    {
+        (void)uorb_clock_from_us(1);
+    }
+    return (counts / UORB_CLOCK_CAL_COUNTS) * g_uorb_clock_cal_us +
+           (counts % UORB_CLOCK_CAL_COUNTS) * g_uorb_clock_cal_us / UORB_CLOCK_CAL_COUNTS;
+#else
+    return counts * 1000000u / RT_TICK_PER_SECOND;
+#endif
+}
+
 rt_tick_t uorb_tick_now(void)
 {
     return rt_tick_get();
@@ -0,0 +1,415 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include "uorb_voter.h"
+#include "uorb_device_node.h"
+#include "uorb_fields.h"
+#include <rtthread.h>
+
+struct voter_inst
+{
+    orb_callback_t cb;
+    uorb_clock_t   last_at;    /* 最近一条消息的本地时刻 */
+    rt_uint64_t    last_ts;    /* 最近一条消息的 timestamp */
+    rt_uint32_t    hash;       /* 最近一条消息（不含 timestamp）的摘要 */
+    rt_uint16_t    same;       /* 摘要连续相同的条数 */
+    rt_uint8_t     flags;      /* ORB_VOTER_* 中由消息内容判定的部分 */
+    rt_bool_t      seen;
+    float          value;      /* 表决字段最新值 */
+    rt_uint32_t    errors;
+    rt_uint32_t    count;
+};
+
+struct orb_voter_s
+{
+    struct rt_spinlock         lock;
+    const struct orb_metadata *meta;
+    const struct orb_metadata *out_meta;
+    orb_advert_t               out;
+    int                        ninst;
+    rt_int16_t                 ts_offset;     /* -1 表示主题无 timestamp */
+    rt_int16_t                 value_offset;  /* -1 表示不做离群检测 */
+    rt_uint8_t                 value_type;
+    float                      threshold;
+    uorb_clock_t               timeout_clk;
+    rt_uint16_t                stuck_limit;
+    rt_int8_t                  selected;
+    rt_uint32_t                failovers;
+    rt_uint32_t                attached;      /* 已认领挂接的实例位图 */
+    struct voter_inst          inst[ORB_MULTI_MAX_INSTANCES];
+};
+
+/* FNV-1a，跳过 timestamp 字段 */
+static rt_uint32_t voter_hash(const orb_voter_t *v, const rt_uint8_t *msg)
+{
+    rt_uint32_t h = 2166136261U;
+    for (int i = 0; i < v->meta->o_size; i++)
+    {
+        if (v->ts_offset >= 0 && i >= v->ts_offset && i < v->ts_offset + (int)sizeof(rt_uint64_t))
+        {
+            continue;
+        }
+        h = (h ^ msg[i]) * 16777619U;
+    }
+    return h;
+}
+
+static rt_uint8_t voter_flags(const orb_voter_t *v, int i, uorb_clock_t now)
+{
+    const struct voter_inst *s     = &v->inst[i];
+    rt_uint8_t               flags = s->flags;
+    if (v->timeout_clk != 0 && (uorb_clock_t)(now - s->last_at) > v->timeout_clk)
+    {
+        flags |= ORB_VOTER_STALE;
+    }
+    return flags;
+}
+
+static rt_bool_t voter_healthy(const orb_voter_t *v, int i, uorb_clock_t now)
+{
+    const struct voter_inst *s = &v->inst[i];
+    return s->seen && s->cb.node && s->cb.node->advertised && voter_flags(v, i, now) == 0;
+}
+
+static rt_uint8_t voter_priority(const orb_voter_t *v, int i)
+{
+    return v->inst[i].cb.node ? v->inst[i].cb.node->priority : 0;
+}
+
+static int voter_choose(const orb_voter_t *v, uorb_clock_t now)
+{
+    int best = -1;
+    for (int i = 0; i < v->ninst; i++)
+    {
+        if (!voter_healthy(v, i, now))
+        {
+            continue;
+        }
+        if (best < 0 || voter_priority(v, i) > voter_priority(v, best) ||
+            (voter_priority(v, i) == voter_priority(v, best) && v->inst[i].errors < v->inst[best].errors))
+        {
+            best = i;
+        }
+    }
+
+    /* 当前实例仍健康时，只让位于优先级更高者 */
+    int cur = v->selected;
+    if (cur >= 0 && voter_healthy(v, cur, now) && (best < 0 || voter_priority(v, best) <= voter_priority(v, cur)))
+    {
+        return cur;
+    }
+    return best;
+}
+
+/* 重新选择并记录切换；调用方持有 v->lock */
+static int voter_select_locked(orb_voter_t *v, uorb_clock_t now)
+{
+    int sel = voter_choose(v, now);
+    if (sel != v->selected)
+    {
+        if (v->selected >= 0 && sel >= 0)
+        {
+            v->failovers++;
+        }
+        v->selected = (rt_int8_t)sel;
+    }
+    return sel;
+}
+
+/* 各实例（含自身，忽略离群标记）最新值的中位数；不足三个时无法判定 */
+static rt_bool_t voter_median(const orb_voter_t *v, uorb_clock_t now, float *median)
+{
+    float vals[ORB_MULTI_MAX_INSTANCES];
+    int   n = 0;
+    for (int i = 0; i < v->ninst; i++)
+    {
+        if (!v->inst[i].seen || (voter_flags(v, i, now) & ~ORB_VOTER_OUTLIER) != 0)
+        {
+            continue;
+        }
+        /* 插入排序，n 不超过实例数 */
+        int j = n++;
+        while (j > 0 && vals[j - 1] > v->inst[i].value)
+        {
+            vals[j] = vals[j - 1];
+            j--;
+        }
+        vals[j] = v->inst[i].value;
+    }
+    if (n < 3)
+    {
+        return RT_FALSE;
+    }
+    *median = (n & 1) ? vals[n / 2] : 0.5f * (vals[n / 2 - 1] + vals[n / 2]);
+    return RT_TRUE;
+}
+
+static void voter_set_fault(struct voter_inst *s, rt_uint8_t flag, rt_bool_t on)
+{
+    if (on && !(s->flags & flag))
+    {
+        s->flags |= flag;
+        s->errors++;
+    }
+    else if (!on)
+    {
+        s->flags &= (rt_uint8_t)~flag;
+    }
+}
+
+/* 发布路径：更新该实例的评分并重新选择；选中者的消息直接转发 */
+static void voter_on_publish(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    orb_voter_t      *v   = (orb_voter_t *)context;
+    const rt_uint8_t *msg = (const rt_uint8_t *)data;
+    (void)meta;
+
+    if (instance >= v->ninst)
+    {
+        return;
+    }
+
+    uorb_clock_t       now = uorb_clock_now();
+    struct voter_inst *s   = &v->inst[instance];
+
+    rt_base_t level = rt_spin_lock_irqsave(&v->lock);
+    s->count++;
+    s->last_at = now;
+
+    if (v->ts_offset >= 0)
+    {
+        rt_uint64_t ts;
+        rt_memcpy(&ts, msg + v->ts_offset, sizeof(ts));
+        voter_set_fault(s, ORB_VOTER_TS_ERROR, s->seen && ts <= s->last_ts);
+        s->last_ts = ts;
+    }
+
+    if (v->stuck_limit > 0)
+    {
+        rt_uint32_t h = voter_hash(v, msg);
+        s->same       = (s->seen && h == s->hash) ? (rt_uint16_t)(s->same + 1) : 1;
+        s->hash       = h;
+        voter_set_fault(s, ORB_VOTER_STUCK, s->same >= v->stuck_limit);
+    }
+
+    if (v->value_offset >= 0)
+    {
+        float     median;
+        rt_bool_t outlier = RT_FALSE;
+        s->value          = (float)uorb_field_value(msg + v->value_offset, v->value_type);
+        s->seen           = RT_TRUE;
+        if (voter_median(v, now, &median))
+        {
+            float diff = s->value - median;
+            outlier    = (diff > v->threshold || diff < -v->threshold);
+        }
+        voter_set_fault(s, ORB_VOTER_OUTLIER, outlier);
+    }
+    s->seen = RT_TRUE;
+
+    int       sel     = voter_select_locked(v, now);
+    rt_bool_t forward = (sel == instance);
+    rt_spin_unlock_irqrestore(&v->lock, level);
+
+    if (forward)
+    {
+        (void)orb_publish(v->out_meta, v->out, data);
+    }
+}
+
+/*
+ * 只挂接已存在的实例节点，不为可能永远不出现的实例创建节点。
+ * 不能在发布回调里挂接：那时持有本节点 cb_lock，再取其他节点的 cb_lock 会与对方的发布路径互锁，
+ * 因此由调用方上下文（创建、orb_voter_update）补挂后来出现的实例。
+ */
+static void voter_attach(orb_voter_t *v)
+{
+    for (int i = 0; i < v->ninst; i++)
+    {
+        rt_uint32_t bit = 1U << i;
+        if ((v->attached & bit) || !orb_node_find(v->meta, i))
+        {
+            continue;
+        }
+
+        /* 先认领再注册，并发补挂时同一实例只注册一次 */
+        rt_base_t level = rt_spin_lock_irqsave(&v->lock);
+        rt_bool_t claim = !(v->attached & bit);
+        v->attached |= bit;
+        rt_spin_unlock_irqrestore(&v->lock, level);
+
+        if (claim && orb_register_callback_ctx(v->meta, (uint8_t)i, &v->inst[i].cb, voter_on_publish, v) != RT_EOK)
+        {
+            level = rt_spin_lock_irqsave(&v->lock);
+            v->attached &= ~bit;
+            rt_spin_unlock_irqrestore(&v->lock, level);
+        }
+    }
+}
+
+orb_voter_t *orb_voter_create(const struct orb_metadata *meta, const struct orb_metadata *out_meta, int instances)
+{
+    if (!meta || !out_meta || meta == out_meta || meta->o_size != out_meta->o_size ||
+        instances < 0 || instances > ORB_MULTI_MAX_INSTANCES)
+    {
+        return RT_NULL;
+    }
+
+    orb_voter_t *v = rt_calloc(1, sizeof(orb_voter_t));
+    if (!v)
+    {
+        return RT_NULL;
+    }
+    rt_spin_lock_init(&v->lock);
+    v->meta         = meta;
+    v->out_meta     = out_meta;
+    v->ninst        = instances ? instances : ORB_MULTI_MAX_INSTANCES;
+    v->ts_offset    = -1;
+    v->value_offset = -1;
+    v->selected     = -1;
+    v->timeout_clk  = uorb_clock_from_us(UORB_VOTER_TIMEOUT_US);
+
+    uorb_field_desc_t f;
+    if (uorb_fields_find(meta, "timestamp", &f) == RT_EOK && f.type == UORB_FIELD_UINT64 && f.count == 1)
+    {
+        v->ts_offset = (rt_int16_t)f.offset;
+    }
+
+    v->out = orb_advertise(out_meta, RT_NULL);
+    if (!v->out)
+    {
+        rt_free(v);
+        return RT_NULL;
+    }
+
+    voter_attach(v);
+    return v;
+}
+
+int orb_voter_delete(orb_voter_t *voter)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+    for (int i = 0; i < voter->ninst; i++)
+    {
+        if (voter->inst[i].cb.node)
+        {
+            orb_unregister_callback_ctx(&voter->inst[i].cb);
+        }
+    }
+    orb_unadvertise(voter->out);
+    rt_free(voter);
+    return RT_EOK;
+}
+
+int orb_voter_set_timeout(orb_voter_t *voter, rt_uint32_t timeout_us)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+    voter->timeout_clk = timeout_us ? uorb_clock_from_us(timeout_us) : 0;
+    return RT_EOK;
+}
+
+int orb_voter_set_stuck_limit(orb_voter_t *voter, rt_uint16_t count)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+    rt_base_t level     = rt_spin_lock_irqsave(&voter->lock);
+    voter->stuck_limit  = count;
+    for (int i = 0; i < voter->ninst; i++)
+    {
+        voter->inst[i].same = 0;
+        voter->inst[i].flags &= (rt_uint8_t)~ORB_VOTER_STUCK;
+    }
+    rt_spin_unlock_irqrestore(&voter->lock, level);
+    return RT_EOK;
+}
+
+int orb_voter_set_outlier(orb_voter_t *voter, const char *field, float threshold)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+
+    rt_int16_t offset = -1;
+    rt_uint8_t type   = 0;
+    if (field)
+    {
+        uorb_field_desc_t f;
+        if (uorb_fields_find(voter->meta, field, &f) != RT_EOK || f.type == UORB_FIELD_CHAR)
+        {
+            return -RT_ENOENT;
+        }
+        offset = (rt_int16_t)f.offset;
+        type   = f.type;
+    }
+
+    rt_base_t level     = rt_spin_lock_irqsave(&voter->lock);
+    voter->value_offset = offset;
+    voter->value_type   = type;
+    voter->threshold    = threshold;
+    for (int i = 0; i < voter->ninst; i++)
+    {
+        voter->inst[i].flags &= (rt_uint8_t)~ORB_VOTER_OUTLIER;
+    }
+    rt_spin_unlock_irqrestore(&voter->lock, level);
+    return RT_EOK;
+}
+
+int orb_voter_update(orb_voter_t *voter)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+    voter_attach(voter);
+
+    /* 没有新发布时按时间重新评估：选中实例超时即让位或置为无可用实例 */
+    uorb_clock_t now   = uorb_clock_now();
+    rt_base_t    level = rt_spin_lock_irqsave(&voter->lock);
+    (void)voter_select_locked(voter, now);
+    rt_spin_unlock_irqrestore(&voter->lock, level);
+    return RT_EOK;
+}
+
+int orb_voter_selected(orb_voter_t *voter)
+{
+    if (!voter)
+    {
+        return -RT_EINVAL;
+    }
+    (void)orb_voter_update(voter);
+    int sel = voter->selected;
+    return sel >= 0 ? sel : -RT_ENOENT;
+}
+
+rt_uint32_t orb_voter_failovers(orb_voter_t *voter)
+{
+    return voter ? voter->failovers : 0;
+}
+
+int orb_voter_status(orb_voter_t *voter, int instance, orb_voter_status_t *status)
+{
+    if (!voter || !status || instance < 0 || instance >= voter->ninst)
+    {
+        return -RT_EINVAL;
+    }
+    uorb_clock_t now   = uorb_clock_now();
+    rt_base_t    level = rt_spin_lock_irqsave(&voter->lock);
+    status->flags      = voter->inst[instance].seen ? voter_flags(voter, instance, now) : ORB_VOTER_STALE;
+    status->priority   = voter_priority(voter, instance);
+    status->errors     = voter->inst[instance].errors;
+    status->count      = voter->inst[instance].count;
+    rt_spin_unlock_irqrestore(&voter->lock, level);
+    return RT_EOK;
+}
@@ -24,9 +24,28 @@ static void run_device_node_tests(void)
     rt_kprintf("Or use 'test_device_node' command for quick test execution.\n");
     rt_kprintf("Additional test suites available:\n");
     rt_kprintf("  - uorb.core         (core API tests)\n");
+    rt_kprintf("  - uorb.callback     (callback API tests)\n");
     rt_kprintf("  - uorb.interval     (interval behavior tests)\n");
+    rt_kprintf("  - uorb.pub_rate     (publisher rate limit tests)\n");
+    rt_kprintf("  - uorb.filter       (content filter tests)\n");
+    rt_kprintf("  - uorb.isr          (ISR publish tests)\n");
+    rt_kprintf("  - uorb.defer        (deferred publish tests)\n");
+    rt_kprintf("  - uorb.aggregate    (aggregation tests)\n");
+    rt_kprintf("  - uorb.fields       (field layout/print tests)\n");
     rt_kprintf("  - uorb.multi        (multi-instance tests)\n");
+    rt_kprintf("  - uorb.group        (group subscription tests)\n");
+    rt_kprintf("  - uorb.voter        (voter tests)\n");
+    rt_kprintf("  - uorb.trace        (event trace tests)\n");
+    rt_kprintf("  - uorb.shm          (shared memory tests)\n");
+    rt_kprintf("  - uorb.bridge       (stream bridge tests)\n");
+    rt_kprintf("  - uorb.merge        (merge tests)\n");
     rt_kprintf("  - uorb.integration  (integration tests)\n");
+#ifdef UORB_USING_CXX
+    rt_kprintf("  - uorb.cxx_wq       (C++ work queue tests)\n");
+#endif
+#ifdef UORB_USING_CXX_COROUTINE
+    rt_kprintf("  - uorb.cxx_co       (C++ coroutine tests)\n");
+#endif
 #ifdef UORB_REGISTER_AS_DEVICE
     rt_kprintf("  - uorb.device_if    (device interface tests)\n");
 #endif
@@ -82,9 +101,28 @@ static int cmd_test_uorb(int argc, char **argv)
         rt_kprintf("uORB Test Suites:\n");
         rt_kprintf("  uorb.device_node\n");
         rt_kprintf("  uorb.core\n");
+        rt_kprintf("  uorb.callback\n");
         rt_kprintf("  uorb.interval\n");
+        rt_kprintf("  uorb.pub_rate\n");
+        rt_kprintf("  uorb.filter\n");
+        rt_kprintf("  uorb.isr\n");
+        rt_kprintf("  uorb.defer\n");
+        rt_kprintf("  uorb.aggregate\n");
+        rt_kprintf("  uorb.fields\n");
         rt_kprintf("  uorb.multi\n");
+        rt_kprintf("  uorb.group\n");
+        rt_kprintf("  uorb.voter\n");
+        rt_kprintf("  uorb.trace\n");
+        rt_kprintf("  uorb.shm\n");
+        rt_kprintf("  uorb.bridge\n");
+        rt_kprintf("  uorb.merge\n");
         rt_kprintf("  uorb.integration\n");
+#ifdef UORB_USING_CXX
+        rt_kprintf("  uorb.cxx_wq\n");
+#endif
+#ifdef UORB_USING_CXX_COROUTINE
+        rt_kprintf("  uorb.cxx_co\n");
+#endif
 #ifdef UORB_REGISTER_AS_DEVICE
         rt_kprintf("  uorb.device_if\n");
 #endif
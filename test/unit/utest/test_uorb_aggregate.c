@@ -0,0 +1,115 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_aggregate.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#include "topics/sensor_demo.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+static void test_aggregate_window(void)
+{
+    struct sensor_demo_s s = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    uassert_true(adv != RT_NULL);
+
+    orb_aggregate_t *agg = orb_aggregate_create(ORB_ID(sensor_demo), (uint8_t)inst);
+    uassert_true(agg != RT_NULL);
+    /* timestamp 不参与统计，x/y/z 三个槽 */
+    uassert_int_equal(orb_aggregate_slots(agg), 3);
+    int ix = orb_aggregate_find(agg, "x", 0);
+    int iz = orb_aggregate_find(agg, "z", 0);
+    uassert_true(ix >= 0 && iz >= 0);
+    uassert_int_equal(orb_aggregate_find(agg, "timestamp", 0), -RT_ENOENT);
+    uassert_int_equal(orb_aggregate_find(agg, "x", 1), -RT_EINVAL);
+
+    for (int i = 1; i <= 10; i++)
+    {
+        s.timestamp = 1000u * i;
+        s.x = i;
+        s.y = 0;
+        s.z = -i;
+        (void)orb_publish(ORB_ID(sensor_demo), adv, &s);
+    }
+
+    orb_aggregate_window_t win;
+    orb_aggregate_stat_t   st[3];
+    uassert_int_equal(orb_aggregate_read(agg, &win, st, 3), 10);
+    uassert_int_equal(win.count, 10);
+    uassert_true(win.first_ts == 1000u && win.last_ts == 10000u);
+    uassert_true(st[ix].min == 1.0f && st[ix].max == 10.0f);
+    uassert_true(st[ix].mean > 5.49f && st[ix].mean < 5.51f);
+    uassert_true(st[iz].min == -10.0f && st[iz].max == -1.0f);
+
+    /* 读取后窗口清空 */
+    uassert_int_equal(orb_aggregate_read(agg, &win, st, 3), 0);
+    uassert_int_equal(win.count, 0);
+
+    s.x = 42; (void)orb_publish(ORB_ID(sensor_demo), adv, &s);
+    uassert_int_equal(orb_aggregate_read(agg, RT_NULL, st, 3), 1);
+    uassert_true(st[ix].min == 42.0f && st[ix].max == 42.0f && st[ix].mean == 42.0f);
+
+    uassert_int_equal(orb_aggregate_delete(agg), RT_EOK);
+    orb_unadvertise(adv);
+}
+
+struct agg_count_s
+{
+    rt_uint64_t timestamp;
+    rt_uint32_t seq;
+    rt_int64_t  pos;
+};
+
+static const struct orb_metadata agg_count_meta = {
+    "uorb_agg_count", sizeof(struct agg_count_s), sizeof(struct agg_count_s),
+    "uint64_t timestamp;uint32 seq;int64 pos;", 0,
+};
+
+/* 超过 2^24 的整数字段：极值逐一精确，不被舍入到相邻的 float */
+static void test_aggregate_large_int(void)
+{
+    struct agg_count_s m = {0};
+    orb_advert_t adv = orb_advertise(&agg_count_meta, &m);
+    uassert_true(adv != RT_NULL);
+    orb_aggregate_t *agg = orb_aggregate_create(&agg_count_meta, 0);
+    uassert_true(agg != RT_NULL);
+    int iseq = orb_aggregate_find(agg, "seq", 0);
+    int ipos = orb_aggregate_find(agg, "pos", 0);
+    uassert_true(iseq >= 0 && ipos >= 0);
+
+    for (int i = 1; i <= 3; i++)
+    {
+        m.seq = 16777216u + (rt_uint32_t)i;
+        m.pos = -(rt_int64_t)4000000001LL * i;
+        (void)orb_publish(&agg_count_meta, adv, &m);
+    }
+
+    orb_aggregate_stat_t st[2];
+    uassert_int_equal(orb_aggregate_read(agg, RT_NULL, st, 2), 3);
+    uassert_true(st[iseq].min == 16777217.0 && st[iseq].max == 16777219.0);
+    uassert_true(st[iseq].mean == 16777218.0);
+    uassert_true(st[ipos].min == -12000000003.0 && st[ipos].max == -4000000001.0);
+
+    uassert_int_equal(orb_aggregate_delete(agg), RT_EOK);
+    orb_unadvertise(adv);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_aggregate_window);
+    UTEST_UNIT_RUN(test_aggregate_large_int);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.aggregate", tc_init, tc_cleanup, 20);
@@ -0,0 +1,168 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_bridge.h"
+
+#if defined(UORB_USING_BRIDGE)
+struct bridge_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+    /* 尾部 4 字节填充不上线 */
+};
+
+static const struct orb_metadata bridge_meta = {
+    "uorb_bridge_topic",
+    sizeof(struct bridge_msg_s),
+    12,
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+/* 内存回环：发送端写入的字节由测试交给接收端 */
+static rt_uint8_t  wire[1024];
+static rt_size_t   wire_len;
+
+static rt_ssize_t wire_write(void *ctx, const void *buf, rt_size_t len)
+{
+    (void)ctx;
+    if (wire_len + len > sizeof(wire))
+    {
+        return 0;
+    }
+    rt_memcpy(wire + wire_len, buf, len);
+    wire_len += len;
+    return (rt_ssize_t)len;
+}
+
+static const orb_bridge_io_t wire_io = {wire_write, RT_NULL, RT_NULL};
+
+static orb_bridge_t *tx_bridge;
+static orb_bridge_t *rx_bridge;
+static orb_advert_t  adv;
+static orb_subscr_t  remote;
+
+static rt_err_t tc_init(void)
+{
+    wire_len  = 0;
+    adv       = orb_advertise_queue(&bridge_meta, RT_NULL, 4);
+    tx_bridge = orb_bridge_create(&wire_io, 4);
+    rx_bridge = orb_bridge_create(&wire_io, 4);
+    if (!adv || !tx_bridge || !rx_bridge || orb_bridge_add_tx(tx_bridge, &bridge_meta, 0) != RT_EOK ||
+        orb_bridge_add_rx(rx_bridge, &bridge_meta) != RT_EOK)
+    {
+        return -RT_ERROR;
+    }
+    /* 同一进程内回环：接收端重新发布到下一个实例 */
+    remote = orb_subscribe_multi(&bridge_meta, 1);
+    return remote ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    orb_bridge_delete(tx_bridge);
+    orb_bridge_delete(rx_bridge);
+    orb_unsubscribe(remote);
+    orb_unadvertise(adv);
+    return RT_EOK;
+}
+
+static void publish(rt_int32_t val)
+{
+    struct bridge_msg_s m = {(rt_uint64_t)val * 1000, val};
+    orb_publish(&bridge_meta, adv, &m);
+}
+
+/* 多条消息合为一帧，逐字节输入也能完整解析，payload 按 o_size_no_padding 传输 */
+static void test_bridge_batch(void)
+{
+    wire_len = 0;
+    publish(1);
+    publish(2);
+    publish(3);
+    uassert_int_equal(orb_bridge_flush(tx_bridge), 3);
+    uassert_int_equal(orb_bridge_flush(tx_bridge), 0);
+    uassert_int_equal(wire_len, UORB_BRIDGE_HDR_SIZE + 3 * (UORB_BRIDGE_REC_SIZE + 12) + UORB_BRIDGE_CRC_SIZE);
+
+    int published = 0;
+    for (rt_size_t i = 0; i < wire_len; i++)
+    {
+        published += orb_bridge_input(rx_bridge, &wire[i], 1);
+    }
+    uassert_int_equal(published, 3);
+
+    struct bridge_msg_s m = {0};
+    uassert_int_equal(orb_copy(&bridge_meta, remote, &m), sizeof(m));
+    uassert_int_equal(m.val, 3);
+    uassert_true(m.timestamp == 3000);
+
+    orb_bridge_stat_t st;
+    orb_bridge_get_stat(tx_bridge, &st);
+    uassert_int_equal(st.tx_frames, 1);
+    uassert_int_equal(st.tx_msgs, 3);
+    orb_bridge_get_stat(rx_bridge, &st);
+    uassert_int_equal(st.rx_frames, 1);
+    uassert_int_equal(st.rx_msgs, 3);
+    uassert_int_equal(st.rx_lost, 0);
+}
+
+/* 损坏的帧被丢弃，之后越过垃圾字节重新同步；generation 跳变计入 lost */
+static void test_bridge_crc_and_lost(void)
+{
+    orb_bridge_stat_t before, st;
+    orb_bridge_get_stat(rx_bridge, &before);
+
+    wire_len = 0;
+    publish(10);
+    uassert_int_equal(orb_bridge_flush(tx_bridge), 1);
+    wire[UORB_BRIDGE_HDR_SIZE + UORB_BRIDGE_REC_SIZE] ^= 0x40;
+    uassert_int_equal(orb_bridge_input(rx_bridge, wire, wire_len), 0);
+
+    /* 队列长度 4：6 条中最早的 2 条已被覆盖，加上损坏帧中的 1 条共丢失 3 条 */
+    static const rt_uint8_t junk[] = {0x00, UORB_BRIDGE_SYNC0, 0x13, UORB_BRIDGE_SYNC0};
+    wire_len = 0;
+    wire_write(RT_NULL, junk, sizeof(junk));
+    for (int i = 11; i <= 16; i++)
+    {
+        publish(i);
+    }
+    uassert_int_equal(orb_bridge_flush(tx_bridge), 4);
+    uassert_int_equal(orb_bridge_input(rx_bridge, wire, wire_len), 4);
+
+    struct bridge_msg_s m = {0};
+    uassert_int_equal(orb_copy(&bridge_meta, remote, &m), sizeof(m));
+    uassert_int_equal(m.val, 16);
+
+    orb_bridge_get_stat(rx_bridge, &st);
+    uassert_int_equal(st.rx_crc_errors - before.rx_crc_errors, 1);
+    uassert_int_equal(st.rx_msgs - before.rx_msgs, 4);
+    uassert_int_equal(st.rx_lost - before.rx_lost, 3);
+    uassert_int_equal(st.rx_dropped, 0);
+}
+
+/* 同一主题不能在一个桥上同时收发；消息须放得进一帧 */
+static void test_bridge_config(void)
+{
+    static const struct orb_metadata big = {"uorb_bridge_big", UORB_BRIDGE_FRAME_MAX, UORB_BRIDGE_FRAME_MAX, "uint8[256] b;", 0};
+    uassert_int_equal(orb_bridge_add_rx(tx_bridge, &bridge_meta), -RT_EBUSY);
+    uassert_int_equal(orb_bridge_add_tx(rx_bridge, &bridge_meta, 0), -RT_EBUSY);
+    uassert_int_equal(orb_bridge_add_tx(tx_bridge, &bridge_meta, 0), -RT_EBUSY);
+    uassert_int_equal(orb_bridge_add_rx(rx_bridge, &big), -RT_EINVAL);
+    uassert_true(orb_bridge_topic_id(&bridge_meta) != orb_bridge_topic_id(&big));
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_bridge_batch);
+    UTEST_UNIT_RUN(test_bridge_crc_and_lost);
+    UTEST_UNIT_RUN(test_bridge_config);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.bridge", tc_init, tc_cleanup, 20);
+#endif
@@ -0,0 +1,192 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#include "topics/sensor_demo.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+struct cb_ctx
+{
+    int                        calls;
+    int32_t                    last_val;
+    uint8_t                    instance;
+    const struct orb_metadata *meta;
+    orb_subscr_t               sub;   /* 非空时在回调内 orb_copy */
+    int32_t                    copied_val;
+};
+
+static void test_cb_fn(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    struct cb_ctx *ctx = (struct cb_ctx *)context;
+    const struct orb_test_s *msg = (const struct orb_test_s *)data;
+    ctx->calls++;
+    ctx->meta = meta;
+    ctx->instance = instance;
+    ctx->last_val = msg->val;
+    if (ctx->sub)
+    {
+        struct orb_test_s rx = {0};
+        if (orb_copy(ORB_ID(orb_test), ctx->sub, &rx) > 0)
+        {
+            ctx->copied_val = rx.val;
+        }
+    }
+}
+
+static void test_callback_ctx_message(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+
+    struct cb_ctx ctx = {0};
+    orb_callback_t cb = {0};
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), (uint8_t)inst, &cb, test_cb_fn, &ctx), RT_EOK);
+    /* 重复注册同一条目应被拒绝 */
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), (uint8_t)inst, &cb, test_cb_fn, &ctx), -RT_EINVAL);
+    /* 实例号越界是参数错误 */
+    orb_callback_t bad = {0};
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), ORB_MULTI_MAX_INSTANCES, &bad, test_cb_fn, &ctx),
+                      -RT_EINVAL);
+    uassert_null(bad.node);
+
+    t.val = 5; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(ctx.calls, 1);
+    uassert_int_equal(ctx.last_val, 5);
+    uassert_int_equal(ctx.instance, inst);
+    uassert_ptr_equal(ctx.meta, ORB_ID(orb_test));
+
+    uassert_int_equal(orb_unregister_callback_ctx(&cb), RT_EOK);
+    uassert_int_equal(orb_unregister_callback_ctx(&cb), -RT_EINVAL);
+
+    t.val = 6; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(ctx.calls, 1);
+
+    orb_unadvertise(adv);
+}
+
+/* 主题可通过 %instances 收紧实例上限 */
+#if defined(ORB_ORB_TEST_MAX_INSTANCES)
+#define ORB_TEST_INSTANCES ORB_ORB_TEST_MAX_INSTANCES
+#else
+#define ORB_TEST_INSTANCES ORB_MULTI_MAX_INSTANCES
+#endif
+
+/* 先注册后公告，且回调内 orb_copy 同一主题可读到新数据 */
+static void test_callback_before_advertise(void)
+{
+    const uint8_t inst = ORB_TEST_INSTANCES - 1;
+    struct cb_ctx ctx = {0};
+    orb_callback_t cb = {0};
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), inst, &cb, test_cb_fn, &ctx), RT_EOK);
+
+    ctx.sub = orb_subscribe_multi(ORB_ID(orb_test), inst);
+    uassert_true(ctx.sub != RT_NULL);
+
+    struct orb_test_s t = {0};
+    int got = -1;
+    orb_advert_t adv = RT_NULL;
+    /* 占满较低实例，直到拿到 inst（注册回调时创建的未公告节点） */
+    orb_advert_t fillers[ORB_MULTI_MAX_INSTANCES] = {0};
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        orb_advert_t a = orb_advertise_multi(ORB_ID(orb_test), &t, &got);
+        if (!a) break;
+        if (got == inst) { adv = a; break; }
+        fillers[i] = a;
+    }
+    uassert_true(adv != RT_NULL);
+
+    ctx.calls = 0;
+    t.val = 77; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(ctx.calls, 1);
+    uassert_int_equal(ctx.last_val, 77);
+    uassert_int_equal(ctx.copied_val, 77);
+
+    uassert_int_equal(orb_unregister_callback_ctx(&cb), RT_EOK);
+    orb_unsubscribe(ctx.sub);
+    orb_unadvertise(adv);
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        if (fillers[i]) orb_unadvertise(fillers[i]);
+    }
+}
+
+/* 回调内注销：第一个回调注销自身与紧随其后的回调，遍历照常结束 */
+struct cb_unreg_ctx
+{
+    orb_callback_t cb[3];
+    int            calls[3];
+};
+
+static void test_cb_unreg_fn(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    struct cb_unreg_ctx *ctx = (struct cb_unreg_ctx *)context;
+    (void)meta;
+    (void)instance;
+    (void)data;
+    ctx->calls[0]++;
+    uassert_int_equal(orb_unregister_callback_ctx(&ctx->cb[0]), RT_EOK);
+    uassert_int_equal(orb_unregister_callback_ctx(&ctx->cb[1]), RT_EOK);
+}
+
+static void test_cb_count_fn(const struct orb_metadata *meta, uint8_t instance, const void *data, void *context)
+{
+    int *calls = (int *)context;
+    (void)meta;
+    (void)instance;
+    (void)data;
+    (*calls)++;
+}
+
+static void test_callback_unregister_in_callback(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+
+    struct cb_unreg_ctx ctx = {0};
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), (uint8_t)inst, &ctx.cb[0], test_cb_unreg_fn, &ctx),
+                      RT_EOK);
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), (uint8_t)inst, &ctx.cb[1], test_cb_count_fn,
+                                                &ctx.calls[1]), RT_EOK);
+    uassert_int_equal(orb_register_callback_ctx(ORB_ID(orb_test), (uint8_t)inst, &ctx.cb[2], test_cb_count_fn,
+                                                &ctx.calls[2]), RT_EOK);
+
+    (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(ctx.calls[0], 1);
+    uassert_int_equal(ctx.calls[1], 0);
+    uassert_int_equal(ctx.calls[2], 1);
+    uassert_null(ctx.cb[0].node);
+    uassert_null(ctx.cb[1].node);
+
+    (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(ctx.calls[0], 1);
+    uassert_int_equal(ctx.calls[2], 2);
+
+    uassert_int_equal(orb_unregister_callback_ctx(&ctx.cb[2]), RT_EOK);
+    orb_unadvertise(adv);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_callback_ctx_message);
+    UTEST_UNIT_RUN(test_callback_before_advertise);
+    UTEST_UNIT_RUN(test_callback_unregister_in_callback);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.callback", tc_init, tc_cleanup, 20);
@@ -69,10 +69,166 @@ static void test_core_wait_ok_timeout(void)
     orb_unadvertise(adv);
 }
 
+static void test_core_update(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi_queue(ORB_ID(orb_test), &t, &inst, 4);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    struct orb_test_s rx = {0};
+    uassert_int_equal(orb_update(sub, &rx), 0);
+
+    /* 队列主题按顺序逐条取出 */
+    for (int i = 1; i <= 3; i++)
+    {
+        t.val = i; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    }
+    for (int i = 1; i <= 3; i++)
+    {
+        uassert_true(orb_update(sub, &rx) > 0);
+        uassert_int_equal(rx.val, i);
+    }
+    uassert_int_equal(orb_update(sub, &rx), 0);
+
+    uassert_int_equal(orb_update(RT_NULL, &rx), -RT_EINVAL);
+    uassert_int_equal(orb_update(sub, RT_NULL), -RT_EINVAL);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 快照：返回节点总数；节点序号跨快照稳定，可据此跟踪计数变化 */
+static void test_core_snapshot(void)
+{
+    uassert_int_equal(orb_snapshot(RT_NULL, 1), -RT_EINVAL);
+
+    struct sensor_demo_s s = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    uassert_not_null(adv);
+
+    int total = orb_snapshot(RT_NULL, 0);
+    uassert_true(total >= 1);
+    orb_node_stat_t *st = rt_malloc(sizeof(orb_node_stat_t) * total);
+    uassert_int_equal(orb_snapshot(st, total), total);
+
+    rt_uint32_t id = 0, gen = 0;
+    for (int i = 0; i < total; i++)
+    {
+        if (st[i].meta == ORB_ID(sensor_demo) && st[i].instance == inst)
+        {
+            id  = st[i].id;
+            gen = st[i].generation;
+            uassert_true(st[i].advertised);
+        }
+    }
+    uassert_true(id != 0);
+
+    (void)orb_publish(ORB_ID(sensor_demo), adv, &s);
+    uassert_int_equal(orb_snapshot(st, total), total);
+    for (int i = 0; i < total; i++)
+    {
+        if (st[i].id == id)
+        {
+            uassert_int_equal(st[i].generation, gen + 1);
+        }
+    }
+    rt_free(st);
+    orb_unadvertise(adv);
+}
+
+/* 带宽计数：每次发布/拷贝累加一条消息大小 */
+static void test_core_bandwidth(void)
+{
+    struct sensor_demo_s s = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(sensor_demo), (uint8_t)inst);
+    uassert_true(adv && sub);
+
+    orb_node_stat_t before, after;
+    uassert_int_equal(orb_node_stat(ORB_ID(sensor_demo), inst, &before), RT_EOK);
+    for (int i = 0; i < 3; i++)
+    {
+        (void)orb_publish(ORB_ID(sensor_demo), adv, &s);
+        (void)orb_copy(ORB_ID(sensor_demo), sub, &s);
+    }
+    uassert_int_equal(orb_node_stat(ORB_ID(sensor_demo), inst, &after), RT_EOK);
+    uassert_int_equal(after.bytes_published - before.bytes_published, 3 * sizeof(s));
+    uassert_int_equal(after.bytes_copied - before.bytes_copied, 3 * sizeof(s));
+#ifndef UORB_USING_PROFILING
+    uassert_int_equal(after.write_us, 0);
+#endif
+    uassert_int_equal(orb_node_stat(ORB_ID(sensor_demo), ORB_MULTI_MAX_INSTANCES, &after), -RT_EINVAL);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+static const struct orb_metadata mem_topic_meta = {
+    "uorb_mem_topic",
+    64,
+    64,
+    "uint8 data[64];",
+    0,
+};
+
+/* 内存统计：首次发布分配环形缓冲；超出预算时公告失败，放开后恢复 */
+static void test_core_mem_budget(void)
+{
+    orb_mem_stat_t m0, m1, m2;
+    rt_uint8_t     msg[64] = {0};
+    uassert_int_equal(orb_mem_get(RT_NULL), -RT_EINVAL);
+    uassert_int_equal(orb_mem_get(&m0), RT_EOK);
+
+    orb_advert_t adv = orb_advertise_queue(&mem_topic_meta, RT_NULL, 4);
+    uassert_not_null(adv);
+    uassert_int_equal(orb_mem_get(&m1), RT_EOK);
+    uassert_true(m1.current[ORB_MEM_NODE] > m0.current[ORB_MEM_NODE]);
+    uassert_int_equal(m1.current[ORB_MEM_QUEUE], m0.current[ORB_MEM_QUEUE]);
+    uassert_int_equal(m1.reserved - m0.reserved, 4 * 64);
+
+    (void)orb_publish(&mem_topic_meta, adv, msg);
+    uassert_int_equal(orb_mem_get(&m2), RT_EOK);
+    uassert_int_equal(m2.current[ORB_MEM_QUEUE] - m0.current[ORB_MEM_QUEUE], 4 * 64);
+    uassert_int_equal(m2.reserved, m0.reserved);
+    uassert_true(m2.total_peak >= m2.total);
+
+    orb_node_stat_t st;
+    uassert_int_equal(orb_node_stat(&mem_topic_meta, 0, &st), RT_EOK);
+    uassert_true(st.mem_bytes > 4 * 64);
+
+    /* 再公告一个实例所需超过剩余预算 */
+    uassert_int_equal(orb_mem_set_budget(m2.total + m2.reserved + 64), RT_EOK);
+    int inst = -1;
+    uassert_null(orb_advertise_multi_queue(&mem_topic_meta, RT_NULL, &inst, 4));
+    uassert_int_equal(orb_mem_get(&m1), RT_EOK);
+    uassert_int_equal(m1.rejected, m0.rejected + 1);
+    uassert_int_equal(m1.total, m2.total);
+
+    uassert_int_equal(orb_mem_set_budget(0), RT_EOK);
+    orb_advert_t adv1 = orb_advertise_multi_queue(&mem_topic_meta, RT_NULL, &inst, 4);
+    uassert_not_null(adv1);
+    uassert_int_equal(inst, 1);
+
+    orb_unadvertise(adv1);
+    orb_unadvertise(adv);
+    uassert_int_equal(orb_mem_get(&m1), RT_EOK);
+    uassert_int_equal(m1.total, m0.total);
+    uassert_int_equal(m1.reserved, m0.reserved);
+}
+
 static void testcase(void)
 {
     UTEST_UNIT_RUN(test_core_basic_pubsub);
     UTEST_UNIT_RUN(test_core_wait_ok_timeout);
+    UTEST_UNIT_RUN(test_core_update);
+    UTEST_UNIT_RUN(test_core_snapshot);
+    UTEST_UNIT_RUN(test_core_bandwidth);
+    UTEST_UNIT_RUN(test_core_mem_budget);
 }
 
 UTEST_TC_EXPORT(testcase, "uorb.core", tc_init, tc_cleanup, 20); 
\ No newline at end of file
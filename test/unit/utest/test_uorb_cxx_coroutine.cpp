@@ -0,0 +1,121 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+#include "cxx/uORBCoroutine.hpp"
+
+#if defined(__cpp_impl_coroutine)
+
+#define CO_TEST_TASKS    32
+#define CO_TEST_MESSAGES 8
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+static std::atomic<int> g_started{0};
+static std::atomic<int> g_received{0};
+static std::atomic<int> g_mismatch{0};
+static std::atomic<int> g_done{0};
+
+/* 空工作项：先调度再从本线程 cancel()，返回时执行器上之前的执行（含协程帧销毁）都已结束 */
+struct FlushItem : uORB::WorkItem {
+	void Run() override {}
+};
+
+static uORB::CoExecutor::Task co_test_task(uORB::CoExecutor &exec, uint8_t instance, int messages)
+{
+	uORB::CoSubscription<orb_test_s> sub{exec, instance};
+	g_started++;
+	for (int i = 1; i <= messages; i++) {
+		const orb_test_s &msg = co_await sub.next();
+		if (msg.val != i) g_mismatch++;
+		g_received++;
+	}
+	g_done++;
+}
+
+/* 等待计数达到目标，超时返回 false */
+static bool wait_count(const std::atomic<int> &count, int target)
+{
+	for (int i = 0; i < 1000 && count.load() < target; i++) {
+		rt_thread_mdelay(1);
+	}
+	return count.load() >= target;
+}
+
+static void test_co_many_tasks(void)
+{
+	uORB::CoExecutor exec{"u_tco", 4096};
+	FlushItem flush;
+	orb_test_s t{};
+	int inst = -1;
+	orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+	uassert_not_null(adv);
+	uassert_true(exec.start());
+
+	g_started = 0;
+	g_received = 0;
+	g_mismatch = 0;
+	g_done = 0;
+
+	rt_size_t total, used_before, used_after, max_used;
+	rt_memory_info(&total, &used_before, &max_used);
+
+	for (int i = 0; i < CO_TEST_TASKS; i++) {
+		uassert_true(exec.spawn(co_test_task(exec, (uint8_t)inst, CO_TEST_MESSAGES)));
+	}
+	uassert_true(wait_count(g_started, CO_TEST_TASKS));
+
+	/* 逐条发布：等全部协程收到后再发下一条，避免队列深度 1 时合并 */
+	for (int i = 1; i <= CO_TEST_MESSAGES; i++) {
+		t.val = i;
+		uassert_int_equal(orb_publish(ORB_ID(orb_test), adv, &t), RT_EOK);
+		if (!wait_count(g_received, CO_TEST_TASKS * i)) break;
+	}
+	uassert_true(wait_count(g_done, CO_TEST_TASKS));
+	uassert_int_equal(g_received.load(), CO_TEST_TASKS * CO_TEST_MESSAGES);
+	uassert_int_equal(g_mismatch.load(), 0);
+
+	/* 协程结束后协程帧（含订阅）全部释放 */
+	uassert_true(exec.schedule(&flush));
+	exec.cancel(&flush);
+	rt_memory_info(&total, &used_after, &max_used);
+	uassert_int_equal(used_after, used_before);
+
+	exec.stop();
+	orb_unadvertise(adv);
+}
+
+static void test_co_spawn_stopped(void)
+{
+	uORB::CoExecutor exec{"u_tco", 4096};
+	rt_size_t total, used_before, used_after, max_used;
+
+	/* 执行器未运行：spawn 失败，协程帧随 Task 一起销毁，协程体不执行 */
+	g_started = 0;
+	rt_memory_info(&total, &used_before, &max_used);
+	uassert_false(exec.spawn(co_test_task(exec, 0, 1)));
+	rt_memory_info(&total, &used_after, &max_used);
+	uassert_int_equal(used_after, used_before);
+	uassert_int_equal(g_started.load(), 0);
+}
+
+static void testcase(void)
+{
+	UTEST_UNIT_RUN(test_co_many_tasks);
+	UTEST_UNIT_RUN(test_co_spawn_stopped);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.cxx_co", tc_init, tc_cleanup, 20);
+
+#endif /* __cpp_impl_coroutine */
@@ -0,0 +1,247 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+#include "cxx/SubscriptionCallback.hpp"
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+/* 占住工作线程：Run() 开始时通知，直到 release 后才返回 */
+struct GateItem : uORB::WorkItem {
+	struct rt_semaphore started;
+	struct rt_semaphore release;
+
+	GateItem()
+	{
+		rt_sem_init(&started, "u_tgs", 0, RT_IPC_FLAG_FIFO);
+		rt_sem_init(&release, "u_tgr", 0, RT_IPC_FLAG_FIFO);
+	}
+	~GateItem()
+	{
+		rt_sem_detach(&started);
+		rt_sem_detach(&release);
+	}
+	void Run() override
+	{
+		rt_sem_release(&started);
+		rt_sem_take(&release, RT_WAITING_FOREVER);
+	}
+};
+
+/* 记录执行次数与执行顺序 */
+struct CountItem : uORB::WorkItem {
+	int id{0};
+	int runs{0};
+	int *order{nullptr};
+	int *order_n{nullptr};
+
+	void Run() override
+	{
+		runs++;
+		if (order) order[(*order_n)++] = id;
+	}
+};
+
+/* 执行期间睡眠，用于在 Run() 运行中从其他线程 cancel() */
+struct SlowItem : uORB::WorkItem {
+	struct rt_semaphore started;
+	volatile int done{0};
+
+	SlowItem() { rt_sem_init(&started, "u_tss", 0, RT_IPC_FLAG_FIFO); }
+	~SlowItem() { rt_sem_detach(&started); }
+	void Run() override
+	{
+		rt_sem_release(&started);
+		rt_thread_mdelay(50);
+		done = 1;
+	}
+};
+
+static void test_wq_coalesce(void)
+{
+	uORB::WorkQueue wq{"u_twq"};
+	GateItem gate;
+	CountItem a;
+
+	/* 未启动时拒绝调度 */
+	uassert_false(wq.schedule(&a));
+	uassert_true(wq.start());
+
+	uassert_true(wq.schedule(&gate));
+	uassert_int_equal(rt_sem_take(&gate.started, RT_WAITING_FOREVER), RT_EOK);
+	/* 执行前的多次调度合并为一次 */
+	uassert_true(wq.schedule(&a));
+	uassert_true(wq.schedule(&a));
+	uassert_true(wq.schedule(&a));
+	rt_sem_release(&gate.release);
+	wq.cancel(&a);
+	uassert_int_equal(a.runs, 1);
+
+	/* 执行后再次调度会再运行一次 */
+	uassert_true(wq.schedule(&a));
+	wq.cancel(&a);
+	uassert_int_equal(a.runs, 2);
+	wq.stop();
+}
+
+static void test_wq_order(void)
+{
+	uORB::WorkQueue wq{"u_twq"};
+	GateItem gate;
+	CountItem items[4];
+	int order[8] = {0};
+	int order_n = 0;
+
+	uassert_true(wq.start());
+	for (int i = 0; i < 4; i++) {
+		items[i].id = i + 1;
+		items[i].order = order;
+		items[i].order_n = &order_n;
+	}
+
+	uassert_true(wq.schedule(&gate));
+	uassert_int_equal(rt_sem_take(&gate.started, RT_WAITING_FOREVER), RT_EOK);
+	/* 工作线程忙时入队的工作项按调度顺序执行 */
+	uassert_true(wq.schedule(&items[2]));
+	uassert_true(wq.schedule(&items[0]));
+	uassert_true(wq.schedule(&items[3]));
+	uassert_true(wq.schedule(&items[0])); /* 合并，不改变位置 */
+	uassert_true(wq.schedule(&items[1]));
+	rt_sem_release(&gate.release);
+	wq.cancel(&items[1]);
+
+	uassert_int_equal(order_n, 4);
+	uassert_int_equal(order[0], 3);
+	uassert_int_equal(order[1], 1);
+	uassert_int_equal(order[2], 4);
+	uassert_int_equal(order[3], 2);
+	wq.stop();
+}
+
+static void test_wq_cancel_running(void)
+{
+	uORB::WorkQueue wq{"u_twq"};
+	SlowItem slow;
+	CountItem idle;
+
+	uassert_true(wq.start());
+	uassert_true(wq.schedule(&slow));
+	uassert_int_equal(rt_sem_take(&slow.started, RT_WAITING_FOREVER), RT_EOK);
+	/* Run() 运行中从本线程取消：阻塞到本次执行结束 */
+	wq.cancel(&slow);
+	uassert_int_equal(slow.done, 1);
+
+	/* 未入队也未运行的工作项立即返回 */
+	wq.cancel(&idle);
+	uassert_int_equal(idle.runs, 0);
+	wq.stop();
+}
+
+/* final：按具体类型 delete，无需虚析构 */
+struct SelfDeleteCallback final : uORB::SubscriptionCallback<orb_test_s> {
+	using uORB::SubscriptionCallback<orb_test_s>::SubscriptionCallback;
+};
+
+struct self_delete_ctx
+{
+	SelfDeleteCallback *cb;
+	orb_advert_t adv;
+	int calls;
+	struct rt_semaphore done;
+};
+
+static void on_self_delete(const orb_test_s &msg, void *context)
+{
+	self_delete_ctx *ctx = static_cast<self_delete_ctx *>(context);
+	orb_test_s t = msg;
+	ctx->calls++;
+	/* 再次发布使本对象重新入队，随后在自身 Run() 内析构：须从待执行队列摘除 */
+	t.val++;
+	(void)orb_publish(ORB_ID(orb_test), ctx->adv, &t);
+	delete ctx->cb;
+	ctx->cb = nullptr;
+	rt_sem_release(&ctx->done);
+}
+
+static void test_wq_delete_in_run(void)
+{
+	uORB::WorkQueue wq{"u_twq"};
+	orb_test_s t{};
+	int inst = -1;
+	orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+	uassert_not_null(adv);
+	uassert_true(wq.start());
+
+	self_delete_ctx ctx{};
+	ctx.adv = adv;
+	rt_sem_init(&ctx.done, "u_tsd", 0, RT_IPC_FLAG_FIFO);
+	ctx.cb = new SelfDeleteCallback(on_self_delete, &ctx, &wq, (uint8_t)inst);
+	uassert_not_null(ctx.cb);
+	uassert_true(ctx.cb->registerCallback());
+
+	t.val = 1;
+	uassert_int_equal(orb_publish(ORB_ID(orb_test), adv, &t), RT_EOK);
+	uassert_int_equal(rt_sem_take(&ctx.done, RT_WAITING_FOREVER), RT_EOK);
+
+	/* 析构后不再执行：栅栏保证排在前面的执行都已结束 */
+	GateItem gate;
+	uassert_true(wq.schedule(&gate));
+	uassert_int_equal(rt_sem_take(&gate.started, RT_WAITING_FOREVER), RT_EOK);
+	rt_sem_release(&gate.release);
+	wq.cancel(&gate);
+	uassert_null(ctx.cb);
+	uassert_int_equal(ctx.calls, 1);
+
+	(void)orb_publish(ORB_ID(orb_test), adv, &t);
+	wq.stop();
+	uassert_int_equal(ctx.calls, 1);
+	rt_sem_detach(&ctx.done);
+	orb_unadvertise(adv);
+}
+
+static void test_wq_stop_start(void)
+{
+	uORB::WorkQueue wq{"u_twq"};
+	GateItem gate;
+	CountItem a;
+
+	uassert_true(wq.start());
+	uassert_true(wq.schedule(&gate));
+	uassert_int_equal(rt_sem_take(&gate.started, RT_WAITING_FOREVER), RT_EOK);
+	uassert_true(wq.schedule(&a));
+	rt_sem_release(&gate.release);
+	/* stop() 在线程退出前执行完已入队的工作项 */
+	wq.stop();
+	uassert_int_equal(a.runs, 1);
+	uassert_false(wq.schedule(&a));
+
+	/* 重新启动后可再次调度同一工作项 */
+	uassert_true(wq.start());
+	uassert_true(wq.schedule(&a));
+	wq.cancel(&a);
+	uassert_int_equal(a.runs, 2);
+	wq.stop();
+	wq.stop(); /* 重复停止无副作用 */
+}
+
+static void testcase(void)
+{
+	UTEST_UNIT_RUN(test_wq_coalesce);
+	UTEST_UNIT_RUN(test_wq_order);
+	UTEST_UNIT_RUN(test_wq_cancel_running);
+	UTEST_UNIT_RUN(test_wq_delete_in_run);
+	UTEST_UNIT_RUN(test_wq_stop_start);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.cxx_wq", tc_init, tc_cleanup, 20);
@@ -0,0 +1,201 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_defer.h"
+
+#if defined(UORB_USING_DEFERRED_PUBLISH)
+struct defer_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata defer_meta = {
+    "uorb_defer_topic",
+    sizeof(struct defer_msg_s),
+    sizeof(struct defer_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static const struct orb_metadata defer_meta2 = {
+    "uorb_defer_topic2",
+    sizeof(struct defer_msg_s),
+    sizeof(struct defer_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static orb_advert_t   adv;
+static orb_advert_t   adv2;
+static rt_sem_t       cb_go;
+static orb_callback_t cb;
+static volatile int   cb_count;
+static volatile int   cb_last;
+static volatile int   cb_in_order;
+static rt_thread_t    cb_thread;
+
+static void defer_cb(const struct orb_metadata *meta, rt_uint8_t instance, const void *msg, void *ctx)
+{
+    (void)meta;
+    (void)instance;
+    (void)ctx;
+    int val = ((const struct defer_msg_s *)msg)->val;
+    cb_in_order &= val == cb_last + 1;
+    cb_last   = val;
+    cb_thread = rt_thread_self();
+    cb_count++;
+    if (cb_go)
+    {
+        /* 投递线程内取消另一主题的公告，其消息仍在队列中 */
+        rt_sem_take(cb_go, RT_WAITING_FOREVER);
+        orb_unadvertise(adv2);
+        adv2 = RT_NULL;
+    }
+}
+
+static rt_err_t tc_init(void)
+{
+    adv = orb_advertise_queue(&defer_meta, RT_NULL, 8);
+    if (!adv)
+    {
+        return -RT_ERROR;
+    }
+    return orb_register_callback_ctx(&defer_meta, 0, &cb, defer_cb, RT_NULL);
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    orb_unregister_callback_ctx(&cb);
+    orb_unadvertise(adv);
+    return RT_EOK;
+}
+
+static void wait_count(int n)
+{
+    for (int i = 0; i < 1000 && cb_count < n; i++)
+    {
+        rt_thread_mdelay(1);
+    }
+}
+
+/* 发布只入队，回调在投递线程中按发布顺序执行，订阅者读到全部消息 */
+static void test_defer_publish(void)
+{
+    orb_subscr_t sub = orb_subscribe(&defer_meta);
+    uassert_true(sub != RT_NULL);
+    rt_bool_t updated = RT_TRUE;
+    orb_check(sub, &updated);
+    uassert_int_equal(orb_set_publish_deferred(adv, RT_TRUE), RT_EOK);
+
+    cb_count    = 0;
+    cb_last     = 0;
+    cb_in_order = 1;
+    cb_thread   = RT_NULL;
+    for (int i = 1; i <= 5; i++)
+    {
+        struct defer_msg_s m = {(rt_uint64_t)i, i};
+        uassert_int_equal(orb_publish(&defer_meta, adv, &m), RT_EOK);
+    }
+    wait_count(5);
+    uassert_int_equal(cb_count, 5);
+    uassert_true(cb_in_order);
+    uassert_true(cb_thread != RT_NULL && cb_thread != rt_thread_self());
+
+    struct defer_msg_s m = {0};
+    for (int i = 1; i <= 5; i++)
+    {
+        uassert_int_equal(orb_copy(&defer_meta, sub, &m), sizeof(m));
+        uassert_int_equal(m.val, i);
+    }
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+
+    orb_defer_stat_t st;
+    uassert_int_equal(orb_defer_get_stat(&st), RT_EOK);
+    uassert_true(st.enqueued >= 5);
+    uassert_int_equal(st.enqueued, st.delivered);
+    uassert_true(st.max_depth >= 1 && st.max_depth <= UORB_DEFER_QUEUE_SIZE);
+
+    /* 关闭后恢复同步发布：返回时回调已在本线程执行 */
+    uassert_int_equal(orb_set_publish_deferred(adv, RT_FALSE), RT_EOK);
+    m.val = 6;
+    orb_publish(&defer_meta, adv, &m);
+    uassert_int_equal(cb_count, 6);
+    uassert_true(cb_thread == rt_thread_self());
+    orb_unsubscribe(sub);
+}
+
+/* 投递回调中删除的节点：队列里其后的消息被作废而不是访问已释放的节点 */
+static void test_defer_delete_in_callback(void)
+{
+    orb_defer_stat_t st0, st;
+    struct defer_msg_s m = {0};
+
+    adv2 = orb_advertise(&defer_meta2, &m);
+    uassert_true(adv2 != RT_NULL);
+    uassert_int_equal(orb_set_publish_deferred(adv, RT_TRUE), RT_EOK);
+    uassert_int_equal(orb_set_publish_deferred(adv2, RT_TRUE), RT_EOK);
+    cb_go = rt_sem_create("dfgo", 0, RT_IPC_FLAG_PRIO);
+    uassert_true(cb_go != RT_NULL);
+    orb_defer_get_stat(&st0);
+
+    cb_count = 0;
+    m.val    = 1;
+    uassert_int_equal(orb_publish(&defer_meta, adv, &m), RT_EOK);
+    wait_count(1);
+    uassert_int_equal(cb_count, 1);
+    for (int i = 0; i < 3; i++)
+    {
+        uassert_int_equal(orb_publish(&defer_meta2, adv2, &m), RT_EOK);
+    }
+    rt_sem_release(cb_go);
+
+    for (int i = 0; i < 1000; i++)
+    {
+        orb_defer_get_stat(&st);
+        if (st.delivered - st0.delivered == 4)
+        {
+            break;
+        }
+        rt_thread_mdelay(1);
+    }
+    uassert_int_equal(st.delivered - st0.delivered, 4);
+    uassert_true(adv2 == RT_NULL);
+    uassert_false(orb_exists(&defer_meta2, 0) == RT_EOK);
+
+    rt_sem_t go = cb_go;
+    cb_go       = RT_NULL;
+    rt_sem_delete(go);
+    uassert_int_equal(orb_set_publish_deferred(adv, RT_FALSE), RT_EOK);
+}
+
+/* 超出槽大小的主题拒绝开启 */
+static void test_defer_config(void)
+{
+    static const struct orb_metadata big = {"uorb_defer_big", UORB_DEFER_SLOT_SIZE + 1, UORB_DEFER_SLOT_SIZE + 1,
+                                            "uint8[65] b;", 0};
+    static rt_uint8_t                buf[UORB_DEFER_SLOT_SIZE + 1];
+    orb_advert_t                     h = orb_advertise(&big, buf);
+    uassert_true(h != RT_NULL);
+    uassert_int_equal(orb_set_publish_deferred(h, RT_TRUE), -RT_EINVAL);
+    uassert_int_equal(orb_set_publish_deferred(RT_NULL, RT_TRUE), -RT_EINVAL);
+    uassert_int_equal(orb_defer_get_stat(RT_NULL), -RT_EINVAL);
+    orb_unadvertise(h);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_defer_publish);
+    UTEST_UNIT_RUN(test_defer_delete_in_callback);
+    UTEST_UNIT_RUN(test_defer_config);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.defer", tc_init, tc_cleanup, 20);
+#endif
@@ -0,0 +1,172 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include <stddef.h>
+#include "uORB.h"
+#include "uorb_fields.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#include "topics/sensor_demo.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+#ifdef FINSH_USING_MSH
+#include <msh.h>
+#endif
+
+struct fields_mix_s
+{
+    rt_uint8_t  a;
+    float       v[3];
+    char        name[8];
+    rt_uint64_t ts;
+    double      d;
+};
+
+static const struct orb_metadata fields_mix_meta = {
+    "uorb_fields_mix",
+    sizeof(struct fields_mix_s),
+    sizeof(struct fields_mix_s),
+    "uint8 a;float[3] v;char[8] name;uint64 ts;double d;",
+    0,
+};
+
+static const struct orb_metadata fields_bad_meta = {
+    "uorb_fields_bad", 16, 16, "uint64 ts;vehicle_status_s status;", 0};
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+/* 字段布局只解析一次：再次查询返回同一份缓存，偏移与自然对齐的结构体一致 */
+static void test_fields_layout(void)
+{
+    int n1 = 0, n2 = 0;
+    const uorb_field_desc_t *f1 = uorb_fields_layout(ORB_ID(sensor_demo), &n1);
+    const uorb_field_desc_t *f2 = uorb_fields_layout(ORB_ID(sensor_demo), &n2);
+    uassert_not_null(f1);
+    uassert_true(f1 == f2);
+    uassert_int_equal(n1, 4);
+    uassert_int_equal(n2, 4);
+    uassert_int_equal(f1[0].type, UORB_FIELD_UINT64);
+    uassert_int_equal(f1[3].offset, 16);
+
+    uorb_field_desc_t f;
+    uassert_int_equal(uorb_fields_find(ORB_ID(sensor_demo), "y", &f), RT_EOK);
+    uassert_int_equal(f.offset, 12);
+    uassert_int_equal(uorb_fields_find(ORB_ID(sensor_demo), "w", &f), -RT_ENOENT);
+
+    int n = 0;
+    const uorb_field_desc_t *mix = uorb_fields_layout(&fields_mix_meta, &n);
+    uassert_not_null(mix);
+    uassert_int_equal(n, 5);
+    uassert_true(uorb_fields_layout(&fields_mix_meta, &n) == mix);
+    uassert_int_equal(mix[0].offset, offsetof(struct fields_mix_s, a));
+    uassert_int_equal(mix[1].offset, offsetof(struct fields_mix_s, v));
+    uassert_int_equal(mix[1].count, 3);
+    uassert_int_equal(mix[1].type_size, 4);
+    uassert_int_equal(mix[2].type, UORB_FIELD_CHAR);
+    uassert_int_equal(mix[2].offset, offsetof(struct fields_mix_s, name));
+    uassert_int_equal(mix[3].offset, offsetof(struct fields_mix_s, ts));
+    uassert_int_equal(mix[4].type, UORB_FIELD_DOUBLE);
+    uassert_int_equal(mix[4].offset, offsetof(struct fields_mix_s, d));
+
+    /* 无法解析的类型不缓存布局，错误码经 count 带回 */
+    n = 0;
+    uassert_null(uorb_fields_layout(&fields_bad_meta, &n));
+    uassert_int_equal(n, -RT_ENOSYS);
+    uassert_int_equal(uorb_fields_find(&fields_bad_meta, "ts", &f), -RT_ENOSYS);
+}
+
+static const char *fmt(const void *p, rt_uint8_t type)
+{
+    static char buf[32];
+    uorb_field_format(p, type, buf, sizeof(buf));
+    return buf;
+}
+
+/* listener 的逐元素格式：64 位整数完整输出，浮点定点 4 位小数且不因放大溢出 */
+static void test_fields_format(void)
+{
+    rt_uint64_t u64 = 18446744073709551615ULL;
+    rt_int64_t  i64 = -9223372036854775807LL - 1;
+    uassert_str_equal(fmt(&u64, UORB_FIELD_UINT64), "18446744073709551615");
+    uassert_str_equal(fmt(&i64, UORB_FIELD_INT64), "-9223372036854775808");
+
+    double d = 1e17;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "100000000000000000.0000");
+    d = 123456789012345.5;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "123456789012345.5000");
+    d = -2.5;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "-2.5000");
+    d = 0.99996;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "1.0000");
+    d = 1e18;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "inf");
+    d = -1e300;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "-inf");
+    d = 0.0 / 0.0;
+    uassert_str_equal(fmt(&d, UORB_FIELD_DOUBLE), "nan");
+
+    float fl = 0.25f;
+    uassert_str_equal(fmt(&fl, UORB_FIELD_FLOAT), "0.2500");
+    rt_int8_t   i8  = -5;
+    rt_uint16_t u16 = 65535;
+    rt_uint8_t  b   = 1;
+    uassert_str_equal(fmt(&i8, UORB_FIELD_INT8), "-5");
+    uassert_str_equal(fmt(&u16, UORB_FIELD_UINT16), "65535");
+    uassert_str_equal(fmt(&b, UORB_FIELD_BOOL), "true");
+
+    /* 缓冲区不足时截断并保证 '\0' 结尾 */
+    char small[4];
+    uorb_field_format(&u64, UORB_FIELD_UINT64, small, sizeof(small));
+    uassert_str_equal(small, "184");
+
+    /* 按字段打印整条消息（listener 使用的路径），不应触发越界或未定义行为 */
+    struct fields_mix_s m = {7, {1.5f, -1e30f, 3e38f}, "imu0", 123456789012ULL, 4e18};
+    orb_print_message_internal(&fields_mix_meta, &m, true);
+}
+
+#ifdef FINSH_USING_MSH
+static int run_cmd(const char *cmd)
+{
+    char line[64];
+    rt_strncpy(line, cmd, sizeof(line) - 1);
+    line[sizeof(line) - 1] = '\0';
+    return msh_exec(line, rt_strlen(line));
+}
+
+/* uorb listener：打印已有的最新一条后返回；未知主题、越界实例与非法参数报错 */
+static void test_fields_listener(void)
+{
+    struct sensor_demo_s s = {123456789012ULL, 1, -2, 3};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    uassert_true(adv != RT_NULL);
+
+    char cmd[64];
+    rt_snprintf(cmd, sizeof(cmd), "uorb listener sensor_demo -i %d -n 1", inst);
+    uassert_int_equal(run_cmd(cmd), 0);
+    uassert_int_equal(run_cmd("uorb listener uorb_no_such_topic"), -1);
+    rt_snprintf(cmd, sizeof(cmd), "uorb listener sensor_demo -i %d", ORB_MULTI_MAX_INSTANCES);
+    uassert_int_equal(run_cmd(cmd), -1);
+    uassert_int_equal(run_cmd("uorb listener sensor_demo -x 1"), -1);
+
+    orb_unadvertise(adv);
+}
+#endif
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_fields_layout);
+    UTEST_UNIT_RUN(test_fields_format);
+#ifdef FINSH_USING_MSH
+    UTEST_UNIT_RUN(test_fields_listener);
+#endif
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.fields", tc_init, tc_cleanup, 20);
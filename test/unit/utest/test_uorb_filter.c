@@ -0,0 +1,183 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+
+struct filter_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+    rt_uint16_t flags;
+};
+
+static const struct orb_metadata filter_meta = {
+    "uorb_filter_topic",
+    sizeof(struct filter_msg_s),
+    14,
+    "uint64_t timestamp;int32 val;uint16 flags;",
+    0,
+};
+
+static orb_advert_t adv;
+
+static rt_err_t tc_init(void)
+{
+    adv = orb_advertise(&filter_meta, RT_NULL);
+    return adv ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    orb_unadvertise(adv);
+    return RT_EOK;
+}
+
+static void publish(rt_int32_t val, rt_uint16_t flags)
+{
+    struct filter_msg_s m = {(rt_uint64_t)val, val, flags};
+    orb_publish(&filter_meta, adv, &m);
+}
+
+/* 阈值过滤：只有匹配的发布算作更新，orb_copy 取最近一条匹配消息而不是最新消息 */
+static void test_filter_threshold(void)
+{
+    orb_subscr_t sub = orb_subscribe(&filter_meta);
+    uassert_true(sub != RT_NULL);
+    uassert_int_equal(orb_set_filter(sub, "val", ORB_FILTER_GT, 5), RT_EOK);
+
+    struct filter_msg_s m = {0};
+    rt_bool_t           updated = RT_TRUE;
+    publish(1, 0);
+    publish(2, 0);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+    uassert_int_equal(orb_update(sub, &m), 0);
+    uassert_int_equal(orb_copy(&filter_meta, sub, &m), 0);
+
+    publish(10, 0);
+    publish(3, 0);
+    uassert_int_equal(orb_update(sub, &m), sizeof(m));
+    uassert_int_equal(m.val, 10);
+    uassert_int_equal(orb_update(sub, &m), 0);
+
+    /* 没有匹配的发布不会唤醒等待者 */
+    publish(4, 0);
+    uassert_int_equal(orb_wait(sub, 30), -RT_ETIMEOUT);
+    publish(7, 0);
+    uassert_int_equal(orb_wait(sub, 30), RT_EOK);
+    uassert_int_equal(orb_copy(&filter_meta, sub, &m), sizeof(m));
+    uassert_int_equal(m.val, 7);
+
+    /* 取消过滤后恢复普通订阅语义 */
+    uassert_int_equal(orb_clear_filter(sub), RT_EOK);
+    publish(1, 0);
+    uassert_int_equal(orb_update(sub, &m), sizeof(m));
+    uassert_int_equal(m.val, 1);
+
+    orb_unsubscribe(sub);
+}
+
+/* 越过阈值与位掩码：谓词保存上一次的字段值，每次发布只求值一次 */
+static void test_filter_edge_and_bits(void)
+{
+    orb_subscr_t rise = orb_subscribe(&filter_meta);
+    orb_subscr_t bits = orb_subscribe(&filter_meta);
+    uassert_true(rise && bits);
+    uassert_int_equal(orb_set_filter(rise, "val", ORB_FILTER_RISE, 10), RT_EOK);
+    uassert_int_equal(orb_set_filter(bits, "flags", ORB_FILTER_BITS, 0x8), -RT_EINVAL);
+    uassert_int_equal(orb_set_filter_bits(bits, "flags", 0), -RT_EINVAL);
+    uassert_int_equal(orb_set_filter_bits(bits, "flags", 0x8), RT_EOK);
+
+    static const rt_int32_t vals[] = {5, 12, 15, 8, 11, 20};
+    int                     rises  = 0;
+    struct filter_msg_s     m;
+    for (rt_size_t i = 0; i < sizeof(vals) / sizeof(vals[0]); i++)
+    {
+        publish(vals[i], (rt_uint16_t)(i == 3 ? 0x18 : 0x1));
+        if (orb_update(rise, &m) > 0)
+        {
+            uassert_true(m.val == 12 || m.val == 11);
+            rises++;
+        }
+    }
+    uassert_int_equal(rises, 2);
+    uassert_int_equal(orb_update(bits, &m), sizeof(m));
+    uassert_int_equal(m.val, 8);
+    uassert_int_equal(orb_update(bits, &m), 0);
+
+    orb_unsubscribe(rise);
+    orb_unsubscribe(bits);
+}
+
+/* 64 位掩码完整生效：(1 << 60) | 1 经 double 传递会丢掉最低位 */
+static void test_filter_bits_u64(void)
+{
+    orb_subscr_t sub = orb_subscribe(&filter_meta);
+    uassert_true(sub != RT_NULL);
+    uassert_int_equal(orb_set_filter_bits(sub, "timestamp", (1ULL << 60) | 1ULL), RT_EOK);
+
+    static const rt_uint64_t ts[]    = {2, 1, 1ULL << 59, 1ULL << 60};
+    static const rt_bool_t   match[] = {RT_FALSE, RT_TRUE, RT_FALSE, RT_TRUE};
+    struct filter_msg_s      m       = {0};
+    for (rt_size_t i = 0; i < sizeof(ts) / sizeof(ts[0]); i++)
+    {
+        m.timestamp = ts[i];
+        orb_publish(&filter_meta, adv, &m);
+        struct filter_msg_s rx;
+        uassert_int_equal(orb_update(sub, &rx) > 0, match[i]);
+        if (match[i])
+        {
+            uassert_true(rx.timestamp == ts[i]);
+        }
+    }
+
+    orb_unsubscribe(sub);
+}
+
+/* 先订阅并设过滤、后公告；非法字段被拒绝 */
+static void test_filter_late_bind(void)
+{
+    static const struct orb_metadata late_meta = {
+        "uorb_filter_late", sizeof(struct filter_msg_s), 14, "uint64_t timestamp;int32 val;uint16 flags;", 0};
+    orb_subscr_t sub = orb_subscribe(&late_meta);
+    uassert_true(sub != RT_NULL);
+    uassert_int_equal(orb_set_filter(sub, "nope", ORB_FILTER_EQ, 0), -RT_ENOENT);
+    uassert_int_equal(orb_set_filter(sub, "val", ORB_FILTER_CHANGED, 0), RT_EOK);
+
+    struct filter_msg_s m   = {1, 3, 0};
+    orb_advert_t        pub = orb_advertise(&late_meta, RT_NULL);
+    uassert_true(pub != RT_NULL);
+    /* 与普通订阅一致：首次使用时绑定节点，过滤随之挂入 */
+    rt_bool_t updated = RT_TRUE;
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+    orb_publish(&late_meta, pub, &m);
+    m.timestamp = 2;
+    orb_publish(&late_meta, pub, &m);
+
+    uassert_int_equal(orb_update(sub, &m), sizeof(m));
+    uassert_true(m.timestamp == 1);
+    m.timestamp = 3;
+    m.val       = 4;
+    orb_publish(&late_meta, pub, &m);
+    uassert_int_equal(orb_update(sub, &m), sizeof(m));
+    uassert_int_equal(m.val, 4);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(pub);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_filter_threshold);
+    UTEST_UNIT_RUN(test_filter_edge_and_bits);
+    UTEST_UNIT_RUN(test_filter_bits_u64);
+    UTEST_UNIT_RUN(test_filter_late_bind);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.filter", tc_init, tc_cleanup, 20);
@@ -0,0 +1,153 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_group.h"
+
+/* 独立主题，避免其他用例遗留的实例影响选择结果 */
+struct group_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata group_meta = {
+    "uorb_group_test",
+    sizeof(struct group_msg_s),
+    sizeof(struct group_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+static void publish(orb_advert_t adv, rt_uint64_t ts, rt_int32_t val)
+{
+    struct group_msg_s m = {ts, val};
+    (void)orb_publish(&group_meta, adv, &m);
+}
+
+/* 先订阅后公告：实例自动绑定，一次调用得到全部实例的更新位图 */
+static void test_group_late_bind(void)
+{
+    orb_sub_group_t *grp = orb_subscribe_group(&group_meta);
+    uassert_not_null(grp);
+    uassert_int_equal(orb_group_updated(grp), 0);
+    uassert_int_equal(orb_group_select(grp), -RT_ENOENT);
+
+    struct group_msg_s m = {0};
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&group_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&group_meta, RT_NULL, &i1);
+    uassert_true(a0 && a1 && i0 != i1);
+
+    publish(a1, 10, 1);
+    uassert_int_equal(orb_group_updated(grp), 1U << i1);
+    uassert_int_equal(orb_group_updated(grp), 0);
+
+    publish(a0, 20, 2);
+    publish(a1, 30, 3);
+    uassert_int_equal(orb_group_updated(grp), (1U << i0) | (1U << i1));
+
+    int inst = -1;
+    uassert_int_equal(orb_group_update(grp, &m, &inst), sizeof(m));
+    uassert_int_equal(inst, i1);
+    uassert_int_equal(m.val, 3);
+    uassert_int_equal(orb_group_update(grp, &m, &inst), 0);
+
+    /* 按实例读取最新数据不消费选中实例的未读消息 */
+    publish(a1, 40, 4);
+    uassert_int_equal(orb_group_copy(grp, i1, &m), sizeof(m));
+    uassert_int_equal(m.val, 4);
+    uassert_int_equal(orb_group_copy(grp, i0, &m), sizeof(m));
+    uassert_int_equal(m.val, 2);
+    uassert_int_equal(orb_group_update(grp, &m, &inst), sizeof(m));
+    uassert_int_equal(m.val, 4);
+    uassert_int_equal(orb_group_copy(grp, ORB_MULTI_MAX_INSTANCES, &m), -RT_EINVAL);
+
+    orb_unsubscribe_group(grp);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* NEWEST 按消息 timestamp，PRIORITY 按 orb_set_priority */
+static void test_group_policies(void)
+{
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&group_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&group_meta, RT_NULL, &i1);
+    orb_sub_group_t *grp = orb_subscribe_group(&group_meta);
+    uassert_true(a0 && a1 && grp);
+
+    publish(a0, 200, 0);
+    publish(a1, 100, 1);
+    uassert_int_equal(orb_group_select(grp), i0);
+    publish(a1, 300, 1);
+    uassert_int_equal(orb_group_select(grp), i1);
+
+    uassert_int_equal(orb_group_set_policy(grp, ORB_GROUP_PRIORITY, 0), RT_EOK);
+    uassert_int_equal(orb_set_priority(a0, ORB_PRIO_HIGH), RT_EOK);
+    uassert_int_equal(orb_group_select(grp), i0);
+    uassert_int_equal(orb_set_priority(a1, ORB_PRIO_MAX), RT_EOK);
+    uassert_int_equal(orb_group_select(grp), i1);
+
+    orb_unsubscribe_group(grp);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* FAILOVER：保持当前实例，取消公告或超时后切换，且切换时立即输出新实例数据 */
+static void test_group_failover(void)
+{
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&group_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&group_meta, RT_NULL, &i1);
+    orb_sub_group_t *grp = orb_subscribe_group(&group_meta);
+    uassert_true(a0 && a1 && grp);
+    uassert_int_equal(orb_group_set_policy(grp, ORB_GROUP_FAILOVER, 50 * 1000), RT_EOK);
+    (void)orb_set_priority(a0, ORB_PRIO_HIGH);
+
+    struct group_msg_s m;
+    int inst = -1;
+    publish(a0, 1, 10);
+    publish(a1, 1, 20);
+    uassert_int_equal(orb_group_update(grp, &m, &inst), sizeof(m));
+    uassert_int_equal(inst, i0);
+
+    /* 主实例停止更新超过超时时间：切到备份 */
+    rt_thread_mdelay(30);
+    publish(a1, 2, 21);
+    rt_thread_mdelay(30);
+    publish(a1, 3, 22);
+    uassert_int_equal(orb_group_update(grp, &m, &inst), sizeof(m));
+    uassert_int_equal(inst, i1);
+    uassert_int_equal(m.val, 22);
+
+    /* 主实例恢复：备份仍健康，保持不切回 */
+    publish(a0, 4, 11);
+    uassert_int_equal(orb_group_select(grp), i1);
+
+    /* 备份取消公告：回到主实例 */
+    orb_unadvertise(a1);
+    uassert_int_equal(orb_group_update(grp, &m, &inst), sizeof(m));
+    uassert_int_equal(inst, i0);
+    uassert_int_equal(m.val, 11);
+
+    orb_unsubscribe_group(grp);
+    orb_unadvertise(a0);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_group_late_bind);
+    UTEST_UNIT_RUN(test_group_policies);
+    UTEST_UNIT_RUN(test_group_failover);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.group", tc_init, tc_cleanup, 20);
@@ -50,9 +50,135 @@ static void test_interval_basic(void)
     orb_unadvertise(adv);
 }
 
+static void test_interval_us(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    rt_uint32_t us = 1;
+    uassert_int_equal(orb_get_interval_us(sub, &us), RT_EOK);
+    uassert_int_equal(us, 0);
+
+    uassert_int_equal(orb_set_interval_us(sub, 2500), RT_EOK);
+    uassert_int_equal(orb_get_interval_us(sub, &us), RT_EOK);
+    uassert_int_equal(us, 2500);
+    unsigned ms = 0;
+    uassert_int_equal(orb_get_interval(sub, &ms), RT_EOK);
+    uassert_int_equal(ms, 2);
+
+    /* 毫秒接口与微秒接口一致 */
+    uassert_int_equal(orb_set_interval(sub, 3), RT_EOK);
+    uassert_int_equal(orb_get_interval_us(sub, &us), RT_EOK);
+    uassert_int_equal(us, 3000);
+
+    uassert_int_equal(orb_set_interval_us(RT_NULL, 1), -RT_EINVAL);
+    uassert_int_equal(orb_get_interval_us(sub, RT_NULL), -RT_EINVAL);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 按消息时间戳节流：1kHz 发布、4ms 间隔，应严格每 4 条取 1 条，与轮询时刻无关 */
+static void test_interval_by_timestamp(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    uassert_int_equal(orb_set_interval_us(sub, 4000), RT_EOK);
+    uassert_int_equal(orb_set_interval_by_timestamp(sub, RT_TRUE), RT_EOK);
+
+    int seen = 0;
+    int32_t vals[8] = {0};
+    for (int i = 0; i < 32; i++)
+    {
+        t.timestamp = 1000000ULL + (uint64_t)i * 1000ULL;
+        t.val = i;
+        (void)orb_publish(ORB_ID(orb_test), adv, &t);
+
+        rt_bool_t updated = RT_FALSE;
+        uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+        if (updated)
+        {
+            struct orb_test_s rx;
+            uassert_true(orb_copy(ORB_ID(orb_test), sub, &rx) > 0);
+            if (seen < 8) vals[seen] = rx.val;
+            seen++;
+        }
+    }
+    uassert_int_equal(seen, 8);
+    for (int i = 0; i < 8; i++)
+    {
+        uassert_int_equal(vals[i], i * 4);
+    }
+
+    /* 关闭后回到本地时钟节流：刚拷贝过，间隔内不再报告 */
+    uassert_int_equal(orb_set_interval_by_timestamp(sub, RT_FALSE), RT_EOK);
+    rt_bool_t updated = RT_FALSE;
+    struct orb_test_s rx;
+    (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+    t.timestamp += 1000; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 先订阅并按时间戳节流、后公告：绑定节点时自动限速须识别该订阅，不得按本地时钟丢样 */
+static void test_interval_by_timestamp_late_bind(void)
+{
+    static const struct orb_metadata late_meta = {
+        "uorb_interval_late", sizeof(struct orb_test_s), sizeof(struct orb_test_s), "uint64_t timestamp;int32 val;", 0};
+    orb_subscr_t sub = orb_subscribe(&late_meta);
+    uassert_true(sub != RT_NULL);
+    uassert_int_equal(orb_set_interval_us(sub, 4000), RT_EOK);
+    uassert_int_equal(orb_set_interval_by_timestamp(sub, RT_TRUE), RT_EOK);
+
+    orb_advert_t adv = orb_advertise(&late_meta, RT_NULL);
+    uassert_true(adv != RT_NULL);
+    uassert_int_equal(orb_set_publish_auto_rate(adv, RT_TRUE), RT_EOK);
+    rt_bool_t updated = RT_TRUE;
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+
+    struct orb_test_s t = {0};
+    int seen = 0;
+    for (int i = 0; i < 32; i++)
+    {
+        t.timestamp = 1000000ULL + (uint64_t)i * 1000ULL;
+        t.val = i;
+        (void)orb_publish(&late_meta, adv, &t);
+
+        updated = RT_FALSE;
+        uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+        if (updated)
+        {
+            struct orb_test_s rx;
+            uassert_true(orb_copy(&late_meta, sub, &rx) > 0);
+            uassert_int_equal(rx.val, seen * 4);
+            seen++;
+        }
+    }
+    uassert_int_equal(seen, 8);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
 static void testcase(void)
 {
     UTEST_UNIT_RUN(test_interval_basic);
+    UTEST_UNIT_RUN(test_interval_us);
+    UTEST_UNIT_RUN(test_interval_by_timestamp);
+    UTEST_UNIT_RUN(test_interval_by_timestamp_late_bind);
 }
 
 UTEST_TC_EXPORT(testcase, "uorb.interval", tc_init, tc_cleanup, 20); 
\ No newline at end of file
@@ -0,0 +1,182 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_isr.h"
+
+#if defined(UORB_USING_ISR_PUBLISH)
+struct isr_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata isr_meta = {
+    "uorb_isr_topic",
+    sizeof(struct isr_msg_s),
+    sizeof(struct isr_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static orb_advert_t   adv;
+static orb_callback_t cb;
+static volatile int   cb_count;
+static volatile int   cb_last;
+static volatile int   cb_in_isr;
+static rt_int32_t     cb_seen[16];
+static rt_sem_t       cb_gate;     /* 非空时回调在此阻塞，模拟下半部落后 */
+
+static void isr_cb(const struct orb_metadata *meta, rt_uint8_t instance, const void *msg, void *ctx)
+{
+    (void)meta;
+    (void)instance;
+    (void)ctx;
+    cb_last = ((const struct isr_msg_s *)msg)->val;
+    cb_in_isr |= rt_interrupt_get_nest() != 0;
+    if (cb_count < 16)
+    {
+        cb_seen[cb_count] = cb_last;
+    }
+    cb_count++;
+    if (cb_gate)
+    {
+        rt_sem_take(cb_gate, RT_WAITING_FOREVER);
+    }
+}
+
+static rt_err_t tc_init(void)
+{
+    adv = orb_advertise_queue(&isr_meta, RT_NULL, 4);
+    if (!adv)
+    {
+        return -RT_ERROR;
+    }
+    return orb_register_callback_ctx(&isr_meta, 0, &cb, isr_cb, RT_NULL);
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    orb_unregister_callback_ctx(&cb);
+    orb_unadvertise(adv);
+    return RT_EOK;
+}
+
+static void publish_isr(rt_int32_t val)
+{
+    struct isr_msg_s m = {(rt_uint64_t)val, val};
+    rt_interrupt_enter();
+    uassert_int_equal(orb_publish_isr(&isr_meta, adv, &m), RT_EOK);
+    rt_interrupt_leave();
+}
+
+/* 未预分配的节点拒绝中断发布 */
+static void test_isr_requires_prepare(void)
+{
+    struct isr_msg_s m = {0};
+    uassert_int_equal(orb_publish_isr(&isr_meta, adv, &m), -RT_EBUSY);
+    uassert_int_equal(orb_publish_isr(&isr_meta, RT_NULL, &m), -RT_EINVAL);
+    uassert_int_equal(orb_prepare_isr(adv), RT_EOK);
+}
+
+/* 槽拷贝与代数推进在中断内完成，回调与唤醒在下半部线程中执行 */
+static void test_isr_publish(void)
+{
+    orb_subscr_t sub = orb_subscribe(&isr_meta);
+    uassert_true(sub != RT_NULL);
+    rt_bool_t updated = RT_FALSE;
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+
+    publish_isr(1);
+    publish_isr(2);
+    publish_isr(3);
+
+    /* 队列中三条消息均可读到 */
+    struct isr_msg_s m = {0};
+    for (int i = 1; i <= 3; i++)
+    {
+        uassert_int_equal(orb_update(sub, &m), sizeof(m));
+        uassert_int_equal(m.val, i);
+    }
+
+    /* 回调按代数看到每一条 */
+    for (int i = 0; i < 100 && cb_last != 3; i++)
+    {
+        rt_thread_mdelay(5);
+    }
+    uassert_int_equal(cb_count, 3);
+    for (int i = 0; i < 3; i++)
+    {
+        uassert_int_equal(cb_seen[i], i + 1);
+    }
+    uassert_false(cb_in_isr);
+
+    rt_uint32_t delivered = 0, dropped = 0;
+    uassert_int_equal(orb_isr_get_stat(&delivered, &dropped), RT_EOK);
+    uassert_int_equal(delivered, 3);
+    uassert_int_equal(dropped, 0);
+
+    /* 等待者由下半部唤醒 */
+    publish_isr(4);
+    uassert_int_equal(orb_wait(sub, 1000), RT_EOK);
+    uassert_int_equal(orb_copy(&isr_meta, sub, &m), sizeof(m));
+    uassert_int_equal(m.val, 4);
+
+    orb_unsubscribe(sub);
+}
+
+/* 下半部落后超过队列深度（4）：被覆盖的消息计入丢失，其余仍按序派发 */
+static void test_isr_overrun(void)
+{
+    rt_uint32_t delivered0 = 0, dropped0 = 0;
+    uassert_int_equal(orb_isr_get_stat(&delivered0, &dropped0), RT_EOK);
+    cb_gate  = rt_sem_create("isr_gate", 0, RT_IPC_FLAG_FIFO);
+    uassert_not_null(cb_gate);
+    cb_count = 0;
+
+    publish_isr(10);
+    for (int i = 0; i < 100 && cb_count == 0; i++)
+    {
+        rt_thread_mdelay(5);
+    }
+    uassert_int_equal(cb_count, 1);
+    /* 下半部阻塞在 10 的回调中，期间发布 6 条 */
+    for (int v = 11; v <= 16; v++)
+    {
+        publish_isr(v);
+    }
+    rt_sem_t gate = cb_gate;
+    cb_gate       = RT_NULL;
+    rt_sem_release(gate);
+    for (int i = 0; i < 100 && cb_last != 16; i++)
+    {
+        rt_thread_mdelay(5);
+    }
+    rt_sem_delete(gate);
+
+    static const rt_int32_t expect[] = {10, 13, 14, 15, 16};
+    uassert_int_equal(cb_count, 5);
+    for (int i = 0; i < 5; i++)
+    {
+        uassert_int_equal(cb_seen[i], expect[i]);
+    }
+    rt_uint32_t delivered = 0, dropped = 0;
+    uassert_int_equal(orb_isr_get_stat(&delivered, &dropped), RT_EOK);
+    uassert_int_equal(delivered - delivered0, 5);
+    uassert_int_equal(dropped - dropped0, 2);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_isr_requires_prepare);
+    UTEST_UNIT_RUN(test_isr_publish);
+    UTEST_UNIT_RUN(test_isr_overrun);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.isr", tc_init, tc_cleanup, 20);
+#endif
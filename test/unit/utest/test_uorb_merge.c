@@ -0,0 +1,232 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_merge.h"
+
+struct merge_a_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  a;
+};
+
+struct merge_b_s
+{
+    rt_uint32_t pad;
+    rt_uint64_t timestamp;
+    rt_int16_t  b;
+};
+
+static const struct orb_metadata merge_a_meta = {
+    "uorb_merge_a",
+    sizeof(struct merge_a_s),
+    sizeof(struct merge_a_s),
+    "uint64_t timestamp;int32 a;@queue=8",
+    0,
+};
+
+static const struct orb_metadata merge_b_meta = {
+    "uorb_merge_b",
+    sizeof(struct merge_b_s),
+    sizeof(struct merge_b_s),
+    "uint32 pad;uint64_t timestamp;int16 b;@queue=8",
+    0,
+};
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+static void pub_a(orb_advert_t adv, rt_uint64_t ts)
+{
+    struct merge_a_s m = {ts, (rt_int32_t)ts};
+    (void)orb_publish(&merge_a_meta, adv, &m);
+}
+
+static void pub_b(orb_advert_t adv, rt_uint64_t ts)
+{
+    struct merge_b_s m = {0, ts, (rt_int16_t)ts};
+    (void)orb_publish(&merge_b_meta, adv, &m);
+}
+
+/* 取下一条的 timestamp，无输出时返回 0 */
+static rt_uint64_t next_ts(orb_merge_t *mg, int *src)
+{
+    union
+    {
+        struct merge_a_s a;
+        struct merge_b_s b;
+    } buf;
+    if (orb_merge_next(mg, &buf, sizeof(buf), src) <= 0)
+    {
+        return 0;
+    }
+    return (*src == 0) ? buf.a.timestamp : buf.b.timestamp;
+}
+
+/* 多个源按 timestamp 全局升序输出，与发布顺序无关 */
+static void test_merge_order(void)
+{
+    orb_merge_t *mg = orb_merge_create(3);
+    uassert_not_null(mg);
+    uassert_int_equal(orb_merge_add(mg, &merge_a_meta, 0), 0);
+    uassert_int_equal(orb_merge_add(mg, &merge_b_meta, 0), 1);
+    uassert_int_equal(orb_merge_add(mg, &merge_b_meta, 1), 2);
+
+    int i1 = 1;
+    orb_advert_t a  = orb_advertise_queue(&merge_a_meta, RT_NULL, 8);
+    orb_advert_t b0 = orb_advertise_queue(&merge_b_meta, RT_NULL, 8);
+    orb_advert_t b1 = orb_advertise_multi_queue(&merge_b_meta, RT_NULL, &i1, 8);
+    uassert_true(a && b0 && b1 && i1 == 1);
+
+    pub_a(a, 10);
+    pub_a(a, 30);
+    pub_a(a, 60);
+    pub_b(b1, 25);
+    pub_b(b0, 20);
+    pub_b(b0, 50);
+    pub_b(b1, 40);
+    pub_b(b0, 70);
+    pub_b(b1, 80);
+
+    static const rt_uint64_t expect_ts[]  = {10, 20, 25, 30, 40, 50, 60};
+    static const int         expect_src[] = {0, 1, 2, 0, 2, 1, 0};
+    for (int i = 0; i < 7; i++)
+    {
+        int src = -1;
+        uassert_int_equal(next_ts(mg, &src), expect_ts[i]);
+        uassert_int_equal(src, expect_src[i]);
+    }
+    /* a 已读空，stall 超时内仍可能发布早于 70 的消息 */
+    int src = -1;
+    uassert_int_equal(next_ts(mg, &src), 0);
+
+    orb_merge_delete(mg);
+    orb_unadvertise(a);
+    orb_unadvertise(b0);
+    orb_unadvertise(b1);
+}
+
+/* 空源阻塞更晚的消息，超时停滞后放行 */
+static void test_merge_stall(void)
+{
+    orb_merge_t *mg = orb_merge_create(2);
+    uassert_not_null(mg);
+    orb_merge_add(mg, &merge_a_meta, 0);
+    orb_merge_add(mg, &merge_b_meta, 0);
+    uassert_int_equal(orb_merge_set_stall_timeout(mg, 60 * 1000), RT_EOK);
+
+    orb_advert_t a = orb_advertise_queue(&merge_a_meta, RT_NULL, 8);
+    orb_advert_t b = orb_advertise_queue(&merge_b_meta, RT_NULL, 8);
+    uassert_true(a && b);
+
+    int src = -1;
+    pub_a(a, 10);
+    pub_a(a, 30);
+    uassert_int_equal(next_ts(mg, &src), 0);
+
+    pub_b(b, 20);
+    uassert_int_equal(next_ts(mg, &src), 10);
+    uassert_int_equal(next_ts(mg, &src), 20);
+    uassert_int_equal(next_ts(mg, &src), 0);
+
+    rt_thread_mdelay(100);
+    uassert_int_equal(next_ts(mg, &src), 30);
+    uassert_int_equal(src, 0);
+
+    /* 取消公告的源不再阻塞 */
+    pub_b(b, 40);
+    orb_unadvertise(b);
+    pub_a(a, 50);
+    pub_a(a, 70);
+    uassert_int_equal(next_ts(mg, &src), 40);
+    uassert_int_equal(next_ts(mg, &src), 50);
+    uassert_int_equal(next_ts(mg, &src), 70);
+
+    orb_merge_delete(mg);
+    orb_unadvertise(a);
+}
+
+/* 默认配置下，尚无消息的源（含未公告）阻塞其他源，直到跟上或停滞 */
+static void test_merge_empty_source(void)
+{
+    orb_merge_t *mg = orb_merge_create(2);
+    uassert_not_null(mg);
+    orb_merge_add(mg, &merge_a_meta, 0);
+    orb_merge_add(mg, &merge_b_meta, 0);
+
+    orb_advert_t a = orb_advertise_queue(&merge_a_meta, RT_NULL, 8);
+    uassert_not_null(a);
+
+    int src = -1;
+    pub_a(a, 10);
+    pub_a(a, 30);
+    uassert_int_equal(next_ts(mg, &src), 0);
+
+    /* b 后公告，其较早的消息仍按序插入 */
+    orb_advert_t b = orb_advertise_queue(&merge_b_meta, RT_NULL, 8);
+    uassert_not_null(b);
+    pub_b(b, 20);
+    uassert_int_equal(next_ts(mg, &src), 10);
+    uassert_int_equal(next_ts(mg, &src), 20);
+    uassert_int_equal(src, 1);
+    uassert_int_equal(next_ts(mg, &src), 0);
+    rt_thread_mdelay(UORB_MERGE_STALL_US / 1000 + 20);
+    uassert_int_equal(next_ts(mg, &src), 30);
+    orb_unadvertise(b);
+    orb_merge_delete(mg);
+
+    /* 始终不公告的源只阻塞一个 stall 超时；超时设为 0 则从不等待 */
+    mg = orb_merge_create(2);
+    uassert_not_null(mg);
+    orb_merge_add(mg, &merge_a_meta, 0);
+    orb_merge_add(mg, &merge_b_meta, 1);
+    pub_a(a, 40);
+    uassert_int_equal(next_ts(mg, &src), 0);
+    uassert_int_equal(orb_merge_set_stall_timeout(mg, 0), RT_EOK);
+    uassert_int_equal(next_ts(mg, &src), 40);
+
+    orb_merge_delete(mg);
+    orb_unadvertise(a);
+}
+
+/* 源落后超过队列深度：跳到最早可用的一条并计入丢失 */
+static void test_merge_overrun(void)
+{
+    orb_merge_t *mg = orb_merge_create(1);
+    uassert_not_null(mg);
+    uassert_int_equal(orb_merge_add(mg, &merge_a_meta, 0), 0);
+    uassert_int_equal(orb_merge_add(mg, &merge_b_meta, 0), -RT_EFULL);
+
+    orb_advert_t a = orb_advertise_queue(&merge_a_meta, RT_NULL, 8);
+    uassert_not_null(a);
+    for (int i = 1; i <= 10; i++)
+    {
+        pub_a(a, i * 10);
+    }
+
+    int src = -1;
+    for (int i = 3; i <= 10; i++)
+    {
+        uassert_int_equal(next_ts(mg, &src), i * 10);
+    }
+    uassert_int_equal(next_ts(mg, &src), 0);
+    uassert_int_equal(orb_merge_lost(mg, 0), 2);
+
+    orb_merge_delete(mg);
+    orb_unadvertise(a);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_merge_order);
+    UTEST_UNIT_RUN(test_merge_stall);
+    UTEST_UNIT_RUN(test_merge_empty_source);
+    UTEST_UNIT_RUN(test_merge_overrun);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.merge", tc_init, tc_cleanup, 20);
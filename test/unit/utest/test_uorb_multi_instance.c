@@ -7,6 +7,7 @@
 #include <rtthread.h>
 #include <utest.h>
 #include "uORB.h"
+#include "uorb_device_node.h"
 #if defined(UORB_TOPICS_GENERATED)
 #include "topics/orb_test.h"
 #include "topics/sensor_demo.h"
@@ -51,9 +52,177 @@ static void test_multi_isolation(void)
     orb_unadvertise(adv0); orb_unadvertise(adv1);
 }
 
+#define RESTART_CYCLES 10000
+
+/* 模拟发布模块反复重启：公告 -> 发布 -> 取消公告。
+ * 每次应重新获得同一实例，且堆占用不随重启次数增长。 */
+static void restart_cycles(orb_subscr_t sub, int expect_inst, int *mismatch)
+{
+    struct sensor_demo_s s = {0};
+    for (int i = 0; i < RESTART_CYCLES; i++)
+    {
+        int          inst = -1;
+        orb_advert_t adv  = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+        if (!adv || inst != expect_inst)
+        {
+            (*mismatch)++;
+            if (adv) orb_unadvertise(adv);
+            continue;
+        }
+        s.x = i;
+        (void)orb_publish(ORB_ID(sensor_demo), adv, &s);
+        if (sub)
+        {
+            struct sensor_demo_s out;
+            if (orb_update(sub, &out) <= 0 || out.x != i)
+            {
+                (*mismatch)++;
+            }
+        }
+        orb_unadvertise(adv);
+    }
+}
+
+static void test_multi_restart(void)
+{
+    struct sensor_demo_s s = {0};
+    /* 另一个常驻发布者占用一个实例，重启的模块应稳定拿到下一个空闲实例 */
+    int          keep_inst = -1;
+    orb_advert_t keep      = orb_advertise_multi(ORB_ID(sensor_demo), &s, &keep_inst);
+    uassert_not_null(keep);
+
+    int          inst = -1;
+    orb_advert_t adv  = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    uassert_not_null(adv);
+    uassert_true(inst != keep_inst);
+    orb_unadvertise(adv);
+
+    rt_size_t total, used_before, used_after, max_used;
+    int       mismatch = 0;
+
+    /* 无订阅者：每次重启都释放并重建节点 */
+    rt_memory_info(&total, &used_before, &max_used);
+    restart_cycles(RT_NULL, inst, &mismatch);
+    rt_memory_info(&total, &used_after, &max_used);
+    uassert_int_equal(mismatch, 0);
+    uassert_int_equal(used_after, used_before);
+
+    /* 有常驻订阅者：节点保留，重启后复用同一节点且订阅者继续收到数据 */
+    adv = orb_advertise_multi(ORB_ID(sensor_demo), &s, &inst);
+    uassert_not_null(adv);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(sensor_demo), (rt_uint8_t)inst);
+    uassert_not_null(sub);
+    orb_unadvertise(adv);
+    rt_memory_info(&total, &used_before, &max_used);
+    restart_cycles(sub, inst, &mismatch);
+    rt_memory_info(&total, &used_after, &max_used);
+    uassert_int_equal(mismatch, 0);
+    uassert_int_equal(used_after, used_before);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(keep);
+}
+
+/* 独立主题：一个使用编译期上限，一个通过 @instances 收紧上限 */
+struct multi_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata multi_max_meta = {
+    "uorb_multi_max", sizeof(struct multi_msg_s), sizeof(struct multi_msg_s),
+    "uint64_t timestamp;int32 val;", 0,
+};
+
+static const struct orb_metadata multi_two_meta = {
+    "uorb_multi_two", sizeof(struct multi_msg_s), sizeof(struct multi_msg_s),
+    "uint64_t timestamp;int32 val;@instances=2;", 0,
+};
+
+static void test_multi_limit(void)
+{
+    struct multi_msg_s m = {0};
+    orb_advert_t adv[ORB_MULTI_MAX_INSTANCES];
+    int          inst;
+
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        inst   = -1;
+        adv[i] = orb_advertise_multi(&multi_max_meta, &m, &inst);
+        uassert_not_null(adv[i]);
+        uassert_int_equal(inst, i);
+        uassert_int_equal(orb_group_count(&multi_max_meta), i + 1);
+    }
+    uassert_null(orb_advertise_multi(&multi_max_meta, &m, &inst));
+
+    /* 释放实例0：orb_publish(meta, NULL) 落到已公告的最小实例 */
+    orb_unadvertise(adv[0]);
+    uassert_int_equal(orb_group_count(&multi_max_meta), ORB_MULTI_MAX_INSTANCES - 1);
+    if (ORB_MULTI_MAX_INSTANCES > 1)
+    {
+        orb_subscr_t sub = orb_subscribe_multi(&multi_max_meta, 1);
+        m.val            = 42;
+        uassert_int_equal(orb_publish(&multi_max_meta, RT_NULL, &m), RT_EOK);
+        struct multi_msg_s out = {0};
+        uassert_int_equal(orb_update(sub, &out), sizeof(out));
+        uassert_int_equal(out.val, 42);
+        orb_unsubscribe(sub);
+    }
+
+    /* 空出的实例被重新占用 */
+    inst   = -1;
+    adv[0] = orb_advertise_multi(&multi_max_meta, &m, &inst);
+    uassert_int_equal(inst, 0);
+    for (int i = 0; i < ORB_MULTI_MAX_INSTANCES; i++)
+    {
+        orb_unadvertise(adv[i]);
+    }
+    uassert_int_equal(orb_group_count(&multi_max_meta), 0);
+
+    /* 主题级上限 */
+    orb_advert_t a0 = orb_advertise_multi(&multi_two_meta, &m, &inst);
+    orb_advert_t a1 = orb_advertise_multi(&multi_two_meta, &m, &inst);
+    uassert_true(a0 && a1);
+    uassert_null(orb_advertise_multi(&multi_two_meta, &m, &inst));
+    uassert_int_equal(orb_group_count(&multi_two_meta), 2);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+static const struct orb_metadata multi_dup_meta = {
+    "uorb_multi_dup", sizeof(struct multi_msg_s), sizeof(struct multi_msg_s),
+    "uint64_t timestamp;int32 val;", 0,
+};
+
+/* 同一实例再次创建返回已有节点；删除最后一个节点时主题组随之释放 */
+static void test_multi_create_existing(void)
+{
+    rt_size_t total, used_before, used_after, max_used;
+    rt_memory_info(&total, &used_before, &max_used);
+
+    orb_node_t *n0 = orb_node_create(&multi_dup_meta, 0, 1);
+    orb_node_t *n1 = orb_node_create(&multi_dup_meta, 1, 1);
+    uassert_true(n0 && n1 && n0 != n1);
+    uassert_true(orb_node_create(&multi_dup_meta, 0, 4) == n0);
+    uassert_true(orb_node_find(&multi_dup_meta, 0) == n0);
+
+    uassert_int_equal(orb_node_delete(n0), RT_EOK);
+    uassert_null(orb_node_find(&multi_dup_meta, 0));
+    uassert_true(orb_node_find(&multi_dup_meta, 1) == n1);
+    uassert_int_equal(orb_node_delete(n1), RT_EOK);
+    uassert_null(orb_node_find(&multi_dup_meta, 1));
+
+    rt_memory_info(&total, &used_after, &max_used);
+    uassert_int_equal(used_after, used_before);
+}
+
 static void testcase(void)
 {
     UTEST_UNIT_RUN(test_multi_isolation);
+    UTEST_UNIT_RUN(test_multi_restart);
+    UTEST_UNIT_RUN(test_multi_limit);
+    UTEST_UNIT_RUN(test_multi_create_existing);
 }
 
 UTEST_TC_EXPORT(testcase, "uorb.multi", tc_init, tc_cleanup, 20); 
\ No newline at end of file
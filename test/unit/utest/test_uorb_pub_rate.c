@@ -0,0 +1,249 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#if defined(UORB_TOPICS_GENERATED)
+#include "topics/orb_test.h"
+#include "topics/sensor_demo.h"
+#else
+#include "uorb_demo_topics.h"
+#endif
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+/* 抽取：每 4 次保留 1 次，被丢弃的发布不推进代数 */
+static void test_pub_decimation(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    uassert_int_equal(orb_set_publish_decimation(adv, 4), RT_EOK);
+
+    int seen = 0;
+    for (int i = 0; i < 12; i++)
+    {
+        t.val = i;
+        uassert_int_equal(orb_publish(ORB_ID(orb_test), adv, &t), RT_EOK);
+        rt_bool_t updated = RT_FALSE;
+        (void)orb_check(sub, &updated);
+        if (updated)
+        {
+            struct orb_test_s rx;
+            (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+            uassert_int_equal(rx.val % 4, 0);
+            seen++;
+        }
+    }
+    uassert_int_equal(seen, 3);
+
+    rt_uint32_t supp = 0;
+    uassert_int_equal(orb_get_publish_suppressed(adv, &supp), RT_EOK);
+    uassert_int_equal(supp, 9);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+static void test_pub_interval(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    uassert_int_equal(orb_set_publish_interval_us(adv, 100000), RT_EOK);
+
+    rt_bool_t updated = RT_FALSE;
+    t.val = 1; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    struct orb_test_s rx; (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+
+    /* 间隔内的发布被丢弃 */
+    t.val = 2; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+
+    rt_thread_mdelay(120);
+    t.val = 3; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+    uassert_int_equal(rx.val, 3);
+
+    /* 取消限速后全部放行 */
+    uassert_int_equal(orb_set_publish_interval_us(adv, 0), RT_EOK);
+    t.val = 4; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+
+    rt_uint32_t supp = 0;
+    (void)orb_get_publish_suppressed(adv, &supp);
+    uassert_int_equal(supp, 1);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 自动限速：只有全部消费者都节流时才采用最快订阅者间隔 */
+static void test_pub_auto_rate(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t slow = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    orb_subscr_t fast = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(slow != RT_NULL && fast != RT_NULL);
+
+    uassert_int_equal(orb_set_interval(slow, 500), RT_EOK);
+    uassert_int_equal(orb_set_interval(fast, 100), RT_EOK);
+    uassert_int_equal(orb_set_publish_auto_rate(adv, RT_TRUE), RT_EOK);
+
+    rt_uint32_t supp0 = 0, supp = 0;
+    (void)orb_get_publish_suppressed(adv, &supp0);
+    t.val = 1; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    t.val = 2; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    (void)orb_get_publish_suppressed(adv, &supp);
+    uassert_int_equal(supp - supp0, 1);
+
+    /* 加入未节流订阅者后不再丢弃 */
+    orb_subscr_t raw = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(raw != RT_NULL);
+    t.val = 3; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    t.val = 4; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    (void)orb_get_publish_suppressed(adv, &supp);
+    uassert_int_equal(supp - supp0, 1);
+    rt_bool_t updated = RT_FALSE;
+    uassert_int_equal(orb_check(raw, &updated), RT_EOK);
+    uassert_true(updated);
+    orb_unsubscribe(raw);
+
+    orb_unsubscribe(fast);
+    orb_unsubscribe(slow);
+    orb_unadvertise(adv);
+}
+
+/* 变化发布：只有 timestamp 不同的消息不推进代数，心跳间隔到后仍放行一次 */
+static void test_pub_on_change(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+
+    uassert_int_equal(orb_set_publish_on_change(adv, RT_TRUE, 100000), RT_EOK);
+
+    rt_uint32_t supp0 = 0, supp = 0;
+    (void)orb_get_publish_suppressed(adv, &supp0);
+    rt_bool_t updated = RT_FALSE;
+    struct orb_test_s rx;
+    t.timestamp = 1; t.val = 5; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+
+    for (int i = 2; i < 6; i++)
+    {
+        t.timestamp = i;
+        uassert_int_equal(orb_publish(ORB_ID(orb_test), adv, &t), RT_EOK);
+    }
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_false(updated);
+    (void)orb_get_publish_suppressed(adv, &supp);
+    uassert_int_equal(supp - supp0, 4);
+
+    t.timestamp = 6; t.val = 6; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+    uassert_int_equal(rx.val, 6);
+
+    /* 心跳：内容不变但距上次放行已超过间隔 */
+    rt_thread_mdelay(120);
+    t.timestamp = 7; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    (void)orb_copy(ORB_ID(orb_test), sub, &rx);
+    uassert_true(rx.timestamp == 7);
+
+    /* 关闭后相同内容照常发布 */
+    uassert_int_equal(orb_set_publish_on_change(adv, RT_FALSE, 0), RT_EOK);
+    t.timestamp = 8; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 变化发布与限速/抽取组合：内容未变化的消息不占用抽取计数与限速周期 */
+static void test_pub_on_change_limited(void)
+{
+    struct orb_test_s t = {0};
+    int inst = -1;
+    orb_advert_t adv = orb_advertise_multi(ORB_ID(orb_test), &t, &inst);
+    uassert_true(adv != RT_NULL);
+    orb_subscr_t sub = orb_subscribe_multi(ORB_ID(orb_test), (rt_uint8_t)inst);
+    uassert_true(sub != RT_NULL);
+    rt_bool_t updated = RT_FALSE;
+    struct orb_test_s rx;
+    (void)orb_check(sub, &updated);
+
+    /* 抽取 2：变化的消息隔一条放行一条，中间重复的消息不计数 */
+    uassert_int_equal(orb_set_publish_on_change(adv, RT_TRUE, 0), RT_EOK);
+    uassert_int_equal(orb_set_publish_decimation(adv, 2), RT_EOK);
+    static const rt_int32_t  vals[]   = {1, 1, 1, 1, 2, 3};
+    static const rt_bool_t   passed[] = {RT_TRUE, RT_FALSE, RT_FALSE, RT_FALSE, RT_FALSE, RT_TRUE};
+    for (int i = 0; i < 6; i++)
+    {
+        t.val = vals[i];
+        (void)orb_publish(ORB_ID(orb_test), adv, &t);
+        uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+        uassert_int_equal(updated, passed[i]);
+    }
+    uassert_int_equal(orb_copy(ORB_ID(orb_test), sub, &rx), sizeof(rx));
+    uassert_int_equal(rx.val, 3);
+    uassert_int_equal(orb_set_publish_decimation(adv, 1), RT_EOK);
+
+    /* 限速：周期到后先来一条重复消息，随后变化的消息仍应放行 */
+    uassert_int_equal(orb_set_publish_interval_us(adv, 100000), RT_EOK);
+    t.val = 4; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_copy(ORB_ID(orb_test), sub, &rx), sizeof(rx));
+    uassert_int_equal(rx.val, 4);
+    rt_thread_mdelay(120);
+    t.val = 4; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    t.val = 5; (void)orb_publish(ORB_ID(orb_test), adv, &t);
+    uassert_int_equal(orb_check(sub, &updated), RT_EOK);
+    uassert_true(updated);
+    uassert_int_equal(orb_copy(ORB_ID(orb_test), sub, &rx), sizeof(rx));
+    uassert_int_equal(rx.val, 5);
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_pub_decimation);
+    UTEST_UNIT_RUN(test_pub_interval);
+    UTEST_UNIT_RUN(test_pub_auto_rate);
+    UTEST_UNIT_RUN(test_pub_on_change);
+    UTEST_UNIT_RUN(test_pub_on_change_limited);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.pub_rate", tc_init, tc_cleanup, 20);
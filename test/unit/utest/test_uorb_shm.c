@@ -0,0 +1,115 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_shm.h"
+
+#if defined(UORB_USING_SHM)
+#include <stdio.h>
+#include <unistd.h>
+#include <sys/wait.h>
+
+struct shm_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata shm_meta = {
+    "uorb_shm_topic",
+    sizeof(struct shm_msg_s),
+    sizeof(struct shm_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static char shm_name[32];
+
+static rt_err_t tc_init(void)
+{
+    snprintf(shm_name, sizeof(shm_name), "/uorb_utest_%d", (int)getpid());
+    return orb_shm_attach(shm_name, 64 * 1024) == RT_EOK ? RT_EOK : -RT_ERROR;
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    orb_shm_detach();
+    orb_shm_unlink(shm_name);
+    return RT_EOK;
+}
+
+/* 子进程公告并发布，父进程经 futex 被唤醒，orb_copy 直接从共享环形缓冲读出 */
+static void test_shm_cross_process(void)
+{
+    int ready[2], go[2];
+    uassert_int_equal(pipe(ready), 0);
+    uassert_int_equal(pipe(go), 0);
+    orb_subscr_t waiter = orb_subscribe(&shm_meta);
+    orb_subscr_t reader = orb_subscribe(&shm_meta);
+    uassert_true(waiter && reader);
+    uassert_int_equal(orb_wait(waiter, 0), -RT_ENOENT);
+
+    pid_t pid = fork();
+    if (pid == 0)
+    {
+        /* 子进程继承映射，之后创建的节点同样绑定到共享段 */
+        orb_advert_t adv = orb_advertise_queue(&shm_meta, RT_NULL, 4);
+        char         c   = adv ? 1 : 0;
+        (void)write(ready[1], &c, 1);
+        (void)read(go[0], &c, 1);
+        for (int i = 1; i <= 3; i++)
+        {
+            struct shm_msg_s m = {(rt_uint64_t)i, i * 10};
+            orb_publish(&shm_meta, adv, &m);
+        }
+        _exit(0);
+    }
+    uassert_true(pid > 0);
+
+    char c = 0;
+    uassert_int_equal(read(ready[0], &c, 1), 1);
+    uassert_int_equal(c, 1);
+
+    /* 另一进程已公告：本进程首次使用时建本地节点绑定到共享项 */
+    rt_bool_t updated = RT_TRUE;
+    uassert_int_equal(orb_check(reader, &updated), RT_EOK);
+    uassert_false(updated);
+    uassert_int_equal(orb_wait(waiter, 20), -RT_ETIMEOUT);
+
+    (void)write(go[1], &c, 1);
+    uassert_int_equal(orb_wait(waiter, 2000), RT_EOK);
+    int status = 0;
+    uassert_int_equal(waitpid(pid, &status, 0), pid);
+
+    /* 队列长度取自共享项，游标从绑定时的代数开始依次读到 3 条 */
+    struct shm_msg_s m = {0};
+    for (int i = 1; i <= 3; i++)
+    {
+        uassert_int_equal(orb_copy(&shm_meta, reader, &m), sizeof(m));
+        uassert_int_equal(m.val, i * 10);
+    }
+    orb_node_stat_t st;
+    uassert_int_equal(orb_node_stat(&shm_meta, 0, &st), RT_EOK);
+    uassert_int_equal(st.generation, 3);
+    uassert_int_equal(st.queue_size, 4);
+
+    orb_unsubscribe(waiter);
+    orb_unsubscribe(reader);
+    close(ready[0]);
+    close(ready[1]);
+    close(go[0]);
+    close(go[1]);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_shm_cross_process);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.shm", tc_init, tc_cleanup, 20);
+#endif
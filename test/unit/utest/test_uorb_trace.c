@@ -0,0 +1,123 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_trace.h"
+#include "uorb_internal.h"
+
+#if defined(UORB_USING_TRACE)
+struct trace_msg_s
+{
+    rt_uint64_t timestamp;
+    rt_int32_t  val;
+};
+
+static const struct orb_metadata trace_meta = {
+    "uorb_trace_topic",
+    sizeof(struct trace_msg_s),
+    sizeof(struct trace_msg_s),
+    "uint64_t timestamp;int32 val;",
+    0,
+};
+
+static uorb_trace_rec_t recs[64];
+
+static rt_err_t tc_init(void)
+{
+    uorb_trace_stop();
+    uorb_trace_clear();
+    return RT_EOK;
+}
+
+static rt_err_t tc_cleanup(void)
+{
+    uorb_trace_stop();
+    uorb_trace_clear();
+    return RT_EOK;
+}
+
+/* 发布/拷贝/等待依次记录，时间戳不减，代数与节点序号对应 */
+static void test_trace_events(void)
+{
+    orb_advert_t adv = orb_advertise(&trace_meta, RT_NULL);
+    orb_subscr_t sub = orb_subscribe(&trace_meta);
+    uassert_true(adv && sub);
+
+    struct trace_msg_s m = {1, 2};
+    uorb_trace_clear();
+    (void)orb_publish(&trace_meta, adv, &m); /* 停止状态下不记录 */
+    (void)orb_copy(&trace_meta, sub, &m);
+    orb_node_stat_t st;
+    uassert_int_equal(orb_node_stat(&trace_meta, 0, &st), RT_EOK);
+
+    uorb_trace_start();
+    (void)orb_publish(&trace_meta, adv, &m);
+    (void)orb_copy(&trace_meta, sub, &m);
+    uassert_int_equal(orb_wait(sub, 20), -RT_ETIMEOUT);
+    uorb_trace_stop();
+    (void)orb_publish(&trace_meta, adv, &m);
+
+    rt_uint32_t lost = 1;
+    int         n    = uorb_trace_copy(0, recs, 64, &lost);
+    uassert_int_equal(lost, 0);
+    uassert_int_equal(n, 5);
+
+    static const rt_uint8_t expect[] = {UORB_TRACE_PUBLISH, UORB_TRACE_NOTIFY, UORB_TRACE_COPY, UORB_TRACE_WAIT,
+                                        UORB_TRACE_WAKE};
+    for (int i = 0; i < n && i < 5; i++)
+    {
+        uassert_int_equal(recs[i].event, expect[i]);
+        uassert_int_equal(recs[i].node_id, st.id);
+        uassert_int_equal(recs[i].thread, (rt_uint32_t)(rt_ubase_t)rt_thread_self());
+        uassert_int_equal(recs[i].generation, st.generation + 1);
+        if (i > 0)
+        {
+            uassert_true(recs[i].timestamp >= recs[i - 1].timestamp);
+        }
+    }
+
+    orb_unsubscribe(sub);
+    orb_unadvertise(adv);
+}
+
+/* 缓冲写满后覆盖最旧记录，并报告丢失数 */
+static void test_trace_wrap(void)
+{
+    orb_advert_t adv = orb_advertise(&trace_meta, RT_NULL);
+    uassert_not_null(adv);
+
+    struct trace_msg_s m = {0};
+    uorb_trace_clear();
+    uorb_trace_start();
+    for (int i = 0; i < UORB_TRACE_BUF_SIZE; i++)
+    {
+        (void)orb_publish(&trace_meta, adv, &m);
+    }
+    uorb_trace_stop();
+
+    rt_uint32_t lost = 0;
+    int         n    = uorb_trace_copy(0, recs, 4, &lost);
+    uassert_int_equal(n, 4);
+    uassert_int_equal(lost, UORB_TRACE_BUF_SIZE);
+    uassert_int_equal(recs[3].event, UORB_TRACE_NOTIFY);
+    uassert_int_equal(recs[2].event, UORB_TRACE_PUBLISH);
+    uassert_int_equal(recs[3].generation, recs[2].generation);
+    uassert_int_equal(recs[2].generation, recs[0].generation + 1);
+    uassert_int_equal(uorb_trace_copy(UORB_CPUS_NR, recs, 4, RT_NULL), -RT_EINVAL);
+
+    orb_unadvertise(adv);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_trace_events);
+    UTEST_UNIT_RUN(test_trace_wrap);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.trace", tc_init, tc_cleanup, 20);
+#endif
@@ -0,0 +1,292 @@
+/*
+*****************************************************************
+* Copyright All Reserved © 2015-2025 Solonix-Chu
+*****************************************************************
+*/
+
+#include <rtthread.h>
+#include <utest.h>
+#include "uORB.h"
+#include "uorb_voter.h"
+#include "uorb_device_node.h"
+
+struct voter_msg_s
+{
+    rt_uint64_t timestamp;
+    float       val;
+    rt_int32_t  seq;
+};
+
+static const struct orb_metadata voter_in_meta = {
+    "uorb_voter_in",
+    sizeof(struct voter_msg_s),
+    sizeof(struct voter_msg_s),
+    "uint64_t timestamp;float val;int32 seq;",
+    0,
+};
+
+static const struct orb_metadata voter_out_meta = {
+    "uorb_voter_out",
+    sizeof(struct voter_msg_s),
+    sizeof(struct voter_msg_s),
+    "uint64_t timestamp;float val;int32 seq;",
+    0,
+};
+
+static rt_err_t tc_init(void) { return RT_EOK; }
+static rt_err_t tc_cleanup(void) { return RT_EOK; }
+
+static void publish(orb_advert_t adv, rt_uint64_t ts, float val, rt_int32_t seq)
+{
+    struct voter_msg_s m = {ts, val, seq};
+    (void)orb_publish(&voter_in_meta, adv, &m);
+}
+
+/* 输出只转发选中实例的消息；优先级高者胜出 */
+static void test_voter_priority(void)
+{
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 3);
+    uassert_not_null(v);
+    orb_subscr_t out = orb_subscribe(&voter_out_meta);
+    uassert_not_null(out);
+
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    uassert_true(a0 && a1 && i0 == 0 && i1 == 1);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+    (void)orb_set_priority(a1, ORB_PRIO_HIGH);
+
+    struct voter_msg_s m;
+    publish(a0, 1, 1.0f, 100);
+    uassert_int_equal(orb_voter_selected(v), i0);
+    uassert_int_equal(orb_copy(&voter_out_meta, out, &m), sizeof(m));
+    uassert_int_equal(m.seq, 100);
+
+    publish(a1, 1, 1.0f, 200);
+    uassert_int_equal(orb_voter_selected(v), i1);
+    uassert_int_equal(orb_voter_failovers(v), 1);
+
+    /* 未选中实例的发布不到达输出 */
+    publish(a0, 2, 1.0f, 101);
+    publish(a0, 3, 1.0f, 102);
+    uassert_int_equal(orb_update(out, &m), sizeof(m));
+    uassert_int_equal(m.seq, 200);
+    uassert_int_equal(orb_update(out, &m), 0);
+
+    orb_voter_status_t st;
+    uassert_int_equal(orb_voter_status(v, i0, &st), RT_EOK);
+    uassert_int_equal(st.count, 3);
+    uassert_int_equal(st.flags, 0);
+    uassert_int_equal(orb_voter_status(v, 2, &st), RT_EOK);
+    uassert_int_equal(st.flags, ORB_VOTER_STALE);
+
+    orb_unsubscribe(out);
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* 内容卡死与 timestamp 回退：切到备份并计错 */
+static void test_voter_stuck(void)
+{
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 3);
+    uassert_not_null(v);
+    uassert_int_equal(orb_voter_set_stuck_limit(v, 3), RT_EOK);
+
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    uassert_true(a0 && a1);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+    (void)orb_set_priority(a0, ORB_PRIO_HIGH);
+
+    publish(a0, 1, 1.0f, 1);
+    publish(a1, 1, 1.0f, 1);
+    uassert_int_equal(orb_voter_selected(v), i0);
+
+    /* timestamp 递增但内容不变 */
+    publish(a0, 2, 1.0f, 1);
+    publish(a0, 3, 1.0f, 1);
+    uassert_int_equal(orb_voter_selected(v), i1);
+
+    orb_voter_status_t st;
+    uassert_int_equal(orb_voter_status(v, i0, &st), RT_EOK);
+    uassert_int_equal(st.flags, ORB_VOTER_STUCK);
+    uassert_int_equal(st.errors, 1);
+
+    /* 恢复变化后主实例优先级更高，切回 */
+    publish(a0, 4, 1.0f, 2);
+    uassert_int_equal(orb_voter_selected(v), i0);
+
+    /* timestamp 回退 */
+    publish(a0, 2, 1.0f, 3);
+    uassert_int_equal(orb_voter_selected(v), i1);
+    uassert_int_equal(orb_voter_status(v, i0, &st), RT_EOK);
+    uassert_int_equal(st.flags, ORB_VOTER_TS_ERROR);
+    uassert_int_equal(st.errors, 2);
+    uassert_int_equal(orb_voter_failovers(v), 3);
+
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* 三个实例中偏离中位数的一个被剔除 */
+static void test_voter_outlier(void)
+{
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 3);
+    uassert_not_null(v);
+    uassert_int_equal(orb_voter_set_outlier(v, "nope", 1.0f), -RT_ENOENT);
+    uassert_int_equal(orb_voter_set_outlier(v, "val", 1.0f), RT_EOK);
+
+    int i0 = -1, i1 = -1, i2 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    orb_advert_t a2 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i2);
+    uassert_true(a0 && a1 && a2);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+
+    publish(a0, 1, 10.0f, 0);
+    publish(a1, 1, 10.2f, 0);
+    publish(a2, 1, 9.9f, 0);
+    uassert_int_equal(orb_voter_selected(v), i0);
+
+    publish(a0, 2, 25.0f, 1);
+    uassert_int_equal(orb_voter_selected(v), i1);
+
+    orb_voter_status_t st;
+    uassert_int_equal(orb_voter_status(v, i0, &st), RT_EOK);
+    uassert_int_equal(st.flags, ORB_VOTER_OUTLIER);
+    uassert_int_equal(orb_voter_status(v, i2, &st), RT_EOK);
+    uassert_int_equal(st.flags, 0);
+
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+    orb_unadvertise(a2);
+}
+
+/* 选中实例超时：下一条来自备份的消息即完成切换并转发 */
+static void test_voter_timeout(void)
+{
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 0);
+    uassert_not_null(v);
+    uassert_int_equal(orb_voter_set_timeout(v, 50 * 1000), RT_EOK);
+    orb_subscr_t out = orb_subscribe(&voter_out_meta);
+
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    uassert_true(a0 && a1 && out);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+
+    struct voter_msg_s m;
+    publish(a0, 1, 0.0f, 1);
+    publish(a1, 1, 0.0f, 2);
+    uassert_int_equal(orb_voter_selected(v), i0);
+    uassert_int_equal(orb_copy(&voter_out_meta, out, &m), sizeof(m));
+    uassert_int_equal(m.seq, 1);
+
+    rt_thread_mdelay(80);
+    publish(a1, 2, 0.0f, 3);
+    uassert_int_equal(orb_voter_selected(v), i1);
+    uassert_int_equal(orb_copy(&voter_out_meta, out, &m), sizeof(m));
+    uassert_int_equal(m.seq, 3);
+
+    orb_unsubscribe(out);
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* 只挂接已存在的实例：创建与补挂都不为未出现的实例建节点 */
+static void test_voter_lazy_attach(void)
+{
+    int i0 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    uassert_true(a0 && i0 == 0);
+
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 0);
+    uassert_not_null(v);
+    uassert_null(orb_node_find(&voter_in_meta, 1));
+    uassert_null(orb_node_find(&voter_in_meta, ORB_MULTI_MAX_INSTANCES - 1));
+
+    /* 创建时已存在的实例无需补挂 */
+    publish(a0, 1, 0.0f, 1);
+    uassert_int_equal(orb_voter_selected(v), i0);
+
+    /* 后公告的实例在 orb_voter_update 后参与表决 */
+    int i1 = -1;
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    uassert_true(a1 && i1 == 1);
+    (void)orb_set_priority(a1, ORB_PRIO_HIGH);
+    publish(a1, 1, 0.0f, 2);
+    uassert_int_equal(orb_voter_selected(v), i0);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+    publish(a1, 2, 0.0f, 3);
+    uassert_int_equal(orb_voter_selected(v), i1);
+    uassert_null(orb_node_find(&voter_in_meta, 2));
+
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+/* 默认超时下选中实例停止发布：备份的下一条消息完成切换；都停止后无可用实例 */
+static void test_voter_failover(void)
+{
+    orb_voter_t *v = orb_voter_create(&voter_in_meta, &voter_out_meta, 2);
+    uassert_not_null(v);
+    orb_subscr_t out = orb_subscribe(&voter_out_meta);
+
+    int i0 = -1, i1 = -1;
+    orb_advert_t a0 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i0);
+    orb_advert_t a1 = orb_advertise_multi(&voter_in_meta, RT_NULL, &i1);
+    uassert_true(a0 && a1 && out);
+    uassert_int_equal(orb_voter_update(v), RT_EOK);
+    (void)orb_set_priority(a0, ORB_PRIO_HIGH);
+
+    struct voter_msg_s m;
+    publish(a0, 1, 0.0f, 1);
+    publish(a1, 1, 0.0f, 2);
+    uassert_int_equal(orb_voter_selected(v), i0);
+    uassert_int_equal(orb_update(out, &m), sizeof(m));
+    uassert_int_equal(m.seq, 1);
+
+    /* 主实例停止发布，备份持续发布 */
+    for (int k = 0; k < 3; k++)
+    {
+        rt_thread_mdelay(UORB_VOTER_TIMEOUT_US / 2000);
+        publish(a1, 2 + k, 0.0f, 3 + k);
+    }
+    uassert_int_equal(orb_voter_selected(v), i1);
+    uassert_int_equal(orb_voter_failovers(v), 1);
+    uassert_int_equal(orb_update(out, &m), sizeof(m));
+    uassert_true(m.seq >= 4);
+
+    orb_voter_status_t st;
+    uassert_int_equal(orb_voter_status(v, i0, &st), RT_EOK);
+    uassert_int_equal(st.flags, ORB_VOTER_STALE);
+
+    /* 全部停止：无发布时由 orb_voter_selected 按时间判定 */
+    rt_thread_mdelay(UORB_VOTER_TIMEOUT_US / 1000 + 20);
+    uassert_int_equal(orb_voter_selected(v), -RT_ENOENT);
+
+    orb_unsubscribe(out);
+    orb_voter_delete(v);
+    orb_unadvertise(a0);
+    orb_unadvertise(a1);
+}
+
+static void testcase(void)
+{
+    UTEST_UNIT_RUN(test_voter_priority);
+    UTEST_UNIT_RUN(test_voter_stuck);
+    UTEST_UNIT_RUN(test_voter_outlier);
+    UTEST_UNIT_RUN(test_voter_timeout);
+    UTEST_UNIT_RUN(test_voter_lazy_attach);
+    UTEST_UNIT_RUN(test_voter_failover);
+}
+
+UTEST_TC_EXPORT(testcase, "uorb.voter", tc_init, tc_cleanup, 20);
@@ -17,6 +17,24 @@ BASIC_TYPES = {
     'float': 'float', 'double': 'double',
 }
 
+# (size, alignment) of each C type, for the layout check in ORB_DECLARE_TRAITS
+C_LAYOUT = {
+    'int8_t': (1, 1), 'uint8_t': (1, 1), 'char': (1, 1), 'bool': (1, 1),
+    'int16_t': (2, 2), 'uint16_t': (2, 2),
+    'int32_t': (4, 4), 'uint32_t': (4, 4), 'float': (4, 4),
+    'int64_t': (8, 8), 'uint64_t': (8, 8), 'double': (8, 8),
+}
+
+def struct_size(fields):
+    # natural alignment, as the C compiler lays out the generated struct
+    off = 0
+    max_align = 1
+    for (t, n, arr) in fields:
+        size, align = C_LAYOUT[t]
+        off = (off + align - 1) // align * align + size * (arr or 1)
+        max_align = max(max_align, align)
+    return (off + max_align - 1) // max_align * max_align
+
 def parse_meta(line):
     s = line.strip()
     if not s.startswith('%'):
@@ -95,6 +113,11 @@ def gen_header(topic, fields, meta):
     lines.append('}')
     lines.append('#endif')
     lines.append('')
+    # C++ 编译期主题特性：uORB::topic_traits<struct xxx_s>
+    q_traits = q if q is not None else 1
+    m_traits = m if m is not None else 'ORB_MULTI_MAX_INSTANCES'
+    lines.append(f'ORB_DECLARE_TRAITS({topic}, {q_traits}, {m_traits}, {struct_size(fields)})')
+    lines.append('')
     lines.append(f'#endif /* {guard} */')
     return '\n'.join(lines) + '\n'
 
@@ -144,6 +167,10 @@ def validate_fields(topic, fields):
     if 'timestamp' not in info:
         print(f"[uorb-msggen] ERROR: '{topic}.msg' missing required field 'timestamp'", file=sys.stderr)
         return False
+    for (ctype, name, arr) in fields:
+        if ctype not in C_LAYOUT:
+            print(f"[uorb-msggen] ERROR: '{topic}.msg' field '{name}' has unknown type '{ctype}'", file=sys.stderr)
+            return False
     ctype, arr = info['timestamp']
     if ctype != 'uint64_t' or arr is not None:
         print(f"[uorb-msggen] ERROR: '{topic}.msg' field 'timestamp' must be uint64 (uint64_t) and scalar", file=sys.stderr)
@@ -164,6 +191,9 @@ def main():
             for idx, line in enumerate(f.readlines(), start=1):
                 m = parse_meta(line)
                 if m:
+                    if m[0] == 'instances' and not (1 <= m[1] <= 32):
+                        print(f"[uorb-msggen] ERROR: {p.name}:{idx}: %instances must be in 1..32", file=sys.stderr)
+                        return 1
                     meta[m[0]] = m[1]
                     continue
                 try:
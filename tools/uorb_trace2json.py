@@ -0,0 +1,113 @@
+#!/usr/bin/env python3
+"""Convert the output of "uorb trace dump" to Chrome trace / Perfetto JSON.
+
+usage: uorb_trace2json.py <console.log> [out.json]
+
+The input may be a raw console capture: lines that are not part of the dump
+are ignored. Open the result in chrome://tracing or https://ui.perfetto.dev.
+
+- publish: slice from PUB to NOTIFY (callbacks and wake-ups included)
+- wait:    slice from WAIT to WAKE, with a flow arrow from the publish that
+           produced the generation the waiter woke on
+- copy:    instant event
+"""
+import json
+import sys
+
+
+def parse(lines):
+    us_per_gcount = 1000000  # 1 count = 1 ns until the header says otherwise
+    nodes = {}
+    records = []
+    for line in lines:
+        parts = line.strip().split()
+        if not parts:
+            continue
+        if parts[0] == '#' and len(parts) >= 2 and parts[1] == 'uorb-trace':
+            for kv in parts[2:]:
+                if kv.startswith('us_per_gcount='):
+                    us_per_gcount = int(kv.split('=', 1)[1], 16)
+        elif parts[0] == 'N' and len(parts) == 4:
+            nodes[int(parts[1])] = '%s[%s]' % (parts[2], parts[3])
+        elif parts[0] == 'T' and len(parts) == 8:
+            records.append({
+                'cpu': int(parts[1]),
+                'ts': int(parts[2], 16),
+                'ev': parts[3],
+                'node': int(parts[4]),
+                'thread': int(parts[5], 16),
+                'gen': int(parts[6]),
+                'isr': int(parts[7]) & 1,
+            })
+    records.sort(key=lambda r: r['ts'])
+    return us_per_gcount, nodes, records
+
+
+def convert(us_per_gcount, nodes, records):
+    events = []
+    if not records:
+        return events
+    base = records[0]['ts']
+
+    def us(ts):
+        return (ts - base) * us_per_gcount / 1e9
+
+    def tid(r):
+        return 'isr%d' % r['cpu'] if r['isr'] else '%08x' % r['thread']
+
+    tids = {}
+    for r in records:
+        t = tid(r)
+        if t not in tids:
+            tids[t] = len(tids) + 1
+            name = 'ISR cpu%d' % r['cpu'] if r['isr'] else 'thread %s' % t
+            events.append({'ph': 'M', 'name': 'thread_name', 'pid': 1, 'tid': tids[t], 'args': {'name': name}})
+
+    open_pub = {}   # (tid, node) -> PUB record
+    open_wait = {}  # (tid, node) -> WAIT record
+    notified = {}   # (node, gen) -> flow id
+    for r in records:
+        t = tids[tid(r)]
+        topic = nodes.get(r['node'], 'node%d' % r['node'])
+        key = (t, r['node'])
+        common = {'pid': 1, 'tid': t, 'args': {'gen': r['gen'], 'cpu': r['cpu']}}
+        if r['ev'] == 'PUB':
+            open_pub[key] = r
+        elif r['ev'] == 'NOTIFY':
+            start = open_pub.pop(key, r)
+            events.append(dict(common, ph='X', name='pub ' + topic, ts=us(start['ts']),
+                               dur=us(r['ts']) - us(start['ts'])))
+            flow = len(notified) + 1
+            notified[(r['node'], r['gen'])] = flow
+            events.append(dict(common, ph='s', name='wake', cat='uorb', id=flow, ts=us(r['ts'])))
+        elif r['ev'] == 'COPY':
+            events.append(dict(common, ph='i', s='t', name='copy ' + topic, ts=us(r['ts'])))
+        elif r['ev'] == 'WAIT':
+            open_wait[key] = r
+        elif r['ev'] == 'WAKE':
+            start = open_wait.pop(key, r)
+            events.append(dict(common, ph='X', name='wait ' + topic, ts=us(start['ts']),
+                               dur=us(r['ts']) - us(start['ts'])))
+            flow = notified.get((r['node'], r['gen']))
+            if flow:
+                events.append(dict(common, ph='f', bp='e', name='wake', cat='uorb', id=flow, ts=us(r['ts'])))
+    return events
+
+
+def main():
+    if len(sys.argv) < 2:
+        print(__doc__.strip().splitlines()[2])
+        return 1
+    with open(sys.argv[1], 'r', errors='replace') as f:
+        events = convert(*parse(f))
+    out = json.dumps({'traceEvents': events, 'displayTimeUnit': 'ns'}, indent=1)
+    if len(sys.argv) >= 3:
+        with open(sys.argv[2], 'w') as f:
+            f.write(out)
+    else:
+        print(out)
+    return 0
+
+
+if __name__ == '__main__':
+    sys.exit(main())